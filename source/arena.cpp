@@ -0,0 +1,97 @@
+/*
+TSPLINE -- A T-spline object oriented package in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 3.0 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building, 
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+   - Created.
+-------------------------------------------------------------------------------
+*/
+
+#include <arena.h>
+
+#ifdef use_namespace
+namespace TSPLINE {
+	using namespace NEWMAT;
+#endif
+
+TArena::TArena( size_t block_size ) :
+	_last_pool(0), _last_type(0), _block_size(block_size), _allocated(0), _blocks(0)
+{
+
+}
+
+TArena::~TArena()
+{
+	std::map<std::type_index, Pool>::iterator iter;
+	for (iter=_pools.begin();iter!=_pools.end();iter++)
+	{
+		std::vector<char *> &blocks = iter->second.blocks;
+		for (int i=0;i<(int)blocks.size();i++)
+		{
+			::operator delete(blocks[i]);
+		}
+	}
+}
+
+void * TArena::allocate( size_t size, size_t alignment, const std::type_info &type )
+{
+	if (!_last_type || *_last_type != type)
+	{
+		_last_pool = &_pools[std::type_index(type)];
+		_last_type = &type;
+	}
+	Pool &pool = *_last_pool;
+
+	size_t padding = pool.current ? (alignment - reinterpret_cast<size_t>(pool.current) % alignment) % alignment : 0;
+	if (!pool.current || pool.current + padding + size > pool.end)
+	{
+		reserve(pool, size + alignment);
+		padding = (alignment - reinterpret_cast<size_t>(pool.current) % alignment) % alignment;
+	}
+
+	void *memory = pool.current + padding;
+	pool.current += padding + size;
+	_allocated += size;
+	return memory;
+}
+
+void TArena::reserve( Pool &pool, size_t size )
+{
+	size_t block_size = size > _block_size ? size : _block_size;
+	char *block = static_cast<char *>(::operator new(block_size));
+	pool.blocks.push_back(block);
+	pool.current = block;
+	pool.end = block + block_size;
+	_blocks++;
+}
+
+#ifdef use_namespace
+}
+#endif
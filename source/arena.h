@@ -0,0 +1,155 @@
+/*
+T-SPLINE -- A T-spline object oriented library in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 2.1 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building, 
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+- Created.
+-------------------------------------------------------------------------------
+*/
+
+/**  @file  [arena]  
+  *  @brief  Arena allocation of T-objects.
+  *  @author  <agent>  
+  *  @date  <2026.10.19>  
+  *  @version  <v1.0>  
+  *  @note  
+  *  This file contains a monotonic arena with one pool per type, and an allocator 
+  *  to create shared T-objects inside the arena.
+*/
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <utils.h>
+#include <typeinfo>
+#include <typeindex>
+
+#ifdef use_namespace
+namespace TSPLINE {
+	using namespace NEWMAT;
+#endif
+
+DECLARE_SMARTPTR(TArena);
+
+/**  
+  *  @class  <TArena> 
+  *  @brief  A monotonic arena with per-type pools.
+  *  @note  
+  *  Memory is handed out from large blocks, one chain of blocks per type, so objects of the same type 
+  *  are adjacent in memory. Nothing is returned to the system until the arena itself is destroyed, 
+  *  which releases all the blocks at once. The arena is not thread-safe.
+*/
+class TArena
+{
+public:
+	TArena(size_t block_size = 65536);
+	~TArena();
+public:
+	/** Allocate memory of the size and alignment from the pool of the type. */
+	void *allocate(size_t size, size_t alignment, const std::type_info &type);
+	/** Return the number of bytes handed out. */
+	size_t allocated() const {return _allocated;}
+	/** Return the number of blocks reserved. */
+	size_t blocks() const {return _blocks;}
+protected:
+	struct Pool
+	{
+		Pool() : current(0), end(0) {}
+		std::vector<char *> blocks;
+		char *current;
+		char *end;
+	};
+	void reserve(Pool &pool, size_t size);
+private:
+	std::map<std::type_index, Pool> _pools;
+	Pool *_last_pool;
+	const std::type_info *_last_type;
+	size_t _block_size;
+	size_t _allocated;
+	size_t _blocks;
+};
+
+/**  
+  *  @class  <TArenaAllocator> 
+  *  @brief  A standard allocator over a TArena.
+  *  @note  
+  *  The allocator keeps the arena alive, so an arena lives as long as the last object created in it. 
+  *  Deallocation is a no-op.
+*/
+template<class T>
+class TArenaAllocator
+{
+public:
+	typedef T value_type;
+
+	TArenaAllocator(const TArenaPtr &arena) : _arena(arena) {}
+	template<class U>
+	TArenaAllocator(const TArenaAllocator<U> &other) : _arena(other.arena()) {}
+
+	/** Allocate n objects from the arena. */
+	T *allocate(std::size_t n)
+	{
+		return static_cast<T *>(_arena->allocate(n * sizeof(T), alignof(T), typeid(T)));
+	}
+	/** Memory is released with the arena. */
+	void deallocate(T *, std::size_t) {}
+
+	/** Return the arena. */
+	const TArenaPtr &arena() const {return _arena;}
+
+	template<class U>
+	bool operator==(const TArenaAllocator<U> &other) const {return _arena == other.arena();}
+	template<class U>
+	bool operator!=(const TArenaAllocator<U> &other) const {return _arena != other.arena();}
+private:
+	TArenaPtr _arena;
+};
+
+/** Make a smart pointer in the arena, or on the heap if no arena is given (0 parameter). */
+template<typename T>
+std::shared_ptr<T> makeArenaPtr(const TArenaPtr &arena)
+{
+	if (!arena) return makePtr<T>();
+	return std::allocate_shared<T>(TArenaAllocator<T>(arena));
+}
+
+/** Make a smart pointer in the arena, or on the heap if no arena is given (1 parameter). */
+template<typename T, typename P1>
+std::shared_ptr<T> makeArenaPtr(const TArenaPtr &arena, P1 par)
+{
+	if (!arena) return makePtr<T>(par);
+	return std::allocate_shared<T>(TArenaAllocator<T>(arena), par);
+}
+
+#ifdef use_namespace
+}
+#endif
+
+#endif
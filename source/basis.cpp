@@ -92,6 +92,101 @@ void ParameterSquare::extendParameter( const Parameter &parameter )
 	if (parameter.t() < tMin()) tMin(parameter.t());
 }
 
+BoundingBox::BoundingBox()
+{
+	clear();
+}
+
+BoundingBox::BoundingBox( const Point3D &minimum, const Point3D &maximum ) :
+	_minimum(minimum), _maximum(maximum)
+{
+
+}
+
+Real BoundingBox::minimum( int axis ) const
+{
+	return axis == 0 ? _minimum.x() : (axis == 1 ? _minimum.y() : _minimum.z());
+}
+
+Real BoundingBox::maximum( int axis ) const
+{
+	return axis == 0 ? _maximum.x() : (axis == 1 ? _maximum.y() : _maximum.z());
+}
+
+Real BoundingBox::halfArea() const
+{
+	if (isEmpty()) return 0.0;
+	Point3D d = _maximum - _minimum;
+	return d.x()*d.y() + d.y()*d.z() + d.z()*d.x();
+}
+
+int BoundingBox::longestAxis() const
+{
+	Point3D d = _maximum - _minimum;
+	if (d.x() >= d.y() && d.x() >= d.z()) return 0;
+	return d.y() >= d.z() ? 1 : 2;
+}
+
+void BoundingBox::clear()
+{
+	Real huge = std::numeric_limits<Real>::max();
+	_minimum = Point3D(huge, huge, huge);
+	_maximum = Point3D(-huge, -huge, -huge);
+}
+
+void BoundingBox::extend( const Point3D &point )
+{
+	_minimum = Point3D(min(_minimum.x(), point.x()), min(_minimum.y(), point.y()), min(_minimum.z(), point.z()));
+	_maximum = Point3D(max(_maximum.x(), point.x()), max(_maximum.y(), point.y()), max(_maximum.z(), point.z()));
+}
+
+void BoundingBox::extend( const BoundingBox &box )
+{
+	if (box.isEmpty()) return;
+	extend(box.minimum());
+	extend(box.maximum());
+}
+
+void BoundingBox::enlarge( Real margin )
+{
+	if (isEmpty()) return;
+	_minimum -= Point3D(margin, margin, margin);
+	_maximum += Point3D(margin, margin, margin);
+}
+
+Real BoundingBox::squaredDistance( const Point3D &point ) const
+{
+	Real d2 = 0.0;
+	for (int axis=0;axis<3;axis++)
+	{
+		Real c = axis == 0 ? point.x() : (axis == 1 ? point.y() : point.z());
+		Real d = max(minimum(axis) - c, max(0.0, c - maximum(axis)));
+		d2 += d*d;
+	}
+	return d2;
+}
+
+bool BoundingBox::overlaps( const BoundingBox &box ) const
+{
+	for (int axis=0;axis<3;axis++)
+	{
+		if (box.minimum(axis) > maximum(axis) || box.maximum(axis) < minimum(axis)) return false;
+	}
+	return true;
+}
+
+bool BoundingBox::clipRay( const Point3D &origin, const Point3D &inverse, Real &t_near, Real &t_far ) const
+{
+	// The slab test, an infinite reciprocal of a zero direction keeps the slab either empty or unbounded.
+	Real t0 = (_minimum.x() - origin.x()) * inverse.x(), t1 = (_maximum.x() - origin.x()) * inverse.x();
+	t_near = max(t_near, min(t0, t1)); t_far = min(t_far, max(t0, t1));
+	t0 = (_minimum.y() - origin.y()) * inverse.y(); t1 = (_maximum.y() - origin.y()) * inverse.y();
+	t_near = max(t_near, min(t0, t1)); t_far = min(t_far, max(t0, t1));
+	t0 = (_minimum.z() - origin.z()) * inverse.z(); t1 = (_maximum.z() - origin.z()) * inverse.z();
+	t_near = max(t_near, min(t0, t1)); t_far = min(t_far, max(t0, t1));
+	return t_near <= t_far;
+}
+
 
 #ifdef use_namespace
 }
@@ -61,6 +61,7 @@ DECLARE_ASSISTANCES(Point3D, P3d);
 DECLARE_ASSISTANCES(Vector3D, N3d);
 DECLARE_ASSISTANCES(Frame3D, F3d);
 DECLARE_ASSISTANCES(ParameterSquare, ParaSqu);
+DECLARE_ASSISTANCES(BoundingBox, BBox);
 
 /**  
   *  @class  <Parameter> 
@@ -306,6 +307,59 @@ private:
 	Parameter _southeast;
 };
 
+/**  
+  *  @class  <BoundingBox> 
+  *  @brief  An axis aligned box in the 3D space.   
+  *  @note  
+  *  A BoundingBox is represented using the minimum and maximum corners, it is empty until a point is put into it.
+*/ 
+class BoundingBox
+{
+public:
+	BoundingBox();
+	BoundingBox(const Point3D &minimum, const Point3D &maximum);
+	~BoundingBox() {}
+public:
+	/** Check if nothing has been put into the box */
+	bool isEmpty() const {return _minimum.x() > _maximum.x();}
+	/** Get the minimum corner */
+	const Point3D &minimum() const {return _minimum;}
+	/** Get the maximum corner */
+	const Point3D &maximum() const {return _maximum;}
+	/** Get the minimum and maximum limits along the axis (0 for x, 1 for y and 2 for z) */
+	Real minimum(int axis) const;
+	Real maximum(int axis) const;
+	/** Derive the center of the box */
+	Point3D center() const {return (_minimum + _maximum) * 0.5;}
+	/** Derive the half of the surface area, used to compare the boxes */
+	Real halfArea() const;
+	/** Return the axis along which the box is the longest */
+	int longestAxis() const;
+public:
+	/** Clear the box to empty */
+	void clear();
+	/** Extend the box if the point is outside */
+	void extend(const Point3D &point);
+	/** Extend the box to contain another box */
+	void extend(const BoundingBox &box);
+	/** Enlarge the box by a margin on every side */
+	void enlarge(Real margin);
+	/** Derive the squared distance from the point to the box, 0 if the point is inside */
+	Real squaredDistance(const Point3D &point) const;
+	/** Check if the box overlaps another box */
+	bool overlaps(const BoundingBox &box) const;
+	/**
+	  * Clip the ray origin + t * direction by the box, inverse holds the reciprocals of the direction.
+	  * Return false if the ray misses the box within [t_near, t_far], otherwise narrow [t_near, t_far] to the box.
+	*/
+	bool clipRay(const Point3D &origin, const Point3D &inverse, Real &t_near, Real &t_far) const;
+private:
+	/** Corner of the minimum coordinates */
+	Point3D _minimum;
+	/** Corner of the maximum coordinates */
+	Point3D _maximum;
+};
+
 /** Safely divide a Real by a Real */
 inline Real safeDivide( Real nominator, Real denominator )
 {
@@ -0,0 +1,287 @@
+/*
+TSPLINE -- A T-spline object oriented package in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 3.0 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building,
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+   - Created.
+-------------------------------------------------------------------------------
+*/
+
+#include <bezier.h>
+#include <extractor.h>
+#include <algorithm>
+
+#ifdef use_namespace
+namespace TSPLINE {
+	using namespace NEWMAT;
+#endif
+
+/** The largest order (degree + 1) of the blending functions, the same as BlendingBasis::create. */
+static const int MAX_ORDER = 6;
+
+/** A blending function of a T-face. */
+struct BlendingFunction
+{
+	int index;
+	TPointPtr point;
+	std::vector<Real> u_knots, v_knots;
+	Real coefficients[4];	/** x, y and z multiplied by the weight, and the weight. */
+};
+
+/** Append the knots strictly inside (lower, upper) and both ends, sorted and with the knots closer than the tolerance merged. */
+static void splitRange(std::vector<Real> &knots, Real lower, Real upper, std::vector<Real> &cuts)
+{
+	std::sort(knots.begin(), knots.end());
+	cuts.clear();
+	cuts.push_back(lower);
+	for (int i=0;i<(int)knots.size();i++)
+	{
+		if (knots[i] > lower && knots[i] < upper && !isEqual(knots[i], cuts.back()) && !isEqual(knots[i], upper))
+			cuts.push_back(knots[i]);
+	}
+	cuts.push_back(upper);
+}
+
+TBezierExtractor::TBezierExtractor( const TSplinePtr &spline ) :
+	_degree_s(spline->getSDegree()),
+	_degree_t(spline->getTDegree())
+{
+	TPointsetPtr pointset = spline->getTPointset();
+	if (pointset)
+	{
+		for (TObjVIterator iter = pointset->iteratorBegin(); iter != pointset->iteratorEnd(); iter++)
+		{
+			TPointPtr point = castPtr<TPoint>(*iter);
+			if (!point) continue;
+			_indices[point] = (int)_points.size();
+			_points.push_back(point);
+		}
+	}
+	TExtractor::extractBlendedTFacesFromTImage(spline->getTImage(), _faces);
+}
+
+TBezierExtractor::~TBezierExtractor()
+{
+
+}
+
+int TBezierExtractor::findIndex( const TPointPtr &point ) const
+{
+	std::map<TPointPtr, int>::const_iterator found = _indices.find(point);
+	return found == _indices.end() ? -1 : found->second;
+}
+
+int TBezierExtractor::extract( std::vector<TBezierPatch> &patches, bool operators /*= false*/ ) const
+{
+	int n = (int)_faces.size();
+	std::vector<std::vector<TBezierPatch> > results(n);
+#ifdef USE_OMP
+#pragma omp parallel for schedule(dynamic, 4)
+#endif
+	for (int i=0;i<n;i++)
+	{
+		extractFace(_faces[i], results[i], operators);
+	}
+
+	patches.clear();
+	for (int i=0;i<n;i++)
+	{
+		patches.insert(patches.end(), results[i].begin(), results[i].end());
+	}
+	return (int)patches.size();
+}
+
+int TBezierExtractor::extractFace( const TFacePtr &face, std::vector<TBezierPatch> &patches, bool operators /*= false*/ ) const
+{
+	patches.clear();
+	int nu = _degree_s + 1, nv = _degree_t + 1;
+	if (!face || nu > MAX_ORDER || nv > MAX_ORDER) return 0;
+
+	// The same blending functions as TDerivator::prepareEquationByTFace.
+	std::vector<BlendingFunction> functions;
+	std::vector<Real> s_knots, t_knots;
+	for (TNodVIterator iter = face->blendingNodeIteratorBegin(); iter != face->blendingNodeIteratorEnd(); iter++)
+	{
+		BlendingFunction function;
+		TNodeV4Ptr node_v4 = castPtr<TNodeV4>(*iter);
+		if (!TExtractor::extractUVKnotsFromTNodeV4(node_v4, function.u_knots, function.v_knots, _degree_s, _degree_t)) return 0;
+		Point3D point; Real weight;
+		TExtractor::extractRationalPointFromTNodeV4(node_v4, point, weight);
+		function.point = node_v4->getTPoint();
+		function.index = findIndex(function.point);
+		function.coefficients[0] = point.x() * weight;
+		function.coefficients[1] = point.y() * weight;
+		function.coefficients[2] = point.z() * weight;
+		function.coefficients[3] = weight;
+		functions.push_back(function);
+		s_knots.insert(s_knots.end(), function.u_knots.begin(), function.u_knots.end());
+		t_knots.insert(t_knots.end(), function.v_knots.begin(), function.v_knots.end());
+	}
+
+	Parameter northwest = face->northWest(), southeast = face->southEast();
+	std::vector<Real> s_cuts, t_cuts;
+	splitRange(s_knots, min(northwest.s(), southeast.s()), max(northwest.s(), southeast.s()), s_cuts);
+	splitRange(t_knots, min(northwest.t(), southeast.t()), max(northwest.t(), southeast.t()), t_cuts);
+
+	for (int a=0;a+1<(int)s_cuts.size();a++)
+	{
+		for (int b=0;b+1<(int)t_cuts.size();b++)
+		{
+			TBezierPatch patch;
+			patch.face = face;
+			patch.degree_s = _degree_s; patch.degree_t = _degree_t;
+			patch.s_min = s_cuts[a]; patch.s_max = s_cuts[a+1];
+			patch.t_min = t_cuts[b]; patch.t_max = t_cuts[b+1];
+			std::vector<Real> homogeneous(4*nu*nv, 0.0);
+			for (int k=0;k<(int)functions.size();k++)
+			{
+				const BlendingFunction &function = functions[k];
+				Real bu[MAX_ORDER], bv[MAX_ORDER];
+				computeBernsteinCoefficients(function.u_knots, patch.s_min, patch.s_max, bu);
+				computeBernsteinCoefficients(function.v_knots, patch.t_min, patch.t_max, bv);
+				if (std::count(bu, bu+nu, 0.0) == nu || std::count(bv, bv+nv, 0.0) == nv) continue;
+				if (operators)
+				{
+					patch.indices.push_back(function.index);
+					patch.tpoints.push_back(function.point);
+				}
+				for (int i=0;i<nu;i++)
+				{
+					for (int j=0;j<nv;j++)
+					{
+						Real coefficient = bu[i] * bv[j];
+						for (int c=0;c<4;c++) homogeneous[4*(i*nv+j)+c] += coefficient * function.coefficients[c];
+						if (operators) patch.operators.push_back(coefficient);
+					}
+				}
+			}
+			patch.points.resize(nu*nv);
+			patch.weights.resize(nu*nv);
+			for (int i=0;i<nu*nv;i++)
+			{
+				const Real *h = &homogeneous[4*i];
+				patch.points[i] = safeDivide(Point3D(h[0], h[1], h[2]), h[3]);
+				patch.weights[i] = h[3];
+			}
+			patches.push_back(patch);
+		}
+	}
+	return (int)patches.size();
+}
+
+Point3D TBezierExtractor::computePoint( const TBezierPatch &patch, Real s, Real t )
+{
+	int nu = patch.degree_s + 1, nv = patch.degree_t + 1;
+	Real x = (s - patch.s_min) / (patch.s_max - patch.s_min), y = (t - patch.t_min) / (patch.t_max - patch.t_min);
+	// Bernstein polynomials by the triangle of de Casteljau.
+	Real bu[MAX_ORDER] = {1.0}, bv[MAX_ORDER] = {1.0};
+	for (int p=1;p<nu;p++)
+	{
+		for (int i=p;i>0;i--) bu[i] = (1.0-x)*bu[i] + x*bu[i-1];
+		bu[0] *= 1.0-x;
+	}
+	for (int p=1;p<nv;p++)
+	{
+		for (int j=p;j>0;j--) bv[j] = (1.0-y)*bv[j] + y*bv[j-1];
+		bv[0] *= 1.0-y;
+	}
+
+	Point3D numerator(0.0, 0.0, 0.0);
+	Real denominator = 0.0;
+	for (int i=0;i<nu;i++)
+	{
+		for (int j=0;j<nv;j++)
+		{
+			Real w = bu[i] * bv[j] * patch.weights[i*nv+j];
+			numerator += patch.points[i*nv+j] * w;
+			denominator += w;
+		}
+	}
+	return safeDivide(numerator, denominator);
+}
+
+void TBezierExtractor::computeBernsteinCoefficients( const std::vector<Real> &knots, Real a, Real b, Real *coefficients )
+{
+	int degree = (int)knots.size() - 2, order = degree + 1;
+	std::fill(coefficients, coefficients+order, 0.0);
+	Real middle = 0.5 * (a + b), h = b - a;
+	int span = -1;
+	for (int i=0;i<order;i++)
+	{
+		if (knots[i] <= middle && middle < knots[i+1]) span = i;
+	}
+	if (span < 0 || order > MAX_ORDER) return;
+
+	// Cox-de Boor recursion on the coefficients of the piece in u - a, as in BSplineBasis::setKnots.
+	Real local[MAX_ORDER+1];
+	for (int i=0;i<=order;i++) local[i] = knots[i] - a;
+	Real basis[MAX_ORDER][MAX_ORDER];
+	for (int i=0;i<order;i++)
+	{
+		std::fill(basis[i], basis[i]+order, 0.0);
+	}
+	basis[span][0] = 1.0;
+	for (int p=1;p<=degree;p++)
+	{
+		for (int i=0;i+p<=degree;i++)
+		{
+			Real next[MAX_ORDER];
+			std::fill(next, next+order, 0.0);
+			Real left = local[i+p]-local[i], right = local[i+p+1]-local[i+1];
+			for (int c=0;c<=p;c++)
+			{
+				Real shifted = c > 0 ? basis[i][c-1] : 0.0;
+				if (!isZero(left)) next[c] += (shifted - local[i]*basis[i][c]) / left;
+				shifted = c > 0 ? basis[i+1][c-1] : 0.0;
+				if (!isZero(right)) next[c] += (local[i+p+1]*basis[i+1][c] - shifted) / right;
+			}
+			std::copy(next, next+order, basis[i]);
+		}
+	}
+
+	// The monomial x^k of x = (u - a) / h has the Bernstein coefficients C(j, k) / C(degree, k) for j >= k.
+	Real binomial[MAX_ORDER][MAX_ORDER];
+	for (int j=0;j<order;j++)
+	{
+		binomial[j][0] = binomial[j][j] = 1.0;
+		for (int k=1;k<j;k++) binomial[j][k] = binomial[j-1][k-1] + binomial[j-1][k];
+	}
+	Real scale = 1.0;
+	for (int k=0;k<order;k++)
+	{
+		Real monomial = basis[0][k] * scale;
+		for (int j=k;j<order;j++) coefficients[j] += monomial * binomial[j][k] / binomial[degree][k];
+		scale *= h;
+	}
+}
+
+#ifdef use_namespace
+}
+#endif
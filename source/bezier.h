@@ -0,0 +1,123 @@
+/*
+T-SPLINE -- A T-spline object oriented library in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 2.1 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building,
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+- Created.
+-------------------------------------------------------------------------------
+*/
+
+/**  @file  [bezier]
+  *  @brief  Bezier extraction of a T-spline surface.
+  *  @author  <agent>
+  *  @date  <2026.10.19>
+  *  @version  <v1.0>
+  *  @note
+  *  This file contains the extractor which exports a T-spline surface as standard rational Bezier patches,
+  *  with the extraction operators used in isogeometric analysis.
+*/
+
+#ifndef BEZIER_H
+#define BEZIER_H
+
+#include <utils.h>
+#include <tspline.h>
+#include <splbase.h>
+
+#ifdef use_namespace
+namespace TSPLINE {
+	using namespace NEWMAT;
+#endif
+
+DECLARE_SMARTPTR(TBezierExtractor);
+
+/** A rational Bezier patch on a knot cell of a T-face. */
+struct TBezierPatch
+{
+	TBezierPatch() : degree_s(3), degree_t(3), s_min(0.0), s_max(0.0), t_min(0.0), t_max(0.0) {}
+	TFacePtr face;
+	int degree_s, degree_t;
+	Real s_min, s_max, t_min, t_max;	/** The knot cell in the domain of the T-face. */
+	std::vector<Point3D> points;		/** The (degree_s + 1) * (degree_t + 1) control points, the i-th along s and j-th along t at i * (degree_t + 1) + j. */
+	std::vector<Real> weights;			/** The weights of the control points. */
+	std::vector<int> indices;			/** The indices of the T-points blending on the cell, see TBezierExtractor::getPoint. */
+	TPntVector tpoints;					/** The T-points of the indices, also the ones of index -1 outside the T-pointset. */
+	std::vector<Real> operators;		/** The Bernstein coefficients of the blending function of each index, one row per index ordered as the points. */
+};
+
+/**
+  *  @class  <TBezierExtractor>
+  *  @brief  T-spline Bezier extractor
+  *  @note
+  *  The knots of the blending functions of a T-face which fall inside it split its domain into knot cells, on which every
+  *  blending function is a single polynomial. The polynomial of each blending function is converted to the Bernstein basis
+  *  of the cell, and the weighted T-points are summed with these coefficients into the homogeneous control points of a
+  *  rational Bezier patch, which equals the T-spline surface on the cell. The coefficients are the extraction operator of
+  *  the cell: row k maps the T-point of indices[k] to the control points, so that the Bernstein basis times the operator
+  *  gives the blending functions. The T-points are indexed in the order of the T-pointset. The T-faces are extracted
+  *  independently on all the threads.
+*/
+class TBezierExtractor
+{
+public:
+	TBezierExtractor(const TSplinePtr &spline);
+	~TBezierExtractor();
+public:
+	/** Return the number of indexed T-points. */
+	int sizePoints() const {return (int)_points.size();}
+	/** Get the indexed T-point. */
+	TPointPtr getPoint(int index) const {return _points[index];}
+	/** Find the index of the T-point, return -1 if it is not in the T-pointset. */
+	int findIndex(const TPointPtr &point) const;
+	/** Return the number of T-faces. */
+	int sizeFaces() const {return (int)_faces.size();}
+	/** Get the indexed T-face. */
+	TFacePtr getFace(int index) const {return _faces[index];}
+public:
+	/** Extract the patches of all the T-faces in their order, with the extraction operators if asked for, return the number of patches. */
+	int extract(std::vector<TBezierPatch> &patches, bool operators = false) const;
+	/** Extract the patches of the T-face, with the extraction operators if asked for, return the number of patches. */
+	int extractFace(const TFacePtr &face, std::vector<TBezierPatch> &patches, bool operators = false) const;
+	/** Compute the point of the patch at the parameter of the T-face. */
+	static Point3D computePoint(const TBezierPatch &patch, Real s, Real t);
+	/** Compute the Bernstein coefficients on [a, b] of the B-spline basis function of the knots, all 0 if [a, b] is out of its support. */
+	static void computeBernsteinCoefficients(const std::vector<Real> &knots, Real a, Real b, Real *coefficients);
+private:
+	int _degree_s, _degree_t;
+	std::vector<TPointPtr> _points;
+	std::map<TPointPtr, int> _indices;
+	TFacVector _faces;
+};
+
+#ifdef use_namespace
+}
+#endif
+
+#endif
@@ -0,0 +1,224 @@
+/*
+TSPLINE -- A T-spline object oriented package in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 3.0 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building,
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+   - Created.
+-------------------------------------------------------------------------------
+*/
+
+#include <bvh.h>
+#include <algorithm>
+
+#ifdef use_namespace
+namespace TSPLINE {
+	using namespace NEWMAT;
+#endif
+
+static bool sameBox(const BoundingBox &a, const BoundingBox &b)
+{
+	for (int axis=0;axis<3;axis++)
+	{
+		if (a.minimum(axis) != b.minimum(axis) || a.maximum(axis) != b.maximum(axis)) return false;
+	}
+	return true;
+}
+
+/** The bin of the box center along the axis, the same for binning and partitioning. */
+static int binOf(const BoundingBox &box, int axis, Real lower, Real extent, int bins)
+{
+	Real center = 0.5 * (box.minimum(axis) + box.maximum(axis));
+	return min((int)((center - lower) / extent * bins), bins-1);
+}
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy( int leaf_size /*= 4*/ ) :
+	_leaf_size(leaf_size < 1 ? 1 : leaf_size)
+{
+
+}
+
+BoundingVolumeHierarchy::~BoundingVolumeHierarchy()
+{
+
+}
+
+void BoundingVolumeHierarchy::build( const std::vector<BoundingBox> &boxes )
+{
+	_boxes = boxes;
+	_nodes.clear();
+	_indices.resize(_boxes.size());
+	_leaves.resize(_boxes.size());
+	for (int i=0;i<(int)_indices.size();i++) _indices[i] = i;
+	if (_boxes.empty()) return;
+
+	_nodes.reserve(2*_boxes.size());
+	_nodes.push_back(Node());
+	_nodes[0].parent = -1;
+	buildNode(0, 0, (int)_indices.size());
+}
+
+void BoundingVolumeHierarchy::refit( int index, const BoundingBox &box )
+{
+	_boxes[index] = box;
+	for (int node = _leaves[index]; node >= 0; node = _nodes[node].parent)
+	{
+		BoundingBox fitted = fitNode(_nodes[node]);
+		// The nodes above are unchanged once a node keeps its box.
+		if (sameBox(fitted, _nodes[node].box)) break;
+		_nodes[node].box = fitted;
+	}
+}
+
+void BoundingVolumeHierarchy::refit( const std::vector<int> &indices, const std::vector<BoundingBox> &boxes )
+{
+	std::vector<char> dirty(_nodes.size(), 0);
+	for (int i=0;i<(int)indices.size();i++)
+	{
+		_boxes[indices[i]] = boxes[i];
+		for (int node = _leaves[indices[i]]; node >= 0 && !dirty[node]; node = _nodes[node].parent)
+		{
+			dirty[node] = 1;
+		}
+	}
+	// The children are stored after their parent, so a backward sweep fits them first.
+	for (int node = (int)_nodes.size()-1; node >= 0; node--)
+	{
+		if (dirty[node]) _nodes[node].box = fitNode(_nodes[node]);
+	}
+}
+
+BoundingBox BoundingVolumeHierarchy::fitNode( const Node &node ) const
+{
+	BoundingBox box;
+	if (node.count > 0)
+	{
+		for (int i=node.first;i<node.first+node.count;i++) box.extend(_boxes[_indices[i]]);
+	}
+	else
+	{
+		box.extend(_nodes[node.first].box);
+		box.extend(_nodes[node.first+1].box);
+	}
+	return box;
+}
+
+void BoundingVolumeHierarchy::buildNode( int index, int first, int last )
+{
+	BoundingBox box, centers;
+	for (int i=first;i<last;i++)
+	{
+		box.extend(_boxes[_indices[i]]);
+		centers.extend(_boxes[_indices[i]].center());
+	}
+	_nodes[index].box = box;
+	if (last - first <= _leaf_size)
+	{
+		_nodes[index].first = first;
+		_nodes[index].count = last - first;
+		for (int i=first;i<last;i++) _leaves[_indices[i]] = index;
+		return;
+	}
+
+	int axis, bin, middle;
+	if (splitNode(centers, first, last, axis, bin))
+	{
+		Real lower = centers.minimum(axis), extent = centers.maximum(axis) - lower;
+		middle = (int)(std::partition(_indices.begin()+first, _indices.begin()+last, 
+			[&](int a) { return binOf(_boxes[a], axis, lower, extent, SAH_BINS) < bin; }) - _indices.begin());
+	}
+	else
+	{
+		// The centers coincide, any half will do.
+		middle = (first + last) / 2;
+	}
+
+	// The children are stored next to each other, the node refers to the first one.
+	int child = (int)_nodes.size();
+	_nodes[index].first = child;
+	_nodes[index].count = 0;
+	_nodes.push_back(Node());
+	_nodes.push_back(Node());
+	_nodes[child].parent = index;
+	_nodes[child+1].parent = index;
+	buildNode(child, first, middle);
+	buildNode(child+1, middle, last);
+}
+
+bool BoundingVolumeHierarchy::splitNode( const BoundingBox &centers, int first, int last, int &axis, int &bin ) const
+{
+	const int BINS = SAH_BINS;
+	Real best = std::numeric_limits<Real>::max();
+	for (int a=0;a<3;a++)
+	{
+		Real lower = centers.minimum(a), extent = centers.maximum(a) - lower;
+		if (extent <= 0.0) continue;
+		BoundingBox bins[BINS];
+		int counts[BINS] = {0};
+		for (int i=first;i<last;i++)
+		{
+			const BoundingBox &box = _boxes[_indices[i]];
+			int b = binOf(box, a, lower, extent, BINS);
+			bins[b].extend(box);
+			counts[b]++;
+		}
+		// Sweep from the right for the areas of the right sides, then from the left for the costs.
+		Real right_areas[BINS];
+		int right_counts[BINS];
+		BoundingBox right;
+		int count = 0;
+		for (int b=BINS-1;b>0;b--)
+		{
+			right.extend(bins[b]);
+			count += counts[b];
+			right_areas[b] = right.halfArea();
+			right_counts[b] = count;
+		}
+		BoundingBox left;
+		count = 0;
+		for (int b=1;b<BINS;b++)
+		{
+			left.extend(bins[b-1]);
+			count += counts[b-1];
+			if (count == 0 || right_counts[b] == 0) continue;
+			Real cost = count * left.halfArea() + right_counts[b] * right_areas[b];
+			if (cost < best)
+			{
+				best = cost;
+				axis = a;
+				bin = b;
+			}
+		}
+	}
+	return best < std::numeric_limits<Real>::max();
+}
+
+#ifdef use_namespace
+}
+#endif
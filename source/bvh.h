@@ -0,0 +1,293 @@
+/*
+T-SPLINE -- A T-spline object oriented library in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 2.1 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building,
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+- Created.
+-------------------------------------------------------------------------------
+*/
+
+/**  @file  [bvh]
+  *  @brief  Bounding volume hierarchy.
+  *  @author  <agent>
+  *  @date  <2026.10.19>
+  *  @version  <v1.0>
+  *  @note
+  *  This file contains a bounding volume hierarchy over indexed boxes, used to cull the T-faces
+  *  far away from a query.
+*/
+
+#ifndef BVH_H
+#define BVH_H
+
+#include <utils.h>
+#include <basis.h>
+
+#ifdef use_namespace
+namespace TSPLINE {
+	using namespace NEWMAT;
+#endif
+
+DECLARE_SMARTPTR(BoundingVolumeHierarchy);
+
+/**
+  *  @class  <NodeStack>
+  *  @brief  The stack of the nodes a traversal has still to visit.
+  *  @note
+  *  The first entries are kept in place, so that a traversal of a usual hierarchy does not allocate.
+*/
+template<class T>
+class NodeStack
+{
+public:
+	NodeStack() : _size(0) {}
+public:
+	bool empty() const {return _size == 0;}
+	void push(const T &item) { if (_size < LOCAL) _local[_size] = item; else _more.push_back(item); _size++; }
+	T pop() { _size--; if (_size < LOCAL) return _local[_size]; T item = _more.back(); _more.pop_back(); return item; }
+private:
+	enum { LOCAL = 64 };
+	T _local[LOCAL];
+	std::vector<T> _more;
+	int _size;
+};
+
+/**
+  *  @class  <BoundingVolumeHierarchy>
+  *  @brief  A binary tree of axis aligned boxes.
+  *  @note
+  *  The hierarchy is built over a list of boxes, each one bounding a primitive known by its index
+  *  (e.g. a T-face). Each node is split where the surface area heuristic (SAH) estimates the cheapest
+  *  traversal, found over a few bins of the box centers along each axis. The nodes are stored in one array,
+  *  the queries are const and may run on many threads at the same time. When the primitives move a little,
+  *  their boxes are refitted without changing the tree, which keeps it valid though less tight.
+*/
+class BoundingVolumeHierarchy
+{
+public:
+	BoundingVolumeHierarchy(int leaf_size = 4);
+	~BoundingVolumeHierarchy();
+public:
+	/** Build the hierarchy over the boxes, the primitive of boxes[i] has the index i. */
+	void build(const std::vector<BoundingBox> &boxes);
+	/** Replace the box of the indexed primitive and refit the nodes above it. */
+	void refit(int index, const BoundingBox &box);
+	/** Replace the boxes of the indexed primitives and refit the nodes above them in one pass. */
+	void refit(const std::vector<int> &indices, const std::vector<BoundingBox> &boxes);
+	/** Return the number of primitives. */
+	int sizePrimitives() const {return (int)_boxes.size();}
+	/** Return the number of nodes. */
+	int sizeNodes() const {return (int)_nodes.size();}
+	/** Get the box of the indexed primitive. */
+	const BoundingBox &getBox(int index) const {return _boxes[index];}
+	/** Get the box of all the primitives. */
+	BoundingBox getBox() const {return _nodes.empty() ? BoundingBox() : _nodes[0].box;}
+	/**
+	  * Visit the primitives whose boxes are nearer to the point than sqrt(bound2), the nearer nodes first.
+	  * The visitor is called as bound2 = visitor(index, box_distance2, bound2), so it can shrink the bound.
+	*/
+	template<class Visitor>
+	void visitNearest(const Point3D &point, Real bound2, Visitor &visitor) const;
+	/** Visit the primitives whose boxes overlap the box, the visitor is called as visitor(index). */
+	template<class Visitor>
+	void visitOverlapping(const BoundingBox &box, Visitor &visitor) const;
+	/**
+	  * Visit the pairs of primitives of this and the other hierarchy whose boxes overlap, the visitor is called
+	  * as visitor(index, other_index).
+	*/
+	template<class Visitor>
+	void visitOverlappingPairs(const BoundingVolumeHierarchy &other, Visitor &visitor) const;
+	/**
+	  * Visit the primitives whose boxes are hit by the ray origin + t * direction within [t_near, t_far],
+	  * the nearer nodes first. The visitor is called as t_far = visitor(index, entry, exit, t_far), so it can
+	  * shrink the ray when it finds a hit.
+	*/
+	template<class Visitor>
+	void visitRay(const Point3D &origin, const Point3D &inverse, Real t_near, Real t_far, Visitor &visitor) const;
+protected:
+	struct Node
+	{
+		BoundingBox box;
+		int first;	/** The first primitive of a leaf, or the first child of an inner node. */
+		int count;	/** The number of primitives of a leaf, 0 for an inner node. */
+		int parent;	/** The parent node, -1 for the root. */
+	};
+	void buildNode(int index, int first, int last);
+	enum { SAH_BINS = 16 };
+	/** Find the axis and the first bin of the right side where the SAH splits the primitives [first, last), return false if their centers cannot be separated. */
+	bool splitNode(const BoundingBox &centers, int first, int last, int &axis, int &bin) const;
+	/** Compute the box of the node from its children or primitives. */
+	BoundingBox fitNode(const Node &node) const;
+private:
+	int _leaf_size;
+	std::vector<Node> _nodes;
+	std::vector<int> _indices;
+	std::vector<int> _leaves;	/** The leaf node of each primitive. */
+	std::vector<BoundingBox> _boxes;
+};
+
+template<class Visitor>
+void BoundingVolumeHierarchy::visitNearest( const Point3D &point, Real bound2, Visitor &visitor ) const
+{
+	if (_nodes.empty()) return;
+	NodeStack<std::pair<Real, int> > stack;
+	stack.push(std::make_pair(_nodes[0].box.squaredDistance(point), 0));
+	while (!stack.empty())
+	{
+		std::pair<Real, int> top = stack.pop();
+		if (top.first > bound2) continue;
+		const Node &node = _nodes[top.second];
+		if (node.count > 0)
+		{
+			for (int i=node.first;i<node.first+node.count;i++)
+			{
+				Real d2 = _boxes[_indices[i]].squaredDistance(point);
+				if (d2 <= bound2) bound2 = visitor(_indices[i], d2, bound2);
+			}
+			continue;
+		}
+		// Push the farther child first, so that the nearer one is visited first.
+		Real d_left = _nodes[node.first].box.squaredDistance(point);
+		Real d_right = _nodes[node.first+1].box.squaredDistance(point);
+		if (d_left <= d_right)
+		{
+			stack.push(std::make_pair(d_right, node.first+1));
+			stack.push(std::make_pair(d_left, node.first));
+		}
+		else
+		{
+			stack.push(std::make_pair(d_left, node.first));
+			stack.push(std::make_pair(d_right, node.first+1));
+		}
+	}
+}
+
+template<class Visitor>
+void BoundingVolumeHierarchy::visitOverlapping( const BoundingBox &box, Visitor &visitor ) const
+{
+	if (_nodes.empty()) return;
+	NodeStack<int> stack;
+	stack.push(0);
+	while (!stack.empty())
+	{
+		const Node &node = _nodes[stack.pop()];
+		if (!node.box.overlaps(box)) continue;
+		if (node.count > 0)
+		{
+			for (int i=node.first;i<node.first+node.count;i++)
+			{
+				if (_boxes[_indices[i]].overlaps(box)) visitor(_indices[i]);
+			}
+			continue;
+		}
+		stack.push(node.first+1);
+		stack.push(node.first);
+	}
+}
+
+template<class Visitor>
+void BoundingVolumeHierarchy::visitOverlappingPairs( const BoundingVolumeHierarchy &other, Visitor &visitor ) const
+{
+	if (_nodes.empty() || other._nodes.empty()) return;
+	NodeStack<std::pair<int, int> > stack;
+	stack.push(std::make_pair(0, 0));
+	while (!stack.empty())
+	{
+		std::pair<int, int> top = stack.pop();
+		const Node &node = _nodes[top.first];
+		const Node &other_node = other._nodes[top.second];
+		if (!node.box.overlaps(other_node.box)) continue;
+		if (node.count > 0 && other_node.count > 0)
+		{
+			for (int i=node.first;i<node.first+node.count;i++)
+			{
+				for (int j=other_node.first;j<other_node.first+other_node.count;j++)
+				{
+					if (_boxes[_indices[i]].overlaps(other._boxes[other._indices[j]])) visitor(_indices[i], other._indices[j]);
+				}
+			}
+			continue;
+		}
+		// Descend the larger of the two nodes, unless it is a leaf.
+		if (other_node.count > 0 || (node.count == 0 && node.box.halfArea() >= other_node.box.halfArea()))
+		{
+			stack.push(std::make_pair(node.first+1, top.second));
+			stack.push(std::make_pair(node.first, top.second));
+		}
+		else
+		{
+			stack.push(std::make_pair(top.first, other_node.first+1));
+			stack.push(std::make_pair(top.first, other_node.first));
+		}
+	}
+}
+
+template<class Visitor>
+void BoundingVolumeHierarchy::visitRay( const Point3D &origin, const Point3D &inverse, Real t_near, Real t_far, Visitor &visitor ) const
+{
+	if (_nodes.empty()) return;
+	Real near0 = t_near, far0 = t_far;
+	if (!_nodes[0].box.clipRay(origin, inverse, near0, far0)) return;
+	NodeStack<std::pair<Real, int> > stack;
+	stack.push(std::make_pair(near0, 0));
+	while (!stack.empty())
+	{
+		std::pair<Real, int> top = stack.pop();
+		if (top.first > t_far) continue;
+		const Node &node = _nodes[top.second];
+		if (node.count > 0)
+		{
+			for (int i=node.first;i<node.first+node.count;i++)
+			{
+				Real entry = t_near, exit = t_far;
+				if (_boxes[_indices[i]].clipRay(origin, inverse, entry, exit)) t_far = visitor(_indices[i], entry, exit, t_far);
+			}
+			continue;
+		}
+		// Push the farther child first, so that the nearer one is visited first.
+		Real near_left = t_near, far_left = t_far, near_right = t_near, far_right = t_far;
+		bool left = _nodes[node.first].box.clipRay(origin, inverse, near_left, far_left);
+		bool right = _nodes[node.first+1].box.clipRay(origin, inverse, near_right, far_right);
+		if (left && right && near_left > near_right)
+		{
+			stack.push(std::make_pair(near_left, node.first));
+			stack.push(std::make_pair(near_right, node.first+1));
+			continue;
+		}
+		if (right) stack.push(std::make_pair(near_right, node.first+1));
+		if (left) stack.push(std::make_pair(near_left, node.first));
+	}
+}
+
+#ifdef use_namespace
+}
+#endif
+
+#endif
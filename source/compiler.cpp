@@ -0,0 +1,204 @@
+/*
+TSPLINE -- A T-spline object oriented package in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 3.0 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building,
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+   - Created.
+-------------------------------------------------------------------------------
+*/
+
+#include <compiler.h>
+#include <derivator.h>
+#include <extractor.h>
+#include <algorithm>
+
+#ifdef use_namespace
+namespace TSPLINE {
+	using namespace NEWMAT;
+#endif
+
+/** The largest order of the Bezier patches, the degrees of the blending bases are at most 5. */
+static const int MAX_ORDER = 6;
+
+const Real TFaceCompiler::CELL_MARGIN = 1e-6;
+
+/** Restrict the Bezier curve of n homogeneous points at the stride to [a, b] of its domain [0, 1], by de Casteljau. */
+static void restrictCurve(Real *points, int n, int stride, Real a, Real b)
+{
+	// The part on [0, b], then the part of it on [a / b, 1].
+	for (int k=1;k<n;k++)
+	{
+		for (int i=n-1;i>=k;i--)
+		{
+			for (int c=0;c<4;c++) points[i*stride+c] = (1.0-b)*points[(i-1)*stride+c] + b*points[i*stride+c];
+		}
+	}
+	Real x = b > 0.0 ? a / b : 0.0;
+	for (int k=1;k<n;k++)
+	{
+		for (int i=0;i<n-k;i++)
+		{
+			for (int c=0;c<4;c++) points[i*stride+c] = (1.0-x)*points[i*stride+c] + x*points[(i+1)*stride+c];
+		}
+	}
+}
+
+/** Restrict the Bezier patch of nu * nv homogeneous points to [a0, a1] x [b0, b1] of its domain [0, 1] x [0, 1]. */
+static void restrictNet(Real *net, int nu, int nv, Real a0, Real a1, Real b0, Real b1)
+{
+	for (int j=0;j<nv;j++) restrictCurve(net + 4*j, nu, 4*nv, a0, a1);
+	for (int i=0;i<nu;i++) restrictCurve(net + 4*i*nv, nv, 4, b0, b1);
+}
+
+void TFaceCompiler::compileFace( const TSplinePtr &spline, const TFacePtr &tface, TCompiledFace &face, BoundingBox &box )
+{
+	face.face = tface;
+	face.equation = TDerivator::prepareEquationByTFace(tface, spline->getSDegree(), spline->getTDegree());
+	Parameter northwest = tface->northWest(), southeast = tface->southEast();
+	face.equation->prepareTensors(northwest, southeast);
+
+	face.s_min = min(northwest.s(), southeast.s()); face.s_max = max(northwest.s(), southeast.s());
+	face.t_min = min(northwest.t(), southeast.t()); face.t_max = max(northwest.t(), southeast.t());
+
+	TExtractor::extractBoundingBoxFromTFace(tface, box);
+	face.size = box.isEmpty() ? 0.0 : (box.maximum() - box.minimum()).norm2();
+}
+
+void TFaceCompiler::compileFace( const TSplinePtr &spline, const TFacePtr &tface, TCompiledFace &face )
+{
+	BoundingBox box;
+	compileFace(spline, tface, face, box);
+}
+
+void TFaceCompiler::compilePatches( const TBezierExtractor &extractor, TCompiledFace &face )
+{
+	std::vector<TBezierPatch> patches;
+	extractor.extractFace(face.face, patches);
+	face.patches.resize(patches.size());
+	for (int i=0;i<(int)patches.size();i++)
+	{
+		TCompiledFace::Patch &patch = face.patches[i];
+		face.nu = patches[i].degree_s + 1; face.nv = patches[i].degree_t + 1;
+		patch.s_min = patches[i].s_min; patch.s_max = patches[i].s_max;
+		patch.t_min = patches[i].t_min; patch.t_max = patches[i].t_max;
+		patch.net.resize(4*patches[i].points.size());
+		for (int k=0;k<(int)patches[i].points.size();k++)
+		{
+			Real w = patches[i].weights[k];
+			patch.net[4*k] = patches[i].points[k].x() * w;
+			patch.net[4*k+1] = patches[i].points[k].y() * w;
+			patch.net[4*k+2] = patches[i].points[k].z() * w;
+			patch.net[4*k+3] = w;
+		}
+	}
+}
+
+void TFaceCompiler::cellDomain( const TCompiledFace &face, int resolution, int cell, Real &s0, Real &s1, Real &t0, Real &t1 )
+{
+	int i = cell / resolution, j = cell % resolution;
+	Real ds = (face.s_max - face.s_min) / resolution, dt = (face.t_max - face.t_min) / resolution;
+	s0 = face.s_min + ds*i; s1 = i+1 == resolution ? face.s_max : s0 + ds;
+	t0 = face.t_min + dt*j; t1 = j+1 == resolution ? face.t_max : t0 + dt;
+}
+
+void TFaceCompiler::boundCell( const TCompiledFace &face, Real s0, Real s1, Real t0, Real t1, BoundingBox &box, TCellSlab *slab )
+{
+	// The surface of the cell is in the convex hull of the control points of the patches restricted to it, 
+	// the box and the slab bound all of them. The plane of the slab is taken from the corners of the first patch.
+	Real net[4*MAX_ORDER*MAX_ORDER];
+	int size = face.nu * face.nv;
+	Real lower = 0.0, upper = 0.0;
+	Real normal[3] = {0.0, 0.0, 0.0}, center[3] = {0.0, 0.0, 0.0};
+	bool first = true;
+	box.clear();
+	for (int i=0;i<(int)face.patches.size();i++)
+	{
+		const TCompiledFace::Patch &patch = face.patches[i];
+		if (patch.s_max <= s0 || patch.s_min >= s1 || patch.t_max <= t0 || patch.t_min >= t1) continue;
+		std::copy(patch.net.begin(), patch.net.end(), net);
+		restrictNet(net, face.nu, face.nv, 
+			(max(s0, patch.s_min) - patch.s_min) / (patch.s_max - patch.s_min), (min(s1, patch.s_max) - patch.s_min) / (patch.s_max - patch.s_min), 
+			(max(t0, patch.t_min) - patch.t_min) / (patch.t_max - patch.t_min), (min(t1, patch.t_max) - patch.t_min) / (patch.t_max - patch.t_min));
+		for (int k=0;k<size;k++)
+		{
+			Real *point = net + 4*k;
+			for (int c=0;c<3;c++) point[c] = safeDivide(point[c], point[3]);
+			box.extend(Point3D(point[0], point[1], point[2]));
+		}
+		if (!slab) continue;
+		if (first)
+		{
+			const Real *p00 = net, *p01 = net + 4*(face.nv-1), *p10 = net + 4*(size-face.nv), *p11 = net + 4*(size-1);
+			Real along_s[3], along_t[3];
+			for (int c=0;c<3;c++)
+			{
+				along_s[c] = p10[c] - p00[c] + p11[c] - p01[c];
+				along_t[c] = p01[c] - p00[c] + p11[c] - p10[c];
+				center[c] = p00[c];
+			}
+			cross3(along_s, along_t, normal);
+			Real length = sqrt(dot3(normal, normal));
+			for (int c=0;c<3;c++) normal[c] = length > 0.0 ? normal[c] / length : 0.0;
+			first = false;
+		}
+		for (int k=0;k<size;k++)
+		{
+			const Real *point = net + 4*k;
+			const Real offset[3] = {point[0]-center[0], point[1]-center[1], point[2]-center[2]};
+			Real height = dot3(offset, normal);
+			lower = min(lower, height); upper = max(upper, height);
+		}
+	}
+	// The margin covers the rounding errors of the control points and of the Newton iterations.
+	Real margin = CELL_MARGIN * face.size;
+	box.enlarge(margin);
+	if (slab)
+	{
+		slab->normal = Point3D(normal[0], normal[1], normal[2]);
+		slab->center = Point3D(center[0], center[1], center[2]) + slab->normal * (0.5*(lower + upper));
+		slab->thickness = 0.5*(upper - lower) + margin;
+	}
+}
+
+void TFaceCompiler::boundCells( const TCompiledFace &face, int resolution, std::vector<BoundingBox> &boxes, std::vector<TCellSlab> *slabs )
+{
+	boxes.resize(resolution*resolution);
+	if (slabs) slabs->resize(boxes.size());
+	for (int cell=0;cell<(int)boxes.size();cell++)
+	{
+		Real s0, s1, t0, t1;
+		cellDomain(face, resolution, cell, s0, s1, t0, t1);
+		boundCell(face, s0, s1, t0, t1, boxes[cell], slabs ? &(*slabs)[cell] : 0);
+	}
+}
+
+#ifdef use_namespace
+}
+#endif
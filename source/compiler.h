@@ -0,0 +1,149 @@
+/*
+T-SPLINE -- A T-spline object oriented library in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 2.1 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building,
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+- Created.
+-------------------------------------------------------------------------------
+*/
+
+/**  @file  [compiler]
+  *  @brief  T-faces compiled for the queries on the exact surface.
+  *  @author  <agent>
+  *  @date  <2026.10.19>
+  *  @version  <v1.0>
+  *  @note
+  *  This file contains the compiled T-faces shared by the projector, the ray caster, the slicer, the intersector,
+  *  the integrator and the curvature map, with the bounds of their cells by the control points of the Bezier patches.
+*/
+
+#ifndef COMPILER_H
+#define COMPILER_H
+
+#include <utils.h>
+#include <tspline.h>
+#include <splbase.h>
+#include <bezier.h>
+
+#ifdef use_namespace
+namespace TSPLINE {
+	using namespace NEWMAT;
+#endif
+
+inline Real dot3( const Real *a, const Real *b )
+{
+	return a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+}
+
+inline void cross3( const Real *a, const Real *b, Real *c )
+{
+	c[0] = a[1]*b[2] - a[2]*b[1];
+	c[1] = a[2]*b[0] - a[0]*b[2];
+	c[2] = a[0]*b[1] - a[1]*b[0];
+}
+
+/** The squared distance from the point to the chord from a to b. */
+inline Real squaredChordDistance( const Real *point, const Real *a, const Real *b )
+{
+	Real ab[3] = {b[0]-a[0], b[1]-a[1], b[2]-a[2]};
+	Real ap[3] = {point[0]-a[0], point[1]-a[1], point[2]-a[2]};
+	Real length2 = dot3(ab, ab);
+	Real u = length2 > 0.0 ? max(0.0, min(1.0, dot3(ap, ab) / length2)) : 0.0;
+	Real d[3] = {ap[0]-u*ab[0], ap[1]-u*ab[1], ap[2]-u*ab[2]};
+	return dot3(d, d);
+}
+
+/** The squared distance from the point to the chord from a to b. */
+inline Real squaredChordDistance( const Point3D &point, const Point3D &a, const Point3D &b )
+{
+	const Real p[3] = {point.x(), point.y(), point.z()};
+	const Real pa[3] = {a.x(), a.y(), a.z()}, pb[3] = {b.x(), b.y(), b.z()};
+	return squaredChordDistance(p, pa, pb);
+}
+
+/** A T-face with its prepared blending equation, whose evaluation is const and shared by the threads. */
+struct TCompiledFace
+{
+	TCompiledFace() : s_min(0.0), s_max(0.0), t_min(0.0), t_max(0.0), size(0.0), nu(0), nv(0) {}
+	/** A rational Bezier patch of the T-face. */
+	struct Patch
+	{
+		Real s_min, s_max, t_min, t_max;
+		std::vector<Real> net;	/** The homogeneous control points (x, y and z multiplied by the weight, and the weight). */
+	};
+	TFacePtr face;
+	BlendingEquationPtr equation;
+	Real s_min, s_max, t_min, t_max;
+	Real size;		/** The diagonal of the box of the blending T-points. */
+	int nu, nv;		/** The orders of the patches, 0 if they are not compiled. */
+	std::vector<Patch> patches;
+};
+
+/** The space between two parallel planes. */
+struct TCellSlab
+{
+	Point3D center;
+	Point3D normal;		/** The unit normal of the planes, zero for a degenerate cell. */
+	Real thickness;		/** The distance from the center to each plane. */
+};
+
+/**
+  *  @class  <TFaceCompiler>
+  *  @brief  T-face compiler
+  *  @note
+  *  The compiler prepares the blending equation and the domain of a T-face, and on demand its rational Bezier patches.
+  *  The surface over a cell of the domain is in the convex hull of the control points of the patches restricted to the
+  *  cell, which bounds the cell with no sampling.
+*/
+class TFaceCompiler
+{
+public:
+	/** The margin added to the bounds of the cells, relative to the size of the T-face. */
+	static const Real CELL_MARGIN;
+public:
+	/** Compile the equation and the domain of the T-face, box is the box of its blending T-points. */
+	static void compileFace(const TSplinePtr &spline, const TFacePtr &tface, TCompiledFace &face, BoundingBox &box);
+	/** Compile the equation and the domain of the T-face. */
+	static void compileFace(const TSplinePtr &spline, const TFacePtr &tface, TCompiledFace &face);
+	/** Compile the rational Bezier patches of the compiled T-face. */
+	static void compilePatches(const TBezierExtractor &extractor, TCompiledFace &face);
+	/** Compute the domain of the cell of the uniform resolution * resolution grid over the T-face. */
+	static void cellDomain(const TCompiledFace &face, int resolution, int cell, Real &s0, Real &s1, Real &t0, Real &t1);
+	/** Bound the part of the T-face over [s0, s1] x [t0, t1] by the box and, if it is given, the slab. */
+	static void boundCell(const TCompiledFace &face, Real s0, Real s1, Real t0, Real t1, BoundingBox &box, TCellSlab *slab = 0);
+	/** Bound the cells of the uniform resolution * resolution grid over the T-face. */
+	static void boundCells(const TCompiledFace &face, int resolution, std::vector<BoundingBox> &boxes, std::vector<TCellSlab> *slabs = 0);
+};
+
+#ifdef use_namespace
+}
+#endif
+
+#endif
@@ -97,6 +97,14 @@ void TMapperCross::findFaces( TFacSet &faces )
 		OverlappedFaceFinder(square, faces));
 }
 
+void TMapperCross::findFaces( const TFacVector &candidates, TFacSet &faces )
+{
+	if (!_mapper_center) return;
+	ParameterSquarePtr square = blendParameterSquare();
+	std::for_each(candidates.begin(), candidates.end(), 
+		OverlappedFaceFinder(square, faces));
+}
+
 void TMapperCross::unique()
 {
 	uniqueMappers(_mappers_north);
@@ -215,6 +223,15 @@ void TNodeV4Cross::prepareRelationships()
 	_prepared = true;
 }
 
+void TNodeV4Cross::prepareRelationships( const TFacVector &candidates )
+{
+	if (isPrepared())
+		clearRelationships();
+	prepareTMapperCross();
+	_mapper_cross->findFaces(candidates, _faces);
+	_prepared = true;
+}
+
 void TNodeV4Cross::prepareTMapperCross()
 {
 	_mapper_cross->setCenter(findMapperOfNode(_node_center));
@@ -86,6 +86,8 @@ public:
 
 	/** Find all the T-faces covered by the cross. */
 	void findFaces(TFacSet &faces);
+	/** Find the T-faces covered by the cross among the candidates. */
+	void findFaces(const TFacVector &candidates, TFacSet &faces);
 
 	/** Make all the four T-mapper branches contain unique T-mappers. */
 	void unique();
@@ -166,6 +168,8 @@ public:
 	bool isPrepared();
 	/** Prepare the mapper and faces. */
 	void prepareRelationships();
+	/** Prepare the mapper and the faces among the candidates. */
+	void prepareRelationships(const TFacVector &candidates);
 	/** Clear the mapper and faces. */
 	void clearRelationships();
 
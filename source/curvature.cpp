@@ -0,0 +1,204 @@
+/*
+TSPLINE -- A T-spline object oriented package in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 3.0 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building,
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+   - Created.
+-------------------------------------------------------------------------------
+*/
+
+#include <curvature.h>
+#include <derivator.h>
+#include <extractor.h>
+
+#ifdef use_namespace
+namespace TSPLINE {
+	using namespace NEWMAT;
+#endif
+
+TCurvatureMap::TCurvatureMap( const TSplinePtr &spline )
+{
+	TFacVector faces;
+	TExtractor::extractBlendedTFacesFromTImage(spline->getTImage(), faces);
+	_faces.resize(faces.size());
+	for (int i=0;i<(int)faces.size();i++)
+	{
+		TFaceCompiler::compileFace(spline, faces[i], _faces[i]);
+		_indices[faces[i]] = i;
+	}
+}
+
+TCurvatureMap::~TCurvatureMap()
+{
+
+}
+
+const char * TCurvatureMap::getName( int curvature )
+{
+	static const char *names[CURVATURES] = {"gaussian_curvature", "mean_curvature", "max_curvature", "min_curvature"};
+	return curvature >= 0 && curvature < CURVATURES ? names[curvature] : "";
+}
+
+void TCurvatureMap::curvaturesByFundamentalForm( const Real *form, Real *curvatures )
+{
+	// The principal curvatures are undefined where the surface degenerates.
+	Real metric = form[0]*form[2] - form[1]*form[1];
+	if (metric <= 0.0)
+	{
+		std::fill(curvatures, curvatures+CURVATURES, 0.0);
+		return;
+	}
+	Real k1, k2;
+	TDerivator::principalCurvatureByFundamentalForm(form, k1, k2);
+	curvatures[GAUSSIAN] = k1*k2;
+	curvatures[MEAN] = 0.5*(k1 + k2);
+	curvatures[MAX] = k1;
+	curvatures[MIN] = k2;
+}
+
+int TCurvatureMap::findIndex( const TFacePtr &face ) const
+{
+	std::map<TFacePtr, int>::const_iterator found = _indices.find(face);
+	return found == _indices.end() ? -1 : found->second;
+}
+
+void TCurvatureMap::computeCurvatures( const Face &face, const Parameter *parameters, int n, Real *curvatures ) const
+{
+	for (int i=0;i<n;i++)
+	{
+		Real form[6];
+		face.equation->computeFundamentalForm(parameters[i], form);
+		curvaturesByFundamentalForm(form, &curvatures[CURVATURES*i]);
+	}
+}
+
+int TCurvatureMap::evaluate( int index, const std::vector<Parameter> &parameters, std::vector<Real> &curvatures ) const
+{
+	int n = (int)parameters.size();
+	curvatures.resize(CURVATURES*n);
+	if (n == 0) return 0;
+	// The evaluation of a prepared equation is const, so the parameters can be shared among threads.
+	const int CHUNK = 64;
+	int nchunks = (n + CHUNK - 1) / CHUNK;
+#ifdef USE_OMP
+#pragma omp parallel for schedule(static)
+#endif
+	for (int c=0;c<nchunks;c++)
+	{
+		int first = c*CHUNK;
+		computeCurvatures(_faces[index], &parameters[first], min(CHUNK, n - first), &curvatures[CURVATURES*first]);
+	}
+	return n;
+}
+
+int TCurvatureMap::evaluateGrid( int index, int resolution, TCurvatureGrid &grid ) const
+{
+	const Face &face = _faces[index];
+	grid.face = face.face;
+	grid.resolution = resolution < 1 ? 1 : resolution;
+	grid.s_min = face.s_min; grid.s_max = face.s_max;
+	grid.t_min = face.t_min; grid.t_max = face.t_max;
+
+	int n = grid.resolution + 1;
+	std::vector<Parameter> parameters(n*n);
+	for (int i=0;i<n;i++)
+	{
+		for (int j=0;j<n;j++)
+		{
+			parameters[i*n+j] = Parameter(face.s_min + (face.s_max-face.s_min)*i/grid.resolution, 
+				face.t_min + (face.t_max-face.t_min)*j/grid.resolution);
+		}
+	}
+	grid.values.resize(CURVATURES*n*n);
+	computeCurvatures(face, &parameters[0], n*n, &grid.values[0]);
+	return n*n;
+}
+
+int TCurvatureMap::evaluateGrids( int resolution, std::vector<TCurvatureGrid> &grids ) const
+{
+	int n = (int)_faces.size();
+	grids.resize(n);
+#ifdef USE_OMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+	for (int i=0;i<n;i++)
+	{
+		evaluateGrid(i, resolution, grids[i]);
+	}
+	return n;
+}
+
+int TCurvatureMap::evaluateMesh( const TFacePtr &face, const TriMeshPtr &mesh, std::vector<Real> &curvatures ) const
+{
+	curvatures.clear();
+	int index = findIndex(face);
+	long n = mesh->sizePoints();
+	if (index < 0 || n == 0 || mesh->sizeParameters() != n) return 0;
+
+	std::vector<Parameter> parameters(n);
+	for (long i=0;i<n;i++) parameters[i] = mesh->parameterAt(i);
+	return evaluate(index, parameters, curvatures);
+}
+
+int TCurvatureMap::attachToMeshes( const TFacVector &faces, const TriMshVector &meshes ) const
+{
+	int n = (int)min(faces.size(), meshes.size());
+	std::vector<int> counts(n, 0);
+#ifdef USE_OMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+	for (int i=0;i<n;i++)
+	{
+		int index = findIndex(faces[i]);
+		const TriMeshPtr &mesh = meshes[i];
+		long npoints = mesh->sizePoints();
+		if (index < 0 || npoints == 0 || mesh->sizeParameters() != npoints) continue;
+
+		std::vector<Parameter> parameters(npoints);
+		for (long j=0;j<npoints;j++) parameters[j] = mesh->parameterAt(j);
+		std::vector<Real> curvatures(CURVATURES*npoints);
+		computeCurvatures(_faces[index], &parameters[0], (int)npoints, &curvatures[0]);
+		for (int c=0;c<CURVATURES;c++)
+		{
+			std::vector<Real> values(npoints);
+			for (long j=0;j<npoints;j++) values[j] = curvatures[CURVATURES*j+c];
+			mesh->setAttribute(getName(c), values);
+		}
+		counts[i] = (int)npoints;
+	}
+
+	int count = 0;
+	for (int i=0;i<n;i++) count += counts[i];
+	return count;
+}
+
+#ifdef use_namespace
+}
+#endif
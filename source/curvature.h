@@ -0,0 +1,126 @@
+/*
+T-SPLINE -- A T-spline object oriented library in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 2.1 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building,
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+- Created.
+-------------------------------------------------------------------------------
+*/
+
+/**  @file  [curvature]
+  *  @brief  Curvature maps of a T-spline surface.
+  *  @author  <agent>
+  *  @date  <2026.10.19>
+  *  @version  <v1.0>
+  *  @note
+  *  This file contains the batch evaluation of the Gaussian, mean and principal curvatures on parameter
+  *  grids over the T-faces and at the vertices of their meshes, used for the analysis of surface quality.
+*/
+
+#ifndef CURVATURE_H
+#define CURVATURE_H
+
+#include <utils.h>
+#include <tspline.h>
+#include <splbase.h>
+#include <trimesh.h>
+#include <compiler.h>
+
+#ifdef use_namespace
+namespace TSPLINE {
+	using namespace NEWMAT;
+#endif
+
+DECLARE_SMARTPTR(TCurvatureMap);
+
+/** The curvatures on a grid of (resolution + 1) * (resolution + 1) parameters over the domain of a T-face. */
+struct TCurvatureGrid
+{
+	TCurvatureGrid() : resolution(0), s_min(0.0), s_max(0.0), t_min(0.0), t_max(0.0) {}
+	TFacePtr face;
+	int resolution;
+	Real s_min, s_max, t_min, t_max;
+	std::vector<Real> values;	/** The curvatures of each parameter in the order of TCurvatureMap::CURVATURE, the sample (i, j) at i * (resolution + 1) + j. */
+};
+
+/**
+  *  @class  <TCurvatureMap>
+  *  @brief  T-spline curvature map
+  *  @note
+  *  The blending equation of every T-face is compiled once, and the curvatures of a batch of parameters on a T-face are
+  *  computed from the fundamental forms of BlendingEquation::computeFundamentalForm, which evaluates the derivatives in one
+  *  pass, without searching the T-face of each parameter as TDerivator does. Where the surface is degenerate (E*G-F*F = 0)
+  *  all the curvatures are 0. The T-faces, and the parameters of a single T-face, are evaluated on all the threads.
+  *  The curvatures at the vertices of a mesh need the parameters recorded by TTessellator (see TriMesh::addParameter),
+  *  and can be attached to the mesh as vertex attributes named by getName, which TriMesh::merge carries over.
+*/
+class TCurvatureMap
+{
+public:
+	TCurvatureMap(const TSplinePtr &spline);
+	~TCurvatureMap();
+public:
+	/** The curvatures of a parameter, max and min being the principal curvatures. */
+	enum CURVATURE { GAUSSIAN = 0, MEAN, MAX, MIN, CURVATURES };
+	/** Return the name of the vertex attribute of the curvature. */
+	static const char *getName(int curvature);
+	/** Compute the curvatures from the fundamental form coefficients E F G L M N. */
+	static void curvaturesByFundamentalForm(const Real *form, Real *curvatures);
+public:
+	/** Return the number of T-faces. */
+	int sizeFaces() const {return (int)_faces.size();}
+	/** Get the indexed T-face. */
+	TFacePtr getFace(int index) const {return _faces[index].face;}
+	/** Find the index of the T-face, return -1 if it is not a T-face of the T-spline. */
+	int findIndex(const TFacePtr &face) const;
+public:
+	/** Compute the curvatures of the parameters on the indexed T-face, CURVATURES reals per parameter. */
+	int evaluate(int index, const std::vector<Parameter> &parameters, std::vector<Real> &curvatures) const;
+	/** Compute the curvatures on a grid over the indexed T-face. */
+	int evaluateGrid(int index, int resolution, TCurvatureGrid &grid) const;
+	/** Compute the curvatures on a grid over every T-face in their order, return the number of grids. */
+	int evaluateGrids(int resolution, std::vector<TCurvatureGrid> &grids) const;
+	/** Compute the curvatures at the vertices of the mesh of the T-face, return the number of vertices, 0 if the mesh has no parameters. */
+	int evaluateMesh(const TFacePtr &face, const TriMeshPtr &mesh, std::vector<Real> &curvatures) const;
+	/** Attach the curvatures as vertex attributes to the mesh of each T-face, see TTessellator::interpolateFaces, return the number of vertices. */
+	int attachToMeshes(const TFacVector &faces, const TriMshVector &meshes) const;
+protected:
+	typedef TCompiledFace Face;
+	void computeCurvatures(const Face &face, const Parameter *parameters, int n, Real *curvatures) const;
+private:
+	std::vector<Face> _faces;
+	std::map<TFacePtr, int> _indices;
+};
+
+#ifdef use_namespace
+}
+#endif
+
+#endif
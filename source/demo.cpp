@@ -70,6 +70,8 @@ int main(void)
 	//SimpleDemoPtr demo = makePtr<SimpleDemo>();
 	MouseDemoPtr demo = makePtr<MouseDemo>();
 	TSplinePtr spline = demo->findTSpline();
+	if (int conflicts = demo->getTJunctionConflicts())
+		cout << "T-junctions: " << conflicts << " pairs of extensions split the same face along different lines." << endl;
 	std::string splinename = spline->getName();
 
 	TTessellator tessellator(spline);
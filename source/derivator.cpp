@@ -59,7 +59,7 @@ int TDerivator::pointDerive( const Parameter &parameter, Point3D &point )
 	TFacePtr tface = findTFaceByParameter(parameter);
 	if (!tface)  return 0;
 
-	BlendingEquationPtr equation = prepareEquationByTFace(tface);
+	BlendingEquationPtr equation = prepareEquationByTFace(tface, _spline->getSDegree(), _spline->getTDegree());
 	point = equation->computePoint(parameter.s(), parameter.t());
 
 	return 1;
@@ -76,7 +76,7 @@ int TDerivator::pointAndNormalDerive( const Parameter &parameter, Point3D &point
 	TFacePtr face = findTFaceByParameter(parameter);
 	if (!face)  return 0;
 
-	BlendingEquationPtr equation = prepareEquationByTFace(face);
+	BlendingEquationPtr equation = prepareEquationByTFace(face, _spline->getSDegree(), _spline->getTDegree());
 	equation->computePointAndNormal(parameter, point, normal);
 
 	return 1;
@@ -94,10 +94,21 @@ RBD_COMMON::Real TDerivator::normalCurvature( const Parameter &parameter, Real d
 void TDerivator::principalCurvature( const Parameter &parameter, Real &k1, Real &k2 )
 {
 	ColumnVector fform = firstAndSecondFundamentalForm(parameter);
-	Real E = fform(1), F = fform(2), G = fform(3), L = fform(4), M = fform(5), N = fform(6);
+	principalCurvatureByFundamentalForm(fform, k1, k2);
+}
+
+void TDerivator::principalCurvatureByFundamentalForm( const ColumnVector &fform, Real &k1, Real &k2 )
+{
+	principalCurvatureByFundamentalForm(fform.data(), k1, k2);
+}
+
+void TDerivator::principalCurvatureByFundamentalForm( const Real *form, Real &k1, Real &k2 )
+{
+	Real E = form[0], F = form[1], G = form[2], L = form[3], M = form[4], N = form[5];
 
 	Real A = E*N - 2.0*F*M + G*L;
-	Real B = sqrt((E*N - 2.0*F*M + G*L)*(E*N - 2.0*F*M + G*L) - 4.0*(E*G-F*F)*(N*L-M*M));
+	// The discriminant is never negative but at an umbilic, where the rounding may take it below 0.
+	Real B = sqrt(max(A*A - 4.0*(E*G-F*F)*(N*L-M*M), 0.0));
 	Real C = 2.0*(E*G-F*F);
 
 	k1 = (A + B) / C;
@@ -109,7 +120,7 @@ NEWMAT::ReturnMatrix TDerivator::firstPartialDeriveU( const Parameter &parameter
 	TFacePtr face = findTFaceByParameter(parameter);
 	if (!face)  return 0;
 
-	BlendingEquationPtr equation = prepareEquationByTFace(face);
+	BlendingEquationPtr equation = prepareEquationByTFace(face, _spline->getSDegree(), _spline->getTDegree());
 	return equation->computeFirstDerivative(BlendingEquation::DER_U, parameter);
 }
 
@@ -118,7 +129,7 @@ NEWMAT::ReturnMatrix TDerivator::firstPartialDeriveV( const Parameter &parameter
 	TFacePtr face = findTFaceByParameter(parameter);
 	if (!face)  return 0;
 
-	BlendingEquationPtr equation = prepareEquationByTFace(face);
+	BlendingEquationPtr equation = prepareEquationByTFace(face, _spline->getSDegree(), _spline->getTDegree());
 	return equation->computeFirstDerivative(BlendingEquation::DER_V, parameter);
 }
 
@@ -127,7 +138,7 @@ NEWMAT::ReturnMatrix TDerivator::secondPartialDeriveUU( const Parameter &paramet
 	TFacePtr face = findTFaceByParameter(parameter);
 	if (!face)  return 0;
 
-	BlendingEquationPtr equation = prepareEquationByTFace(face);
+	BlendingEquationPtr equation = prepareEquationByTFace(face, _spline->getSDegree(), _spline->getTDegree());
 	return equation->computeSecondDerivative(BlendingEquation::DER_U, BlendingEquation::DER_U, parameter);
 }
 
@@ -136,7 +147,7 @@ NEWMAT::ReturnMatrix TDerivator::secondPartialDeriveUV( const Parameter &paramet
 	TFacePtr face = findTFaceByParameter(parameter);
 	if (!face)  return 0;
 
-	BlendingEquationPtr equation = prepareEquationByTFace(face);
+	BlendingEquationPtr equation = prepareEquationByTFace(face, _spline->getSDegree(), _spline->getTDegree());
 	return equation->computeSecondDerivative(BlendingEquation::DER_U, BlendingEquation::DER_V, parameter);
 }
 
@@ -145,7 +156,7 @@ NEWMAT::ReturnMatrix TDerivator::secondPartialDeriveVV( const Parameter &paramet
 	TFacePtr face = findTFaceByParameter(parameter);
 	if (!face)  return 0;
 
-	BlendingEquationPtr equation = prepareEquationByTFace(face);
+	BlendingEquationPtr equation = prepareEquationByTFace(face, _spline->getSDegree(), _spline->getTDegree());
 	return equation->computeSecondDerivative(BlendingEquation::DER_V, BlendingEquation::DER_V, parameter);
 }
 
@@ -154,13 +165,55 @@ NEWMAT::ReturnMatrix TDerivator::secondPartialDerive(const Parameter &parameter)
 	TFacePtr face = findTFaceByParameter(parameter);
 	if (!face)  return 0;
 
-	BlendingEquationPtr equation = prepareEquationByTFace(face);
+	BlendingEquationPtr equation = prepareEquationByTFace(face, _spline->getSDegree(), _spline->getTDegree());
 	return equation->computeUpToSecondDerivatives(parameter);
 }
 
 ReturnMatrix TDerivator::firstAndSecondFundamentalForm( const Parameter &parameter )
 {
-	Matrix derivatives = secondPartialDerive(parameter);
+	ColumnVector fform(6);
+	fundamentalForm(parameter, fform.data());
+
+	fform.Release();
+	return fform;
+}
+
+int TDerivator::fundamentalForm( const Parameter &parameter, Real *form )
+{
+	std::fill(form, form+6, 0.0);
+	TFacePtr face = findTFaceByParameter(parameter);
+	if (!face)  return 0;
+
+	BlendingEquationPtr equation = prepareEquationByTFace(face, _spline->getSDegree(), _spline->getTDegree());
+	equation->computeFundamentalForm(parameter, form);
+	return 1;
+}
+
+int TDerivator::fundamentalForms( const std::vector<Parameter> &parameters, std::vector<Real> &forms )
+{
+	forms.assign(6*parameters.size(), 0.0);
+	// Neighbouring parameters mostly share a T-face, so the equation of the last one is kept.
+	TFacePtr last_face;
+	BlendingEquationPtr equation;
+	int count = 0;
+	for (size_t i = 0; i < parameters.size(); i++)
+	{
+		TFacePtr face = findTFaceByParameter(parameters[i]);
+		if (!face)  continue;
+		if (face != last_face)
+		{
+			equation = prepareEquationByTFace(face, _spline->getSDegree(), _spline->getTDegree());
+			equation->prepareTensors(face->northWest(), face->southEast());
+			last_face = face;
+		}
+		equation->computeFundamentalForm(parameters[i], &forms[6*i]);
+		count++;
+	}
+	return count;
+}
+
+ReturnMatrix TDerivator::fundamentalFormByDerivatives( const Matrix &derivatives )
+{
 	ColumnVector Sss = derivatives.Column(1);
 	ColumnVector Sst = derivatives.Column(2);
 	ColumnVector Stt = derivatives.Column(3);
@@ -188,16 +241,20 @@ TFacePtr TDerivator::findTFaceByParameter( const Parameter &parameter )
 	return finder->findTFaceByParameter(parameter);
 }
 
-BlendingEquationPtr TDerivator::prepareEquationByTFace( const TFacePtr &face )
+BlendingEquationPtr TDerivator::prepareEquationByTFace( const TFacePtr &face, int degree_s /*= 3*/, int degree_t /*= 3*/ )
 {
-	BlendingEquationPtr equation = makePtr<BlendingEquation>();
+	// A T-face outside the region of a partial load has no blending T-nodes, its surface is unknown.
+	if (face->sizeBlendingNodes() == 0)
+		Throw(ProgramException("T-face without blending T-nodes can not be evaluated"));
+	BlendingEquationPtr equation = makePtr<BlendingEquation>(degree_s, degree_t);
 	TNodVIterator iter = face->blendingNodeIteratorBegin();
 	for (;iter != face->blendingNodeIteratorEnd();iter++)
 	{
 		std::vector<Real> u_nodes, v_nodes;
 		Point3D control_point; Real weight;
 		TNodeV4Ptr node_v4 = castPtr<TNodeV4>(*iter);
-		TExtractor::extractUVKnotsFromTNodeV4(node_v4, u_nodes, v_nodes);
+		if (!TExtractor::extractUVKnotsFromTNodeV4(node_v4, u_nodes, v_nodes, degree_s, degree_t))
+			Throw(ProgramException("unsupported degree of blending function"));
 		TExtractor::extractRationalPointFromTNodeV4(node_v4, control_point, weight);
 		equation->addRationalPointWithNodes(u_nodes, v_nodes, control_point, weight);
 	}
@@ -209,7 +266,8 @@ TFaceDerivator::TFaceDerivator( const TSplinePtr &spline, const TFacePtr &tface
 {
 	if (_face)  
 	{
-		_equation = prepareEquationByTFace(_face);
+		_equation = prepareEquationByTFace(_face, spline->getSDegree(), spline->getTDegree());
+		_equation->prepareTensors(_face->northWest(), _face->southEast());
 	}
 }
 
@@ -290,6 +348,27 @@ ReturnMatrix TFaceDerivator::secondPartialDerive( const Parameter &parameter )
 	return _equation->computeUpToSecondDerivatives(parameter);
 }
 
+int TFaceDerivator::fundamentalForm( const Parameter &parameter, Real *form )
+{
+	_equation->computeFundamentalForm(parameter, form);
+	return 1;
+}
+
+int TFaceDerivator::fundamentalForms( const std::vector<Parameter> &parameters, std::vector<Real> &forms )
+{
+	forms.resize(6*parameters.size());
+	int n = (int)parameters.size();
+	// The evaluation of a prepared equation is const, so the parameters can be shared among threads.
+#ifdef USE_OMP
+#pragma omp parallel for schedule(static)
+#endif
+	for (int i = 0; i < n; i++)
+	{
+		_equation->computeFundamentalForm(parameters[i], &forms[6*i]);
+	}
+	return n;
+}
+
 #ifdef use_namespace
 }
 #endif
\ No newline at end of file
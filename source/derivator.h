@@ -106,10 +106,25 @@ public:
 	E F G L M N
 	*/
 	ReturnMatrix firstAndSecondFundamentalForm(const Parameter &parameter);
+	/** Calculate the fundamental form coefficients E F G L M N into form[0..5] without allocation, return 0 if there is no T-face. */
+	virtual int fundamentalForm(const Parameter &parameter, Real *form);
+	/** 
+	  * Calculate the fundamental form coefficients of a batch of parameters (e.g. for curvature maps) into
+	  * 6 reals E F G L M N per parameter, those out of the T-faces are set to 0. Return the number of evaluated parameters.
+	*/
+	virtual int fundamentalForms(const std::vector<Parameter> &parameters, std::vector<Real> &forms);
+
+public:
+	/** Prepare the blending equation of a T-face, the degrees are those of the T-spline (1 to 5). */
+	static BlendingEquationPtr prepareEquationByTFace(const TFacePtr &tface, int degree_s = 3, int degree_t = 3);
+	/** Calculate the fundamental form coefficients E F G L M N from the 3*6 matrix of secondPartialDerive. */
+	static ReturnMatrix fundamentalFormByDerivatives(const Matrix &derivatives);
+	/** Calculate the principal curvatures from the fundamental form coefficients E F G L M N. */
+	static void principalCurvatureByFundamentalForm(const ColumnVector &fform, Real &k1, Real &k2);
+	static void principalCurvatureByFundamentalForm(const Real *form, Real &k1, Real &k2);
 	
 protected:
 	TFacePtr findTFaceByParameter(const Parameter &parameter);
-	BlendingEquationPtr prepareEquationByTFace(const TFacePtr &tface);
 private:
 	TSplinePtr _spline;
 };
@@ -153,6 +168,10 @@ public:
 	6th column:	 point on the T-spline surface.
 	*/
 	virtual ReturnMatrix secondPartialDerive(const Parameter &parameter);
+	/** Calculate the fundamental form coefficients E F G L M N on the T-face. */
+	virtual int fundamentalForm(const Parameter &parameter, Real *form);
+	/** Calculate the fundamental form coefficients of a batch of parameters on the T-face. */
+	virtual int fundamentalForms(const std::vector<Parameter> &parameters, std::vector<Real> &forms);
 
 protected:
 
@@ -64,7 +64,7 @@ TGroupEditor::~TGroupEditor()
 }
 
 TSplineEditor::TSplineEditor( const TSplinePtr &spline ) :
-	_spline(spline)
+	_spline(spline), _dependencies_prepared(false)
 {
 }
 
@@ -75,7 +75,9 @@ TSplineEditor::~TSplineEditor()
 
 void TSplineEditor::movePointBy( const TPointPtr &point, Real x, Real y, Real z )
 {
-	if (point) point->setXYZW(point->getX()+x, point->getY()+y, point->getZ()+z, point->getW());
+	if (!point) return;
+	point->setXYZW(point->getX()+x, point->getY()+y, point->getZ()+z, point->getW());
+	markPointDirty(point);
 }
 
 void TSplineEditor::movePointBy( const std::string &point_name, Real x, Real y, Real z )
@@ -85,7 +87,9 @@ void TSplineEditor::movePointBy( const std::string &point_name, Real x, Real y,
 
 void TSplineEditor::movePointTo( const TPointPtr &point, Real x, Real y, Real z )
 {
-	if (point) point->setXYZW(x, y, z, point->getW());
+	if (!point) return;
+	point->setXYZW(x, y, z, point->getW());
+	markPointDirty(point);
 }
 
 void TSplineEditor::movePointTo( const std::string &point_name, Real x, Real y, Real z )
@@ -95,7 +99,9 @@ void TSplineEditor::movePointTo( const std::string &point_name, Real x, Real y,
 
 void TSplineEditor::setPointWeight( const TPointPtr &point, Real weight )
 {
+	if (!point) return;
 	point->setXYZW(point->getX(), point->getY(), point->getZ(), weight);
+	markPointDirty(point);
 }
 
 void TSplineEditor::setPointWeight( const std::string &point_name, Real weight )
@@ -123,6 +129,8 @@ void TSplineEditor::removeNode( const TNodePtr &node )
 	TNodeV4Ptr south = nodev4->getSouth();
 	TNodeV4Ptr east = nodev4->getEast();
 
+	markKnotNeighborsDirty(nodev4);
+
 	if (north && north->getSouth()==nodev4)
 	{
 		north->setSouth(south);
@@ -140,6 +148,9 @@ void TSplineEditor::removeNode( const TNodePtr &node )
 		east->setWest(west);
 	}
 
+	markPointDirty(node->getTPoint());
+	_dependencies_prepared = false;
+
 	node->getTVertex()->removeNode(node);
 	node->getTPoint()->setTNode(0);
 	_spline->getTConnect()->removeObject(node);
@@ -151,6 +162,93 @@ void TSplineEditor::removeNode( const std::string &node_name )
 	removeNode(findNode(node_name));
 }
 
+TFacVector TSplineEditor::dependentFaces( const TPointPtr &point )
+{
+	prepareDependencies();
+	std::map<TPointPtr, TFacVector>::iterator iter = _dependencies.find(point);
+	if (iter != _dependencies.end())
+	{
+		return iter->second;
+	}
+	else
+	{
+		return TFacVector();
+	}
+}
+
+void TSplineEditor::takeDirtyFaces( TFacVector &dirty_faces )
+{
+	dirty_faces.swap(_dirty_faces);
+	_dirty_faces.clear();
+	_dirty_set.clear();
+}
+
+void TSplineEditor::prepareDependencies()
+{
+	if (_dependencies_prepared) return;
+	_dependencies.clear();
+
+	TImagePtr image = _spline->getTImage();
+	if (image)
+	{
+		for (TFacVIterator fiter = image->faceIteratorBegin(); fiter != image->faceIteratorEnd(); fiter++)
+		{
+			TNodVIterator niter = (*fiter)->blendingNodeIteratorBegin();
+			for (;niter != (*fiter)->blendingNodeIteratorEnd();niter++)
+			{
+				TPointPtr point = (*niter)->getTPoint();
+				if (point) _dependencies[point].push_back(*fiter);
+			}
+		}
+	}
+	_dependencies_prepared = true;
+}
+
+void TSplineEditor::markKnotNeighborsDirty( const TNodeV4Ptr &node )
+{
+	// The links are not symmetric at T-junctions, a T-node may reach the node while the node does not 
+	// reach it back, so all the T-nodes are searched as far as their knots reach.
+	int reach_s = _spline->getSDegree() / 2 + 1, reach_t = _spline->getTDegree() / 2 + 1;
+	TConnectPtr connect = _spline->getTConnect();
+	for (TObjVIterator iter = connect->iteratorBegin(); iter != connect->iteratorEnd(); iter++)
+	{
+		TNodePtr object = (*iter)->asTNode();
+		TNodeV4Ptr other = object ? object->asTNodeV4() : TNodeV4Ptr();
+		if (!other || other == node) continue;
+		bool reached = false;
+		TNodeV4Ptr west = other, east = other, north = other, south = other;
+		for (int i=0;i<reach_s && !reached;i++)
+		{
+			if (west) west = west->getWest();
+			if (east) east = east->getEast();
+			reached = (west == node || east == node);
+		}
+		for (int i=0;i<reach_t && !reached;i++)
+		{
+			if (north) north = north->getNorth();
+			if (south) south = south->getSouth();
+			reached = (north == node || south == node);
+		}
+		if (reached) markPointDirty(other->getTPoint());
+	}
+}
+
+void TSplineEditor::markPointDirty( const TPointPtr &point )
+{
+	if (!point) return;
+	prepareDependencies();
+	std::map<TPointPtr, TFacVector>::iterator iter = _dependencies.find(point);
+	if (iter == _dependencies.end()) return;
+
+	for (TFacVIterator fiter = iter->second.begin(); fiter != iter->second.end(); fiter++)
+	{
+		if (_dirty_set.insert(*fiter).second)
+		{
+			_dirty_faces.push_back(*fiter);
+		}
+	}
+}
+
 TPointPtr TSplineEditor::findPoint( const std::string& point_name )
 {
 	TPointsetPtr pointset =	_spline->getTPointset();
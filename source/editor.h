@@ -95,7 +95,9 @@ DECLARE_ASSISTANCES(TGroupEditor, TGrpEdt)
   *  @class  <TSplineEditor> 
   *  @brief  T-spline editor
   *  @note  
-  *  The TSplineEditor is used to edit a T-spline.
+  *  The TSplineEditor is used to edit a T-spline. It tracks the T-faces depending on each T-point,
+  *  so that an edit only marks the affected T-faces dirty, see TTessellator::invalidateFaces and
+  *  TSnapshotPublisher::publish.
 */
 class TSplineEditor
 {
@@ -126,11 +128,28 @@ public:
 	/** Remove a named T-node. */
 	void removeNode(const std::string &node_name);
 
+public:
+	/** Return the T-faces which list the T-point as a blending node. */
+	TFacVector dependentFaces(const TPointPtr &point);
+	/** 
+	  * Move the T-faces changed by the edits since the last call into dirty_faces, and clear the list, so a caller 
+	  * feeding both TTessellator::invalidateFaces and TFaceHierarchy::refitFaces must pass the same vector to both.
+	*/
+	void takeDirtyFaces(TFacVector &dirty_faces);
+
 protected:
 	TPointPtr findPoint(const std::string& point_name);
 	TNodePtr findNode(const std::string& node_name);
+	void prepareDependencies();
+	void markPointDirty(const TPointPtr &point);
+	/** Mark the T-faces of the T-nodes whose knots reach the node dirty, their knots change when it is removed. */
+	void markKnotNeighborsDirty(const TNodeV4Ptr &node);
 private:
 	TSplinePtr _spline;
+	std::map<TPointPtr, TFacVector> _dependencies;
+	bool _dependencies_prepared;
+	TFacVector _dirty_faces;
+	TFacSet _dirty_set;
 };
 DECLARE_ASSISTANCES(TSplineEditor, TSplEdt)
 
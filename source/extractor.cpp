@@ -94,7 +94,7 @@ TNodeV4Ptr TExtractor::extractSouthFromTNodeV4( const TNodeV4Ptr &node, TNodeV4P
 	return def;
 }
 
-void TExtractor::extractCrossFromTNodeV4( const TNodeV4Ptr &node, TNodeV4CrossPtr &node_cross, int degree_s, int degree_t)
+void TExtractor::extractCrossFromTNodeV4( const TNodeV4Ptr &node, TNodeV4CrossPtr &node_cross, int degree_s, int degree_t, bool prepare /*= true*/)
 {
 	if (degree_s == 3 && degree_t == 3)
 	{
@@ -113,26 +113,36 @@ void TExtractor::extractCrossFromTNodeV4( const TNodeV4Ptr &node, TNodeV4CrossPt
 		node_cross->addNodeWest(kh2); node_cross->addNodeWest(kh1);
 		node_cross->addNodeSouth(kv4); node_cross->addNodeSouth(kv5);
 		node_cross->addNodeEast(kh4); node_cross->addNodeEast(kh5);
-		node_cross->prepareRelationships();
+		if (prepare) node_cross->prepareRelationships();
 	}
-	else if (degree_s == 2 && degree_t == 2)
+	else if (degree_s >= 1 && degree_t >= 1)
 	{
-		TNodeV4Ptr kh1, kh2, kh3;
-		TNodeV4Ptr kv1, kv2, kv3;
-		kh2 = node; kv2 = node;
-
-		kh1 = extractNonNullWestFromTNodeV4(kh2);
-		kh3 = extractNonNullEastFromTNodeV4(kh2);
-
-		kv1 = extractNonNullNorthFromTNodeV4(kv2);
-		kv3 = extractNonNullSouthFromTNodeV4(kv2);
-
+		// The same nodes as the knots of extractUVKnotsFromTNodeV4.
+		TNodeV4Ptr kh = node, kv = node;
 		node_cross->setNodeCenter(node);
-		node_cross->addNodeNorth(kv1);
-		node_cross->addNodeWest(kh1);
-		node_cross->addNodeSouth(kv3);
-		node_cross->addNodeEast(kh3);
-		node_cross->prepareRelationships();
+		for (int i=0;i<(degree_s+1)/2;i++)
+		{
+			kh = extractNonNullWestFromTNodeV4(kh);
+			node_cross->addNodeWest(kh);
+		}
+		kh = node;
+		for (int i=0;i<degree_s/2+1;i++)
+		{
+			kh = extractNonNullEastFromTNodeV4(kh);
+			node_cross->addNodeEast(kh);
+		}
+		for (int i=0;i<(degree_t+1)/2;i++)
+		{
+			kv = extractNonNullSouthFromTNodeV4(kv);
+			node_cross->addNodeSouth(kv);
+		}
+		kv = node;
+		for (int i=0;i<degree_t/2+1;i++)
+		{
+			kv = extractNonNullNorthFromTNodeV4(kv);
+			node_cross->addNodeNorth(kv);
+		}
+		if (prepare) node_cross->prepareRelationships();
 	}
 }
 
@@ -188,6 +198,41 @@ void TExtractor::extractUVKnotsFromTNodeV4( const TNodeV4Ptr &node_v4, std::vect
 	if (kv1) v_nodes.push_back(kv1->getTVertex()->getT());
 }
 
+int TExtractor::extractUVKnotsFromTNodeV4( const TNodeV4Ptr &node_v4, std::vector<Real> &u_nodes, std::vector<Real> &v_nodes, int degree_s, int degree_t )
+{
+	if (degree_s < 1 || degree_t < 1) return 0;
+	if (degree_s == 3 && degree_t == 3)
+	{
+		extractUVKnotsFromTNodeV4(node_v4, u_nodes, v_nodes);
+		return 1;
+	}
+
+	// An odd degree centers the knots on the node, an even degree on the cell north east of the node:
+	// degree/2 knots before the node and degree/2+1 after it.
+	int west_s = (degree_s + 1) / 2, east_s = degree_s / 2 + 1;
+	int south_t = (degree_t + 1) / 2, north_t = degree_t / 2 + 1;
+	std::vector<TNodeV4Ptr> west(1, node_v4), east, south(1, node_v4), north;
+	for (int i=0;i<west_s;i++)
+		west.push_back(extractNonNullWestFromTNodeV4(west.back()));
+	for (int i=0;i<east_s;i++)
+		east.push_back(extractNonNullEastFromTNodeV4(i == 0 ? node_v4 : east.back()));
+	for (int i=0;i<south_t;i++)
+		south.push_back(extractNonNullSouthFromTNodeV4(south.back()));
+	for (int i=0;i<north_t;i++)
+		north.push_back(extractNonNullNorthFromTNodeV4(i == 0 ? node_v4 : north.back()));
+
+	for (std::vector<TNodeV4Ptr>::reverse_iterator iter = west.rbegin(); iter != west.rend(); iter++)
+		if (*iter) u_nodes.push_back((*iter)->getTVertex()->getS());
+	for (std::vector<TNodeV4Ptr>::iterator iter = east.begin(); iter != east.end(); iter++)
+		if (*iter) u_nodes.push_back((*iter)->getTVertex()->getS());
+
+	for (std::vector<TNodeV4Ptr>::reverse_iterator iter = south.rbegin(); iter != south.rend(); iter++)
+		if (*iter) v_nodes.push_back((*iter)->getTVertex()->getT());
+	for (std::vector<TNodeV4Ptr>::iterator iter = north.begin(); iter != north.end(); iter++)
+		if (*iter) v_nodes.push_back((*iter)->getTVertex()->getT());
+	return 1;
+}
+
 void TExtractor::extractRationalPointFromTNodeV4( const TNodeV4Ptr &node_v4, Point3D &point, Real &weight )
 {
 	TPointPtr tpoint = node_v4->getTPoint();
@@ -197,6 +242,26 @@ void TExtractor::extractRationalPointFromTNodeV4( const TNodeV4Ptr &node_v4, Poi
 	weight = tpoint->getW();
 }
 
+void TExtractor::extractBoundingBoxFromTFace( const TFacePtr &face, BoundingBox &box )
+{
+	// The surface is a convex combination of the blending T-points (variation diminishing), so is in their convex hull.
+	box.clear();
+	for (TNodVIterator iter = face->blendingNodeIteratorBegin(); iter != face->blendingNodeIteratorEnd(); iter++)
+	{
+		TPointPtr point = (*iter)->getTPoint();
+		if (point) box.extend(Point3D(point->getX(), point->getY(), point->getZ()));
+	}
+}
+
+void TExtractor::extractBlendedTFacesFromTImage( const TImagePtr &image, TFacVector &faces )
+{
+	if (!image) return;
+	for (TFacVIterator iter = image->faceIteratorBegin(); iter != image->faceIteratorEnd(); iter++)
+	{
+		if ((*iter)->sizeBlendingNodes() > 0) faces.push_back(*iter);
+	}
+}
+
 void TExtractor::extractTFacesFromTNodeV4( const TNodeV4Ptr &node, TFacVector &faces, int degree_s /*= 3*/, int degree_t /*= 3*/ )
 {
 	TNodeV4CrossPtr node_cross = makePtr<TNodeV4Cross>();
@@ -204,6 +269,14 @@ void TExtractor::extractTFacesFromTNodeV4( const TNodeV4Ptr &node, TFacVector &f
 	extractTFacesFromTNodeV4Cross(node_cross, faces);
 }
 
+void TExtractor::extractTFacesFromTNodeV4( const TNodeV4Ptr &node, const TFacVector &candidates, TFacVector &faces, int degree_s /*= 3*/, int degree_t /*= 3*/ )
+{
+	TNodeV4CrossPtr node_cross = makePtr<TNodeV4Cross>();
+	extractCrossFromTNodeV4(node, node_cross, degree_s, degree_t, false);
+	node_cross->prepareRelationships(candidates);
+	node_cross->copyTFaces(faces);
+}
+
 TVertexPtr TExtractor::extractNorthEastTVertexFromTFace( const TFacePtr &face )
 {
 	TLnkLIterator iter;
@@ -106,17 +106,25 @@ public:
 	/** Extract the east T-nodes linked by the T-vertex*/
 	static void extractEastNodesFromTVertex(const TVertexPtr &vertex, TNodVector &nodes);
 
-	/** Extract the T-node cross with the T-node valence 4 at the center*/
-	static void extractCrossFromTNodeV4(const TNodeV4Ptr &node, TNodeV4CrossPtr &node_cross, int degree_s, int degree_t);
+	/** Extract the T-node cross with the T-node valence 4 at the center, the relationships are prepared unless told not to*/
+	static void extractCrossFromTNodeV4(const TNodeV4Ptr &node, TNodeV4CrossPtr &node_cross, int degree_s, int degree_t, bool prepare = true);
 	/** Extract the T-faces covered by the T-node cross*/
 	static void extractTFacesFromTNodeV4Cross(const TNodeV4CrossPtr &node_cross, TFacVector &faces);
 	/** Extract the T-faces from the T-node valence 4*/
 	static void extractTFacesFromTNodeV4(const TNodeV4Ptr &node, TFacVector &faces, int degree_s = 3, int degree_t = 3);
+	/** Extract the T-faces among the candidates from the T-node valence 4*/
+	static void extractTFacesFromTNodeV4(const TNodeV4Ptr &node, const TFacVector &candidates, TFacVector &faces, int degree_s = 3, int degree_t = 3);
 
 	/** Extract the u and v knots from the T-node valence 4*/
 	static void extractUVKnotsFromTNodeV4(const TNodeV4Ptr &node_v4, std::vector<Real> &u_nodes, std::vector<Real> &v_nodes);
+	/** Extract the degree+2 u and v knots from the T-node valence 4, centered on the node for an odd degree and on its north east cell for an even one, return 0 for a degree below 1. */
+	static int extractUVKnotsFromTNodeV4(const TNodeV4Ptr &node_v4, std::vector<Real> &u_nodes, std::vector<Real> &v_nodes, int degree_s, int degree_t);
 	/** Extract the rational point with weight from the T-node valence 4*/
 	static void extractRationalPointFromTNodeV4(const TNodeV4Ptr &node_v4, Point3D &point, Real &weight);
+	/** Extract the box of the T-points of the blending nodes of a T-face, which contains the surface of the T-face for positive weights. */
+	static void extractBoundingBoxFromTFace(const TFacePtr &face, BoundingBox &box);
+	/** Extract the T-faces of the T-image which have blending T-nodes in its order, those outside the region of a partial load (see RhBuilder) have none. */
+	static void extractBlendedTFacesFromTImage(const TImagePtr &image, TFacVector &faces);
 
 	/** Extract the northeast T-vertex from a T-face*/
 	static TVertexPtr extractNorthEastTVertexFromTFace(const TFacePtr &face);
@@ -49,6 +49,8 @@ TFactory::TFactory()
 {
 	_objects = makePtr<TGroup>();
 	_finder = makePtr<TFinder>(_objects);
+	_arena = makePtr<TArena>();
+	_tjunction_conflicts = 0;
 }
 
 TFactory::~TFactory()
@@ -120,6 +122,45 @@ TPointPtr TFactory::createTPoint( const std::string &name, Real x /*= 0.0*/, Rea
 	return obj;
 }
 
+TVertexPtr TFactory::createTVertex( int symbol, Real s, Real t )
+{
+	TVertexPtr obj = createTObject<TVertex>(symbol);
+	obj->setST(s, t);
+	return obj;
+}
+
+TEdgePtr TFactory::createTEdge( int symbol )
+{
+	return createTObject<TEdge>(symbol);
+}
+
+TLinkPtr TFactory::createTLink( int symbol )
+{
+	return createTObject<TLink>(symbol);
+}
+
+TEdgeConditionPtr TFactory::createTEdgeCondition( int symbol )
+{
+	return createTObject<TEdgeCondition>(symbol);
+}
+
+TFacePtr TFactory::createTFace( int symbol )
+{
+	return createTObject<TFace>(symbol);
+}
+
+TNodeV4Ptr TFactory::createTNodeV4( int symbol )
+{
+	return createTObject<TNodeV4>(symbol);
+}
+
+TPointPtr TFactory::createTPoint( int symbol, Real x /*= 0.0*/, Real y /*= 0.0*/, Real z /*= 0.0*/, Real w /*= 1.0*/ )
+{
+	TPointPtr obj = createTObject<TPoint>(symbol);
+	obj->setXYZW(x, y, z, w);
+	return obj;
+}
+
 void TFactory::patchTSpline( const TSplinePtr &spline, const std::string &tmesh, const std::string &nodes, const std::string &points, int degree /*= 3*/ )
 {
 	spline->setTImage(findTObject<TImage>(tmesh));
@@ -303,6 +344,56 @@ void TFactory::patchTPoint( const std::string &point, const std::string &node )
 	patchTPoint(findTObject<TPoint>(point), node);
 }
 
+void TFactory::patchTVertexByVertices( const TVertexPtr &vertex, int north, int west, int south, int east )
+{
+	TLinkPtr link_north = findTLinkByStartEndVertices(vertex, findTObjectBySymbol<TVertex>(north));
+	TLinkPtr link_west = findTLinkByStartEndVertices(vertex, findTObjectBySymbol<TVertex>(west));
+	TLinkPtr link_south = findTLinkByStartEndVertices(vertex, findTObjectBySymbol<TVertex>(south));
+	TLinkPtr link_east = findTLinkByStartEndVertices(vertex, findTObjectBySymbol<TVertex>(east));
+
+	vertex->setNeighbours(link_north, link_west, link_south, link_east);
+}
+
+void TFactory::patchTEdge( const TEdgePtr &edge, int vstart, int vend, int lface, int rface )
+{
+	edge->setStartVertex(findTObjectBySymbol<TVertex>(vstart));
+	edge->setEndVertex(findTObjectBySymbol<TVertex>(vend));
+	edge->setLeftFace(findTObjectBySymbol<TFace>(lface));
+	edge->setRightFace(findTObjectBySymbol<TFace>(rface));
+}
+
+void TFactory::patchTLink( const TLinkPtr &link, int edge, bool orientation /*= true*/ )
+{
+	link->setOrientedEdge(findTObjectBySymbol<TEdge>(edge), orientation);
+}
+
+void TFactory::patchTEdgeCondition( const TEdgeConditionPtr &edge_condition, int edge, bool boundary_condition )
+{
+	edge_condition->setEdgeCondition(findTObjectBySymbol<TEdge>(edge), boundary_condition);
+}
+
+void TFactory::patchTFace( const TFacePtr &face, const std::vector<int> &link_loop )
+{
+	std::vector<int>::const_iterator iter;
+	for (iter = link_loop.begin(); iter != link_loop.end(); iter++)
+	{
+		face->addLink(findTObjectBySymbol<TLink>(*iter));
+	}
+}
+
+void TFactory::patchTNodeV4( const TNodeV4Ptr &node_v4, int mapper, int point, int north, int west, int south, int east )
+{
+	node_v4->setTMappableObject(findTObjectBySymbol<TMappableObject>(mapper));
+	node_v4->setTPoint(findTObjectBySymbol<TPoint>(point));
+	node_v4->setNeighbours(findTObjectBySymbol<TNodeV4>(north), findTObjectBySymbol<TNodeV4>(west), 
+		findTObjectBySymbol<TNodeV4>(south), findTObjectBySymbol<TNodeV4>(east));
+}
+
+void TFactory::patchTPoint( const TPointPtr &point, int node )
+{
+	point->setTNode(findTObjectBySymbol<TNodeV4>(node));
+}
+
 void TFactory::findTObjectNames( std::vector<std::string> &names, TObjType type )
 {
 	_finder->findObjectNamesByType(names, type);
@@ -323,7 +414,7 @@ void TFactory::prepareImageConnect()
 	{
 		TNodeV4Ptr node = *iter;
 		TFacVector faces;
-		TExtractor::extractTFacesFromTNodeV4(node, faces, spline->getSDegree());
+		TExtractor::extractTFacesFromTNodeV4(node, faces, spline->getSDegree(), spline->getTDegree());
 
 		TFacVIterator fiter;
 		for (fiter=faces.begin();fiter!=faces.end();fiter++)
@@ -334,6 +425,27 @@ void TFactory::prepareImageConnect()
 	}
 }
 
+void TFactory::prepareImageConnect( const TFacVector &faces )
+{
+	TSplinePtr spline = findTSpline();
+	TNodV4Vector nodes;
+	_finder->findObjects<TNodeV4>(nodes);
+	TNodV4VIterator iter;
+	for (iter=nodes.begin();iter!=nodes.end();iter++)
+	{
+		TNodeV4Ptr node = *iter;
+		TFacVector covered;
+		TExtractor::extractTFacesFromTNodeV4(node, faces, covered, spline->getSDegree(), spline->getTDegree());
+
+		TFacVIterator fiter;
+		for (fiter=covered.begin();fiter!=covered.end();fiter++)
+		{
+			TFacePtr face = *fiter;
+			if (face) face->addBlendingNode(node);
+		}
+	}
+}
+
 TLinkPtr TFactory::findTLinkByStartEndVertices( const TVertexPtr &start, const TVertexPtr &end )
 {
 	TLnkVector links;
@@ -352,18 +464,103 @@ TLinkPtr TFactory::findTLinkByStartEndVertices( const TVertexPtr &start, const T
 	}
 }
 
-void TFactory::prepareTJunctions()
+int TFactory::prepareTJunctions()
 {
 	TVtxVector vertices;
 	_finder->findObjects<TVertex>(vertices);
-	std::for_each(vertices.begin(), vertices.end(), TVertexVisitorCheckTJunctions());
+	int nvertices = vertices.size();
+
+	// Phase one: derive the extensions of all T-junctions, nothing is modified here.
+	TJncVector junctions(nvertices);
+	TJncExtVector extensions(nvertices);
+	std::vector<char> derived(nvertices, 0);
+#ifdef USE_OMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+	for (int i=0;i<nvertices;i++)
+	{
+		TVertexPtr vertex = vertices[i];
+		if (vertex->numberOfNeighbors() == 3)
+		{
+			junctions[i] = makePtr<TJunction>(vertex, _arena);
+			derived[i] = junctions[i]->deriveExtension(extensions[i]);
+		}
+	}
+
+	TJncExtVector committing;
+	for (int i=0;i<nvertices;i++)
+	{
+		if (derived[i]) committing.push_back(extensions[i]);
+	}
+	int conflicts = checkTJunctionConflicts(committing);
+	_tjunction_conflicts = conflicts;
+
+	// Phase two: commit the extensions in the order of the T-vertices.
+	for (int i=0;i<nvertices;i++)
+	{
+		if (derived[i]) junctions[i]->patchVirtuals(extensions[i]);
+	}
+	return conflicts;
+}
+
+int TFactory::checkTJunctionConflicts( const TJncExtVector &extensions )
+{
+	std::map<TFacePtr, TJncExtVector> face_extensions;
+	TJncExtVector::const_iterator iter;
+	for (iter=extensions.begin();iter!=extensions.end();iter++)
+	{
+		if (iter->face) face_extensions[iter->face].push_back(*iter);
+	}
+
+	int conflicts = 0;
+	std::map<TFacePtr, TJncExtVector>::iterator fiter;
+	for (fiter=face_extensions.begin();fiter!=face_extensions.end();fiter++)
+	{
+		// Every pair of extensions splitting the face, the lines are not transitive under isEqual.
+		TJncExtVector &exts = fiter->second;
+		for (size_t i=0;i<exts.size();i++)
+		{
+			for (size_t j=i+1;j<exts.size();j++)
+			{
+				const TJunctionExtension &first = exts[i];
+				const TJunctionExtension &other = exts[j];
+				bool first_vertical = (first.orientation == E_NORTH || first.orientation == E_SOUTH);
+				bool other_vertical = (other.orientation == E_NORTH || other.orientation == E_SOUTH);
+				// Two extensions meeting on the same line from opposite sides are consistent.
+				if (first_vertical != other_vertical || 
+					(first_vertical && !isEqual(first.parameter.s(), other.parameter.s())) ||
+					(!first_vertical && !isEqual(first.parameter.t(), other.parameter.t())))
+				{
+					conflicts++;
+				}
+			}
+		}
+	}
+	return conflicts;
 }
 
 void TFactory::prepareTNodeHalfLinkages()
 {
 	TVtxVector vertices;
 	_finder->findObjects<TVertex>(vertices);
-	std::for_each(vertices.begin(), vertices.end(), TVertexVisitorCheckTNodes());
+	int nvertices = vertices.size();
+
+	// Phase one: derive the common neighbors of all T-vertices' nodes.
+	TNodHlkVector linkages(nvertices);
+	TVertexVisitorCheckTNodes visitor;
+#ifdef USE_OMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+	for (int i=0;i<nvertices;i++)
+	{
+		visitor.derive(vertices[i], linkages[i]);
+	}
+
+	// Phase two: commit them in the order of the T-vertices.
+	for (int i=0;i<nvertices;i++)
+	{
+		visitor.commit(linkages[i]);
+	}
 }
 
 TGroupPtr TFactory::findTGroup()
@@ -51,6 +51,9 @@ Revision_history:
 #include <utils.h>
 #include <tspline.h>
 #include <finder.h>
+#include <tjunction.h>
+#include <arena.h>
+#include <symbol.h>
 
 #ifdef use_namespace
 namespace TSPLINE {
@@ -65,6 +68,7 @@ namespace TSPLINE {
   * The create functions are used to pre-allocate the memory for the wanted T-objects.
   * The patch functions are used to patch the parameters in the created T-objects.
   * The prepare functions are used to derive the missed optional attributes.
+  * All the T-objects of a factory, including the virtual ones, are allocated in one arena.
 */
 
 DECLARE_SMARTPTR(TFactory);
@@ -99,6 +103,21 @@ public:
 	/** Create a T-point object with a coordinate (x, y, z, w)*/
 	TPointPtr createTPoint(const std::string &name, Real x = 0.0, Real y = 0.0, Real z = 0.0, Real w = 1.0);
 
+	/** Create a T-vertex object named by a symbol with a coordinate (s, t)*/
+	TVertexPtr createTVertex(int symbol, Real s, Real t);
+	/** Create a T-edge object named by a symbol*/
+	TEdgePtr createTEdge(int symbol);
+	/** Create a T-link object named by a symbol*/
+	TLinkPtr createTLink(int symbol);
+	/** Create a T-edgecondition object named by a symbol*/
+	TEdgeConditionPtr createTEdgeCondition(int symbol);
+	/** Create a T-face object named by a symbol*/
+	TFacePtr createTFace(int symbol);
+	/** Create a T-node valence 4 object named by a symbol*/
+	TNodeV4Ptr createTNodeV4(int symbol);
+	/** Create a T-point object named by a symbol with a coordinate (x, y, z, w)*/
+	TPointPtr createTPoint(int symbol, Real x = 0.0, Real y = 0.0, Real z = 0.0, Real w = 1.0);
+
 	/** Patch the T-spline with needed attributes*/
 	void patchTSpline(const TSplinePtr &spline, const std::string &tmesh, const std::string &nodes, const std::string &points, int degree = 3);
 	/** Patch the named T-spline with needed attributes*/
@@ -163,12 +182,29 @@ public:
 	/** Patch the named T-vertex with needed attributes by T-vertex neighbors*/
 	void patchTVertexByVertices(const std::string &vertex, const std::string &north, const std::string &west, const std::string &south, const std::string &east);
 
+	/** Patch the T-vertex by the symbols of T-vertex neighbors*/
+	void patchTVertexByVertices(const TVertexPtr &vertex, int north, int west, int south, int east);
+	/** Patch the T-edge by the symbols of its T-vertices and T-faces*/
+	void patchTEdge(const TEdgePtr &edge, int vstart, int vend, int lface, int rface);
+	/** Patch the T-link by the symbol of its T-edge*/
+	void patchTLink(const TLinkPtr &link, int edge, bool orientation = true);
+	/** Patch the T-edgecondition by the symbol of its T-edge*/
+	void patchTEdgeCondition(const TEdgeConditionPtr &edge_condition, int edge, bool boundary_condition);
+	/** Patch the T-face by the symbols of its T-links*/
+	void patchTFace(const TFacePtr &face, const std::vector<int> &link_loop);
+	/** Patch the T-node valence 4 by the symbols of its mapper, T-point and T-node neighbors*/
+	void patchTNodeV4(const TNodeV4Ptr &node_v4, int mapper, int point, int north, int west, int south, int east);
+	/** Patch the T-point by the symbol of its T-node*/
+	void patchTPoint(const TPointPtr &point, int node);
+
 	/** Prepare all the T-nodes' half linkages*/
 	void prepareTNodeHalfLinkages();
-	/** Prepare all T-junctions*/
-	void prepareTJunctions();
+	/** Prepare all T-junctions, return the number of conflicting pairs of extensions*/
+	int prepareTJunctions();
 	/** Prepare all T-image connects*/
 	void prepareImageConnect();
+	/** Prepare the T-image connects of the T-faces only, the other T-faces get no blending T-nodes*/
+	void prepareImageConnect(const TFacVector &faces);
 
 	/** Find the names of T-objects of the specified type*/
 	void findTObjectNames(std::vector<std::string> &names, TObjType type);
@@ -176,13 +212,27 @@ public:
 	TSplinePtr findTSpline();
 	/** Find the T-group*/
 	TGroupPtr findTGroup();
+	/** Return the number of conflicting pairs of extensions found by prepareTJunctions*/
+	int getTJunctionConflicts() const {return _tjunction_conflicts;}
 protected:
 	template<class T>
 	std::shared_ptr<T> createTObject(const std::string &name)
 	{
-		std::shared_ptr<T> obj = makePtr<T>(name);
+		std::shared_ptr<T> obj = makeArenaPtr<T>(_arena, name);
+		_objects->addObject(obj);
+		obj->setCollector(_objects);
+		_symbols.insert(std::make_pair(obj->getSymbol(), obj));
+		return obj;
+	}
+
+	template<class T>
+	std::shared_ptr<T> createTObject(int symbol)
+	{
+		std::shared_ptr<T> obj = makeArenaPtr<T>(_arena);
+		obj->setSymbol(symbol);
 		_objects->addObject(obj);
 		obj->setCollector(_objects);
+		_symbols.insert(std::make_pair(symbol, obj));
 		return obj;
 	}
 
@@ -190,10 +240,18 @@ public:
 	template<class T>
 	std::shared_ptr<T> findTObject(const std::string& name)
 	{
-		TObjectPtr object = _finder->findObjectByName(name);
-		if (object)
+		int symbol = TSymbolTable::Instance()->find(name);
+		if (symbol == E_NOSYMBOL && !name.empty()) return 0;
+		return findTObjectBySymbol<T>(symbol);
+	}
+
+	template<class T>
+	std::shared_ptr<T> findTObjectBySymbol(int symbol)
+	{
+		std::unordered_map<int, TObjectPtr>::iterator iter = _symbols.find(symbol);
+		if (iter != _symbols.end())
 		{
-			return castPtr<T>(object);
+			return castPtr<T>(iter->second);
 		}
 		return 0;
 	}
@@ -210,9 +268,15 @@ public:
 	}
 
 	TLinkPtr findTLinkByStartEndVertices(const TVertexPtr &start, const TVertexPtr &end);
+protected:
+	/** Check the T-junction extensions which split the same T-face along different lines, return the number of conflicting pairs*/
+	int checkTJunctionConflicts(const TJncExtVector &extensions);
 private:
 	TGroupPtr _objects;
 	TFinderPtr _finder;
+	TArenaPtr _arena;
+	std::unordered_map<int, TObjectPtr> _symbols;
+	int _tjunction_conflicts;
 	static std::vector<std::string> _empty_nodes;
 };
 
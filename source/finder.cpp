@@ -58,16 +58,17 @@ bool IdFinder::operator()( TObjectPtr object )
 	}
 }
 
-NameFinder::NameFinder( const string &name ) : _name(name)
+NameFinder::NameFinder( const string &name ) : 
+	_symbol(TSymbolTable::Instance()->find(name)), _interned(name.empty() || _symbol != E_NOSYMBOL)
 {
 
 }
 
 bool NameFinder::operator()( TObjectPtr object )
 {
-	if (object)
+	if (object && _interned)
 	{
-		return object->getName() == _name;
+		return object->getSymbol() == _symbol;
 	}
 	else
 	{
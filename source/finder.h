@@ -82,7 +82,8 @@ struct NameFinder
 	NameFinder(const string &name);
 	bool operator() (TObjectPtr object);
 private:
-	std::string _name;
+	int _symbol;
+	bool _interned;
 };
 
 /**  
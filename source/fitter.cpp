@@ -0,0 +1,389 @@
+/*
+TSPLINE -- A T-spline object oriented package in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 3.0 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building,
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+   - Created.
+-------------------------------------------------------------------------------
+*/
+
+#include <fitter.h>
+#include <projector.h>
+#include <algorithm>
+
+#ifdef use_namespace
+namespace TSPLINE {
+	using namespace NEWMAT;
+#endif
+
+/** The number of points projected at a time, so that the projections of a large cloud are not all kept. */
+static const int PROJECTION_BLOCK = 65536;
+
+static Real dot(const std::vector<Real> &a, const std::vector<Real> &b)
+{
+	Real sum = 0.0;
+	for (int i=0;i<(int)a.size();i++) sum += a[i] * b[i];
+	return sum;
+}
+
+TFitter::TFitter( const TSplinePtr &spline ) :
+	_spline(spline),
+	_basis(spline),
+	_smoothing(1e-6),
+	_tolerance(1e-10),
+	_max_iterations(1000),
+	_iterations(0),
+	_residual_before(0.0),
+	_residual(0.0)
+{
+	// The columns of each row are the T-points sharing a cell with it.
+	int n = _basis.sizeFunctions();
+	std::vector<std::vector<int> > coupled(n);
+	_cells.resize(_basis.sizeFaces()+1, 0);
+	for (int f=0;f<_basis.sizeFaces();f++)
+	{
+		_cells[f+1] = _cells[f] + _basis.sizeCells(f);
+		for (int c=0;c<_basis.sizeCells(f);c++)
+		{
+			const std::vector<int> &indices = _basis.getIndices(f, c);
+			for (int i=0;i<(int)indices.size();i++)
+			{
+				if (indices[i] < 0) continue;
+				for (int j=0;j<(int)indices.size();j++)
+				{
+					if (indices[j] >= 0) coupled[indices[i]].push_back(indices[j]);
+				}
+			}
+		}
+	}
+	_rows.resize(n+1, 0);
+	for (int i=0;i<n;i++)
+	{
+		// A T-point without a cell still has its diagonal.
+		coupled[i].push_back(i);
+		std::sort(coupled[i].begin(), coupled[i].end());
+		coupled[i].erase(std::unique(coupled[i].begin(), coupled[i].end()), coupled[i].end());
+		_rows[i+1] = _rows[i] + (int)coupled[i].size();
+		_columns.insert(_columns.end(), coupled[i].begin(), coupled[i].end());
+	}
+	_values.resize(_columns.size(), 0.0);
+
+	_positions.resize(_cells.back());
+	for (int f=0;f<_basis.sizeFaces();f++)
+	{
+		for (int c=0;c<_basis.sizeCells(f);c++)
+		{
+			const std::vector<int> &indices = _basis.getIndices(f, c);
+			int m = (int)indices.size();
+			std::vector<int> &positions = _positions[_cells[f]+c];
+			positions.assign(m*m, -1);
+			for (int i=0;i<m;i++)
+			{
+				if (indices[i] < 0) continue;
+				for (int j=0;j<m;j++)
+				{
+					if (indices[j] < 0) continue;
+					positions[i*m+j] = (int)(std::lower_bound(_columns.begin()+_rows[indices[i]], 
+						_columns.begin()+_rows[indices[i]+1], indices[j]) - _columns.begin());
+				}
+			}
+		}
+	}
+}
+
+TFitter::~TFitter()
+{
+
+}
+
+int TFitter::fit( const std::vector<Point3D> &points, TSplineEditor &editor )
+{
+	TProjector projector(_spline);
+	int n = (int)points.size();
+	std::vector<int> faces(n, -1);
+	std::vector<Parameter> parameters(n);
+	std::vector<Point3D> block;
+	std::vector<TProjection> projections;
+	for (int first=0;first<n;first+=PROJECTION_BLOCK)
+	{
+		int last = min(first + PROJECTION_BLOCK, n);
+		block.assign(points.begin()+first, points.begin()+last);
+		projector.project(block, projections);
+		for (int i=first;i<last;i++)
+		{
+			const TProjection &projection = projections[i-first];
+			if (!projection.face) continue;
+			faces[i] = _basis.findIndex(projection.face);
+			parameters[i] = projection.parameter;
+		}
+	}
+	return fitSamples(points, faces, parameters, editor);
+}
+
+int TFitter::fit( const std::vector<Point3D> &points, const TFacVector &faces, const std::vector<Parameter> &parameters, TSplineEditor &editor )
+{
+	int n = (int)min(points.size(), min(faces.size(), parameters.size()));
+	std::vector<int> indices(n);
+	for (int i=0;i<n;i++) indices[i] = _basis.findIndex(faces[i]);
+	return fitSamples(points, indices, parameters, editor);
+}
+
+void TFitter::sortSamples( const std::vector<int> &faces, std::vector<int> &offsets, std::vector<int> &order ) const
+{
+	int nfaces = _basis.sizeFaces();
+	offsets.assign(nfaces+1, 0);
+	for (int i=0;i<(int)faces.size();i++)
+	{
+		if (faces[i] >= 0) offsets[faces[i]+1]++;
+	}
+	for (int f=0;f<nfaces;f++) offsets[f+1] += offsets[f];
+	order.resize(offsets[nfaces]);
+	std::vector<int> next(offsets.begin(), offsets.end()-1);
+	for (int i=0;i<(int)faces.size();i++)
+	{
+		if (faces[i] >= 0) order[next[faces[i]]++] = i;
+	}
+}
+
+int TFitter::fitSamples( const std::vector<Point3D> &points, const std::vector<int> &faces, const std::vector<Parameter> &parameters, TSplineEditor &editor )
+{
+	int n = _basis.sizeFunctions(), nfaces = _basis.sizeFaces();
+	std::vector<int> offsets, order;
+	sortSamples(faces, offsets, order);
+	int nsamples = (int)order.size();
+	if (nsamples == 0 || n == 0) return 0;
+
+	std::vector<Real> control(3*n);
+	for (int i=0;i<n;i++)
+	{
+		TPointPtr point = _basis.getPoint(i);
+		control[3*i] = point->getX(); control[3*i+1] = point->getY(); control[3*i+2] = point->getZ();
+	}
+	_residual_before = computeResidual(points, parameters, offsets, order, control);
+
+	// The cell matrices and right-hand sides, each T-face only touches its own cells.
+	std::vector<std::vector<Real> > matrices(_cells.back()), sides(_cells.back());
+#ifdef USE_OMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+	for (int f=0;f<nfaces;f++)
+	{
+		for (int c=0;c<_basis.sizeCells(f);c++)
+		{
+			int m = (int)_basis.getIndices(f, c).size();
+			matrices[_cells[f]+c].assign(m*m, 0.0);
+			sides[_cells[f]+c].assign(3*m, 0.0);
+		}
+		std::vector<Real> values;
+		for (int k=offsets[f];k<offsets[f+1];k++)
+		{
+			int sample = order[k];
+			int c = _basis.findCell(f, parameters[sample]);
+			if (c < 0) continue;
+			const std::vector<int> &indices = _basis.getIndices(f, c);
+			const TPntVector &tpoints = _basis.getTPoints(f, c);
+			int m = (int)indices.size();
+			values.resize(m);
+			_basis.evaluateAt(f, c, parameters[sample], 0, &values[0]);
+			Real *matrix = &matrices[_cells[f]+c][0], *side = &sides[_cells[f]+c][0];
+			// The T-points outside the T-pointset stay where they are, their part of the surface is taken off the sample.
+			Real x = points[sample].x(), y = points[sample].y(), z = points[sample].z();
+			for (int i=0;i<m;i++)
+			{
+				if (indices[i] >= 0) continue;
+				x -= values[i] * tpoints[i]->getX();
+				y -= values[i] * tpoints[i]->getY();
+				z -= values[i] * tpoints[i]->getZ();
+			}
+			for (int i=0;i<m;i++)
+			{
+				Real vi = values[i];
+				if (vi == 0.0) continue;
+				for (int j=0;j<m;j++) matrix[i*m+j] += vi * values[j];
+				side[3*i] += vi * x;
+				side[3*i+1] += vi * y;
+				side[3*i+2] += vi * z;
+			}
+		}
+	}
+
+	std::fill(_values.begin(), _values.end(), 0.0);
+	std::vector<Real> rhs(3*n, 0.0);
+	for (int f=0;f<nfaces;f++)
+	{
+		for (int c=0;c<_basis.sizeCells(f);c++)
+		{
+			int cell = _cells[f] + c;
+			const std::vector<int> &indices = _basis.getIndices(f, c);
+			int m = (int)indices.size();
+			for (int i=0;i<m;i++)
+			{
+				if (indices[i] < 0) continue;
+				for (int j=0;j<m;j++)
+				{
+					if (_positions[cell][i*m+j] >= 0) _values[_positions[cell][i*m+j]] += matrices[cell][i*m+j];
+				}
+				for (int d=0;d<3;d++) rhs[3*indices[i]+d] += sides[cell][3*i+d];
+			}
+		}
+	}
+	matrices.clear(); sides.clear();
+
+	// Pull every control point towards its current position by a fraction of the mean diagonal.
+	Real trace = 0.0;
+	for (int i=0;i<n;i++) trace += _values[std::lower_bound(_columns.begin()+_rows[i], _columns.begin()+_rows[i+1], i) - _columns.begin()];
+	Real pull = _smoothing * trace / n;
+	for (int i=0;i<n;i++)
+	{
+		_values[std::lower_bound(_columns.begin()+_rows[i], _columns.begin()+_rows[i+1], i) - _columns.begin()] += pull;
+		for (int d=0;d<3;d++) rhs[3*i+d] += pull * control[3*i+d];
+	}
+
+	_iterations = 0;
+	std::vector<Real> b(n), x(n);
+	for (int d=0;d<3;d++)
+	{
+		for (int i=0;i<n;i++)
+		{
+			b[i] = rhs[3*i+d];
+			x[i] = control[3*i+d];
+		}
+		_iterations = max(_iterations, solve(b, x));
+		for (int i=0;i<n;i++) control[3*i+d] = x[i];
+	}
+
+	for (int i=0;i<n;i++)
+	{
+		editor.movePointTo(_basis.getPoint(i), control[3*i], control[3*i+1], control[3*i+2]);
+	}
+	_residual = computeResidual(points, parameters, offsets, order, control);
+	return nsamples;
+}
+
+Real TFitter::computeResidual( const std::vector<Point3D> &points, const std::vector<Parameter> &parameters, 
+	const std::vector<int> &offsets, const std::vector<int> &order, const std::vector<Real> &control ) const
+{
+	int nfaces = _basis.sizeFaces();
+	std::vector<Real> sums(nfaces, 0.0);
+#ifdef USE_OMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+	for (int f=0;f<nfaces;f++)
+	{
+		std::vector<Real> values;
+		for (int k=offsets[f];k<offsets[f+1];k++)
+		{
+			int sample = order[k];
+			int c = _basis.findCell(f, parameters[sample]);
+			if (c < 0) continue;
+			const std::vector<int> &indices = _basis.getIndices(f, c);
+			const TPntVector &tpoints = _basis.getTPoints(f, c);
+			int m = (int)indices.size();
+			values.resize(m);
+			_basis.evaluateAt(f, c, parameters[sample], 0, &values[0]);
+			Real x = -points[sample].x(), y = -points[sample].y(), z = -points[sample].z();
+			for (int i=0;i<m;i++)
+			{
+				if (indices[i] < 0)
+				{
+					x += values[i] * tpoints[i]->getX();
+					y += values[i] * tpoints[i]->getY();
+					z += values[i] * tpoints[i]->getZ();
+					continue;
+				}
+				x += values[i] * control[3*indices[i]];
+				y += values[i] * control[3*indices[i]+1];
+				z += values[i] * control[3*indices[i]+2];
+			}
+			sums[f] += x*x + y*y + z*z;
+		}
+	}
+	Real sum = 0.0;
+	for (int f=0;f<nfaces;f++) sum += sums[f];
+	return order.empty() ? 0.0 : sqrt(sum / order.size());
+}
+
+void TFitter::multiply( const std::vector<Real> &x, std::vector<Real> &y ) const
+{
+	int n = (int)_rows.size() - 1;
+	y.resize(n);
+#ifdef USE_OMP
+#pragma omp parallel for schedule(static)
+#endif
+	for (int i=0;i<n;i++)
+	{
+		Real sum = 0.0;
+		for (int k=_rows[i];k<_rows[i+1];k++) sum += _values[k] * x[_columns[k]];
+		y[i] = sum;
+	}
+}
+
+int TFitter::solve( const std::vector<Real> &b, std::vector<Real> &x ) const
+{
+	int n = (int)b.size();
+	std::vector<Real> inverse(n), r(n), z(n), p(n), q(n);
+	for (int i=0;i<n;i++)
+	{
+		Real diagonal = _values[std::lower_bound(_columns.begin()+_rows[i], _columns.begin()+_rows[i+1], i) - _columns.begin()];
+		inverse[i] = diagonal > 0.0 ? 1.0 / diagonal : 0.0;
+	}
+	multiply(x, q);
+	for (int i=0;i<n;i++)
+	{
+		r[i] = b[i] - q[i];
+		z[i] = inverse[i] * r[i];
+	}
+	p = z;
+	// The dot products are summed in order, so that the result does not depend on the number of threads.
+	Real rz = dot(r, z), limit = _tolerance * _tolerance * dot(b, b);
+	int iteration = 0;
+	for (;iteration<_max_iterations && dot(r, r) > limit;iteration++)
+	{
+		multiply(p, q);
+		// Not safeDivide, the products scale with the squared coordinates and may well be below M_EPS.
+		Real pq = dot(p, q);
+		if (pq <= 0.0 || rz <= 0.0) break;
+		Real alpha = rz / pq;
+		for (int i=0;i<n;i++)
+		{
+			x[i] += alpha * p[i];
+			r[i] -= alpha * q[i];
+			z[i] = inverse[i] * r[i];
+		}
+		Real next = dot(r, z), beta = next / rz;
+		rz = next;
+		for (int i=0;i<n;i++) p[i] = z[i] + beta * p[i];
+	}
+	return iteration;
+}
+
+#ifdef use_namespace
+}
+#endif
@@ -0,0 +1,135 @@
+/*
+T-SPLINE -- A T-spline object oriented library in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 2.1 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building,
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+- Created.
+-------------------------------------------------------------------------------
+*/
+
+/**  @file  [fitter]
+  *  @brief  Least-squares fitting of a T-spline to a point cloud.
+  *  @author  <agent>
+  *  @date  <2026.10.19>
+  *  @version  <v1.0>
+  *  @note
+  *  This file contains the fitter which moves the control points of a T-spline, keeping its T-mesh and weights,
+  *  so that the surface fits a cloud of sampled points in the least-squares sense.
+*/
+
+#ifndef FITTER_H
+#define FITTER_H
+
+#include <utils.h>
+#include <tspline.h>
+#include <editor.h>
+#include <quadrature.h>
+
+#ifdef use_namespace
+namespace TSPLINE {
+	using namespace NEWMAT;
+#endif
+
+DECLARE_SMARTPTR(TFitter);
+
+/**
+  *  @class  <TFitter>
+  *  @brief  T-spline least-squares fitter
+  *  @note
+  *  With the T-mesh and the weights kept, the surface is linear in the control points through the rational basis of
+  *  TQuadratureBasis, so the control points minimizing the sum of the squared distances to the samples solve the normal
+  *  equations A P = B, A being the sum of N N' over the samples. The sparsity of A is known from the knot cells: two
+  *  T-points are coupled only if their basis functions share a cell, so the pattern is built once in compressed rows, the
+  *  samples are accumulated into dense cell matrices on all the threads, T-face by T-face, and the cells are added into A
+  *  in a fixed order. A small multiple of the mean diagonal pulls every control point towards its current position, which
+  *  keeps A positive definite where the samples do not determine the control points. The T-points blending on a T-face but
+  *  outside the T-pointset can not be moved, their part of the surface is subtracted from the samples. The three coordinates are solved by
+  *  conjugate gradients preconditioned by the diagonal, starting from the current control points, and the results are
+  *  written back by TSplineEditor::movePointTo, so that the editor knows the dirty T-faces. The samples are parametrized by
+  *  their projections onto the current surface (see TProjector) unless their T-faces and parameters are given.
+*/
+class TFitter
+{
+public:
+	TFitter(const TSplinePtr &spline);
+	~TFitter();
+public:
+	/** Set the weight pulling the control points towards their current positions relative to the mean diagonal, 1e-6 by default. */
+	void setSmoothing(Real smoothing) {_smoothing = smoothing;}
+	/** Set the tolerance of the conjugate gradients relative to the right-hand side, 1e-10 by default. */
+	void setTolerance(Real tolerance) {_tolerance = tolerance;}
+	/** Set the maximum number of iterations of the conjugate gradients. */
+	void setMaxIterations(int iterations) {_max_iterations = iterations;}
+	/** Return the number of control points. */
+	int sizePoints() const {return _basis.sizeFunctions();}
+	/** Return the number of nonzeros of the normal equations. */
+	int sizeNonzeros() const {return (int)_columns.size();}
+	/** Return the most iterations of the conjugate gradients among the coordinates of the last fit. */
+	int getIterations() const {return _iterations;}
+	/** Return the root mean square distance of the samples from their parameters before the last fit. */
+	Real getResidualBefore() const {return _residual_before;}
+	/** Return the root mean square distance of the samples from their parameters after the last fit. */
+	Real getResidual() const {return _residual;}
+public:
+	/** Fit the T-spline to the points parametrized by their projections, return the number of samples used. */
+	int fit(const std::vector<Point3D> &points, TSplineEditor &editor);
+	/** Fit the T-spline to the points at the parameters of the T-faces, return the number of samples used. */
+	int fit(const std::vector<Point3D> &points, const TFacVector &faces, const std::vector<Parameter> &parameters, TSplineEditor &editor);
+protected:
+	/** Fit to the samples given by the indices of their T-faces (-1 to skip a sample) and their parameters. */
+	int fitSamples(const std::vector<Point3D> &points, const std::vector<int> &faces, const std::vector<Parameter> &parameters, TSplineEditor &editor);
+	/** Sort the samples by T-face into the order, the samples of T-face i from offsets[i] to offsets[i+1]. */
+	void sortSamples(const std::vector<int> &faces, std::vector<int> &offsets, std::vector<int> &order) const;
+	/** Compute the root mean square distance of the samples from the surface of the control points at their parameters. */
+	Real computeResidual(const std::vector<Point3D> &points, const std::vector<Parameter> &parameters, 
+		const std::vector<int> &offsets, const std::vector<int> &order, const std::vector<Real> &control) const;
+	void multiply(const std::vector<Real> &x, std::vector<Real> &y) const;
+	/** Solve A x = b by the conjugate gradients from x, return the number of iterations. */
+	int solve(const std::vector<Real> &b, std::vector<Real> &x) const;
+private:
+	TSplinePtr _spline;
+	TQuadratureBasis _basis;
+	Real _smoothing;
+	Real _tolerance;
+	int _max_iterations;
+	int _iterations;
+	Real _residual_before, _residual;
+	std::vector<int> _rows;		/** The offsets of the rows of A in the columns. */
+	std::vector<int> _columns;	/** The sorted columns of each row of A. */
+	std::vector<Real> _values;	/** The entries of A. */
+	std::vector<int> _cells;	/** The index of the first cell of each T-face. */
+	std::vector<std::vector<int> > _positions;	/** The positions in the entries of A of the cell matrix of each cell. */
+};
+
+#ifdef use_namespace
+}
+#endif
+
+#endif
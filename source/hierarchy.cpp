@@ -0,0 +1,116 @@
+/*
+T-SPLINE -- A T-spline object oriented library in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 2.1 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building,
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+   - Created.
+-------------------------------------------------------------------------------
+*/
+
+#include <hierarchy.h>
+#include <extractor.h>
+#include <algorithm>
+
+#ifdef use_namespace
+namespace TSPLINE {
+	using namespace NEWMAT;
+#endif
+
+TFaceHierarchy::TFaceHierarchy( const TSplinePtr &spline, int leaf_size /*= 4*/ ) :
+	_hierarchy(leaf_size)
+{
+	TExtractor::extractBlendedTFacesFromTImage(spline->getTImage(), _faces);
+	std::vector<BoundingBox> boxes(_faces.size());
+	for (int i=0;i<(int)_faces.size();i++)
+	{
+		TExtractor::extractBoundingBoxFromTFace(_faces[i], boxes[i]);
+		_indices[_faces[i]] = i;
+	}
+	_hierarchy.build(boxes);
+}
+
+TFaceHierarchy::~TFaceHierarchy()
+{
+
+}
+
+int TFaceHierarchy::findIndex( const TFacePtr &face ) const
+{
+	std::map<TFacePtr, int>::const_iterator iter = _indices.find(face);
+	return iter == _indices.end() ? -1 : iter->second;
+}
+
+void TFaceHierarchy::refitFaces( const TFacVector &dirty_faces )
+{
+	std::vector<int> indices;
+	std::vector<BoundingBox> boxes;
+	for (TFacVConstIterator iter = dirty_faces.begin(); iter != dirty_faces.end(); iter++)
+	{
+		int index = findIndex(*iter);
+		if (index < 0) continue;
+		indices.push_back(index);
+		boxes.push_back(BoundingBox());
+		TExtractor::extractBoundingBoxFromTFace(*iter, boxes.back());
+	}
+	if (indices.size() == 1)
+	{
+		_hierarchy.refit(indices[0], boxes[0]);
+	}
+	else if (!indices.empty())
+	{
+		_hierarchy.refit(indices, boxes);
+	}
+}
+
+void TFaceHierarchy::findFaces( const BoundingBox &box, TFacVector &faces ) const
+{
+	faces.clear();
+	std::vector<int> found;
+	auto visitor = [&](int index) { found.push_back(index); };
+	_hierarchy.visitOverlapping(box, visitor);
+	// Report the T-faces in the order of the T-image, whatever the shape of the tree.
+	std::sort(found.begin(), found.end());
+	for (int i=0;i<(int)found.size();i++) faces.push_back(_faces[found[i]]);
+}
+
+void TFaceHierarchy::findFaces( const Point3D &origin, const Vector3D &direction, TFacVector &faces ) const
+{
+	faces.clear();
+	Point3D inverse(1.0 / direction.i(), 1.0 / direction.j(), 1.0 / direction.k());
+	std::vector<std::pair<Real, int> > found;
+	auto visitor = [&](int index, Real entry, Real, Real t_far) -> Real { found.push_back(std::make_pair(entry, index)); return t_far; };
+	_hierarchy.visitRay(origin, inverse, 0.0, std::numeric_limits<Real>::max(), visitor);
+	std::sort(found.begin(), found.end());
+	for (int i=0;i<(int)found.size();i++) faces.push_back(_faces[found[i].second]);
+}
+
+#ifdef use_namespace
+}
+#endif
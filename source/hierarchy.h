@@ -0,0 +1,108 @@
+/*
+T-SPLINE -- A T-spline object oriented library in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 2.1 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building,
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+- Created.
+-------------------------------------------------------------------------------
+*/
+
+/**  @file  [hierarchy]
+  *  @brief  Spatial culling of the T-faces.
+  *  @author  <agent>
+  *  @date  <2026.10.19>
+  *  @version  <v1.0>
+  *  @note
+  *  This file contains a bounding volume hierarchy over the control hulls of the T-faces of a T-spline,
+  *  which is refitted as the T-points are edited.
+*/
+
+#ifndef HIERARCHY_H
+#define HIERARCHY_H
+
+#include <utils.h>
+#include <tspline.h>
+#include <bvh.h>
+
+#ifdef use_namespace
+namespace TSPLINE {
+	using namespace NEWMAT;
+#endif
+
+DECLARE_SMARTPTR(TFaceHierarchy);
+
+/**
+  *  @class  <TFaceHierarchy>
+  *  @brief  T-face hierarchy
+  *  @note
+  *  Each T-face is bounded by the box of its blending T-points (see TExtractor::extractBoundingBoxFromTFace),
+  *  the T-faces without any, outside the region of a partial load, are left out. The box is conservative for
+  *  positive weights and needs no evaluation of the surface. The boxes are put into a SAH-built BoundingVolumeHierarchy. When T-points are moved by a TSplineEditor, refitFaces takes the dirty
+  *  T-faces and refits their boxes and the nodes above them without rebuilding the tree; the same dirty T-faces
+  *  may be passed on to TTessellator::invalidateFaces and TSnapshotPublisher::publish. If the T-faces themselves
+  *  change, e.g. a T-node is removed, the hierarchy must be built again. The queries are const and may run on
+  *  many threads at the same time, but not during a refit.
+*/
+class TFaceHierarchy
+{
+public:
+	TFaceHierarchy(const TSplinePtr &spline, int leaf_size = 4);
+	~TFaceHierarchy();
+public:
+	/** Return the number of T-faces. */
+	int sizeFaces() const {return (int)_faces.size();}
+	/** Get the indexed T-face. */
+	const TFacePtr &getFace(int index) const {return _faces[index];}
+	/** Find the index of the T-face, return -1 if it is not in the hierarchy. */
+	int findIndex(const TFacePtr &face) const;
+	/** Get the box of the indexed T-face. */
+	const BoundingBox &getBox(int index) const {return _hierarchy.getBox(index);}
+	/** Get the box of the whole T-spline. */
+	BoundingBox getBox() const {return _hierarchy.getBox();}
+	/** Get the bounding volume hierarchy, whose primitives are indexed as the T-faces. */
+	const BoundingVolumeHierarchy &getHierarchy() const {return _hierarchy;}
+public:
+	/** Bound the dirty T-faces again and refit the hierarchy, see TSplineEditor::takeDirtyFaces. */
+	void refitFaces(const TFacVector &dirty_faces);
+	/** Find the T-faces whose boxes overlap the box. */
+	void findFaces(const BoundingBox &box, TFacVector &faces) const;
+	/** Find the T-faces whose boxes are hit by the ray origin + t * direction (t >= 0), sorted by where the ray enters the boxes. */
+	void findFaces(const Point3D &origin, const Vector3D &direction, TFacVector &faces) const;
+private:
+	TFacVector _faces;
+	std::map<TFacePtr, int> _indices;
+	BoundingVolumeHierarchy _hierarchy;
+};
+
+#ifdef use_namespace
+}
+#endif
+
+#endif
@@ -0,0 +1,254 @@
+/*
+TSPLINE -- A T-spline object oriented package in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 3.0 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building,
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+   - Created.
+-------------------------------------------------------------------------------
+*/
+
+#include <integrator.h>
+#include <quadrature.h>
+
+#ifdef use_namespace
+namespace TSPLINE {
+	using namespace NEWMAT;
+#endif
+
+/** Add the value to the sum with the compensation of Neumaier, which keeps the low order bits lost by the sum. */
+static void compensatedAdd(Real &sum, Real &compensation, Real value)
+{
+	Real t = sum + value;
+	if (fabs(sum) >= fabs(value)) compensation += (sum - t) + value;
+	else compensation += (value - t) + sum;
+	sum = t;
+}
+
+TMassIntegrator::TMassIntegrator( const TSplinePtr &spline, int order /*= 4*/ ) :
+	_order(order < 1 ? 1 : order),
+	_tolerance(1e-10),
+	_max_depth(8),
+	_size(0.0)
+{
+	BoundingBox box;
+	TPointsetPtr pointset = spline->getTPointset();
+	if (pointset)
+	{
+		for (TObjVIterator iter = pointset->iteratorBegin(); iter != pointset->iteratorEnd(); iter++)
+		{
+			TPointPtr point = castPtr<TPoint>(*iter);
+			if (point) box.extend(Point3D(point->getX(), point->getY(), point->getZ()));
+		}
+	}
+	if (!box.isEmpty())
+	{
+		_origin = box.center();
+		_size = (box.maximum() - box.minimum()).norm2();
+	}
+
+	TBezierExtractor extractor(spline);
+	_faces.resize(extractor.sizeFaces());
+	for (int i=0;i<(int)_faces.size();i++)
+	{
+		TFacePtr tface = extractor.getFace(i);
+		Face &face = _faces[i];
+		TFaceCompiler::compileFace(spline, tface, face);
+		face.domain = 0.0;
+		std::vector<TBezierPatch> patches;
+		extractor.extractFace(tface, patches);
+		for (int j=0;j<(int)patches.size();j++)
+		{
+			face.cells.push_back(patches[j].s_min);
+			face.cells.push_back(patches[j].s_max);
+			face.cells.push_back(patches[j].t_min);
+			face.cells.push_back(patches[j].t_max);
+			face.domain += (patches[j].s_max - patches[j].s_min) * (patches[j].t_max - patches[j].t_min);
+		}
+	}
+
+	_gauss_points.resize(_order);
+	_gauss_weights.resize(_order);
+	TQuadratureBasis::gaussLegendre(_order, &_gauss_points[0], &_gauss_weights[0]);
+}
+
+TMassIntegrator::~TMassIntegrator()
+{
+
+}
+
+int TMassIntegrator::integrate( TMassProperties &properties ) const
+{
+	int n = (int)_faces.size();
+	std::vector<Real> integrals(n*INTEGRALS, 0.0), errors(2*n, 0.0);
+	std::vector<int> cells(n, 0);
+#ifdef USE_OMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+	for (int i=0;i<n;i++)
+	{
+		cells[i] = integrateFace(_faces[i], &integrals[i*INTEGRALS], &errors[2*i]);
+	}
+
+	// The T-faces are summed in their order whichever thread integrated them.
+	Real sums[INTEGRALS], compensations[INTEGRALS];
+	std::fill(sums, sums+INTEGRALS, 0.0);
+	std::fill(compensations, compensations+INTEGRALS, 0.0);
+	properties = TMassProperties();
+	for (int i=0;i<n;i++)
+	{
+		for (int k=0;k<INTEGRALS;k++) compensatedAdd(sums[k], compensations[k], integrals[i*INTEGRALS+k]);
+		properties.area_error += errors[2*i];
+		properties.volume_error += errors[2*i+1];
+		properties.cells += cells[i];
+	}
+	for (int k=0;k<INTEGRALS;k++) sums[k] += compensations[k];
+
+	// The volume integrals change sign with the normals.
+	if (sums[VOLUME] < 0.0)
+	{
+		for (int k=VOLUME;k<INTEGRALS;k++) sums[k] = -sums[k];
+	}
+	Real area = sums[AREA], volume = sums[VOLUME];
+	properties.area = area;
+	properties.area_centroid = _origin + safeDivide(Point3D(sums[1], sums[2], sums[3]), area);
+	properties.volume = volume;
+	Point3D center = safeDivide(Point3D(sums[5], sums[6], sums[7]), volume);
+	properties.centroid = _origin + center;
+
+	// The second moments about the centroid by the parallel axis theorem.
+	Real xx = sums[8] - volume*center.x()*center.x();
+	Real yy = sums[9] - volume*center.y()*center.y();
+	Real zz = sums[10] - volume*center.z()*center.z();
+	Real xy = sums[11] - volume*center.x()*center.y();
+	Real yz = sums[12] - volume*center.y()*center.z();
+	Real zx = sums[13] - volume*center.z()*center.x();
+	properties.inertia[0] = yy + zz;
+	properties.inertia[1] = xx + zz;
+	properties.inertia[2] = xx + yy;
+	properties.inertia[3] = -xy;
+	properties.inertia[4] = -yz;
+	properties.inertia[5] = -zx;
+	return properties.cells;
+}
+
+int TMassIntegrator::integrateFace( const Face &face, Real *integrals, Real *errors ) const
+{
+	Real compensations[INTEGRALS];
+	std::fill(integrals, integrals+INTEGRALS, 0.0);
+	std::fill(compensations, compensations+INTEGRALS, 0.0);
+	errors[0] = errors[1] = 0.0;
+	int count = 0;
+	for (int i=0;i+3<(int)face.cells.size();i+=4)
+	{
+		Real coarse[INTEGRALS], cell[INTEGRALS];
+		std::fill(cell, cell+INTEGRALS, 0.0);
+		applyRule(face, &face.cells[i], coarse);
+		count += integrateCell(face, &face.cells[i], coarse, 0, cell, errors);
+		for (int k=0;k<INTEGRALS;k++) compensatedAdd(integrals[k], compensations[k], cell[k]);
+	}
+	for (int k=0;k<INTEGRALS;k++) integrals[k] += compensations[k];
+	return count;
+}
+
+int TMassIntegrator::integrateCell( const Face &face, const Real *cell, const Real *coarse, int depth, Real *integrals, Real *errors ) const
+{
+	Real s_middle = 0.5 * (cell[0] + cell[1]), t_middle = 0.5 * (cell[2] + cell[3]);
+	Real quarters[4][4] = {
+		{cell[0], s_middle, cell[2], t_middle}, {s_middle, cell[1], cell[2], t_middle},
+		{cell[0], s_middle, t_middle, cell[3]}, {s_middle, cell[1], t_middle, cell[3]}};
+	Real fine[4][INTEGRALS];
+	Real area = 0.0, volume = 0.0;
+	for (int q=0;q<4;q++)
+	{
+		applyRule(face, quarters[q], fine[q]);
+		area += fine[q][AREA];
+		volume += fine[q][VOLUME];
+	}
+
+	Real area_error = fabs(area - coarse[AREA]), volume_error = fabs(volume - coarse[VOLUME]);
+	Real share = safeDivide((cell[1] - cell[0]) * (cell[3] - cell[2]), face.domain);
+	Real tolerance = _tolerance * share * _size * _size;
+	if (depth >= _max_depth || (area_error <= tolerance && volume_error <= tolerance * _size))
+	{
+		for (int q=0;q<4;q++)
+		{
+			for (int k=0;k<INTEGRALS;k++) integrals[k] += fine[q][k];
+		}
+		errors[0] += area_error;
+		errors[1] += volume_error;
+		return 4;
+	}
+
+	int count = 0;
+	for (int q=0;q<4;q++)
+	{
+		count += integrateCell(face, quarters[q], fine[q], depth+1, integrals, errors);
+	}
+	return count;
+}
+
+void TMassIntegrator::applyRule( const Face &face, const Real *cell, Real *integrals ) const
+{
+	std::fill(integrals, integrals+INTEGRALS, 0.0);
+	Real hs = cell[1] - cell[0], ht = cell[3] - cell[2];
+	for (int a=0;a<_order;a++)
+	{
+		for (int b=0;b<_order;b++)
+		{
+			Real d[9];
+			face.equation->computeDerivatives(cell[0] + hs*_gauss_points[a], cell[2] + ht*_gauss_points[b], 1, d);
+			Real x = d[0] - _origin.x(), y = d[1] - _origin.y(), z = d[2] - _origin.z();
+			// The normal Su x Sv, its length is the area element.
+			Real nx = d[4]*d[8] - d[5]*d[7], ny = d[5]*d[6] - d[3]*d[8], nz = d[3]*d[7] - d[4]*d[6];
+			Real w = _gauss_weights[a] * _gauss_weights[b] * hs * ht;
+			Real dA = sqrt(nx*nx + ny*ny + nz*nz) * w;
+			nx *= w; ny *= w; nz *= w;
+			integrals[0] += dA;
+			integrals[1] += x * dA;
+			integrals[2] += y * dA;
+			integrals[3] += z * dA;
+			// The fields whose divergence is the integrand of the volume, e.g. (x^2/2, 0, 0) for x.
+			integrals[4] += (x*nx + y*ny + z*nz) / 3.0;
+			integrals[5] += x*x*nx / 2.0;
+			integrals[6] += y*y*ny / 2.0;
+			integrals[7] += z*z*nz / 2.0;
+			integrals[8] += x*x*x*nx / 3.0;
+			integrals[9] += y*y*y*ny / 3.0;
+			integrals[10] += z*z*z*nz / 3.0;
+			integrals[11] += x*x*y*nx / 2.0;
+			integrals[12] += y*y*z*ny / 2.0;
+			integrals[13] += z*z*x*nz / 2.0;
+		}
+	}
+}
+
+#ifdef use_namespace
+}
+#endif
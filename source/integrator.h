@@ -0,0 +1,133 @@
+/*
+T-SPLINE -- A T-spline object oriented library in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 2.1 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building,
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+- Created.
+-------------------------------------------------------------------------------
+*/
+
+/**  @file  [integrator]
+  *  @brief  Mass properties of a T-spline surface.
+  *  @author  <agent>
+  *  @date  <2026.10.19>
+  *  @version  <v1.0>
+  *  @note
+  *  This file contains the integrator which computes the area, the enclosed volume, the centroids and the
+  *  inertia tensor of a T-spline surface by adaptive Gauss-Legendre quadrature on the exact surface.
+*/
+
+#ifndef INTEGRATOR_H
+#define INTEGRATOR_H
+
+#include <utils.h>
+#include <tspline.h>
+#include <splbase.h>
+#include <compiler.h>
+
+#ifdef use_namespace
+namespace TSPLINE {
+	using namespace NEWMAT;
+#endif
+
+DECLARE_SMARTPTR(TMassIntegrator);
+
+/** The mass properties of a surface and of the volume it encloses, for a unit density. */
+struct TMassProperties
+{
+	TMassProperties() : area(0.0), volume(0.0), area_error(0.0), volume_error(0.0), cells(0) { std::fill(inertia, inertia+6, 0.0); }
+	Real area;
+	Point3D area_centroid;	/** The centroid of the surface. */
+	Real volume;			/** The enclosed volume, only meaningful if the surface is closed. */
+	Point3D centroid;		/** The centroid of the enclosed volume. */
+	Real inertia[6];		/** Ixx, Iyy, Izz, Ixy, Iyz and Izx of the enclosed volume about its centroid, Ixy = -int(x*y dV). */
+	Real area_error;		/** The estimated error of the area. */
+	Real volume_error;		/** The estimated error of the volume. */
+	int cells;				/** The number of cells integrated by the Gauss rule. */
+};
+
+/**
+  *  @class  <TMassIntegrator>
+  *  @brief  T-spline mass properties integrator
+  *  @note
+  *  The blending equation of every T-face is compiled once and its domain is split into the knot cells of TBezierExtractor,
+  *  on which the surface is smooth. The surface integrals are computed with the exact first derivatives, the area element
+  *  being |Su x Sv|; the volume integrals are turned into surface integrals by the divergence theorem, so the volume is
+  *  only meaningful for a closed surface, and it is made positive whichever way the normals point. On a cell the result
+  *  of an order * order Gauss rule is compared with the sum of the rule on its four quarters, and the quarters are split
+  *  again until the difference of the area and of the volume is within the tolerance for their share of the domain of
+  *  the T-face; the differences are summed as the error estimates. The T-faces are integrated independently on all the
+  *  threads, and the results of the cells are summed in a fixed order with compensation, so that the properties do
+  *  not depend on the number of threads.
+*/
+class TMassIntegrator
+{
+public:
+	TMassIntegrator(const TSplinePtr &spline, int order = 4);
+	~TMassIntegrator();
+public:
+	/** Set the tolerance of a T-face relative to the size of the T-spline, 1e-10 by default. */
+	void setTolerance(Real tolerance) {_tolerance = tolerance;}
+	/** Set the maximum number of times a knot cell is split into quarters, 8 by default. */
+	void setMaxDepth(int depth) {_max_depth = depth;}
+	/** Return the number of T-faces. */
+	int sizeFaces() const {return (int)_faces.size();}
+public:
+	/** Integrate the mass properties of the T-spline on all the threads, return the number of cells integrated. */
+	int integrate(TMassProperties &properties) const;
+protected:
+	/** The integrals of area, area * (x, y, z), volume, volume * (x, y, z) and volume * (xx, yy, zz, xy, yz, zx). */
+	enum { AREA = 0, VOLUME = 4, INTEGRALS = 14 };
+	struct Face : public TCompiledFace
+	{
+		Real domain;	/** The area of the domain of the T-face. */
+		std::vector<Real> cells;	/** s_min, s_max, t_min and t_max of each knot cell. */
+	};
+	/** Integrate the T-face, sum the integrals of its cells with compensation and return the number of cells integrated. */
+	int integrateFace(const Face &face, Real *integrals, Real *errors) const;
+	/** Integrate the cell from the result of the Gauss rule on it, splitting it while the error is not within the tolerance. */
+	int integrateCell(const Face &face, const Real *cell, const Real *coarse, int depth, Real *integrals, Real *errors) const;
+	/** Apply the Gauss rule on the cell. */
+	void applyRule(const Face &face, const Real *cell, Real *integrals) const;
+private:
+	int _order;
+	Real _tolerance;
+	int _max_depth;
+	Real _size;
+	Point3D _origin;	/** The center of the T-points, the integrals are taken about it. */
+	std::vector<Face> _faces;
+	std::vector<Real> _gauss_points, _gauss_weights;
+};
+
+#ifdef use_namespace
+}
+#endif
+
+#endif
@@ -0,0 +1,412 @@
+/*
+T-SPLINE -- A T-spline object oriented library in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 2.1 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building,
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+   - Created.
+-------------------------------------------------------------------------------
+*/
+
+#include <intersector.h>
+#include <algorithm>
+#ifdef USE_OMP
+#include <omp.h>
+#endif
+
+#ifdef use_namespace
+namespace TSPLINE {
+	using namespace NEWMAT;
+#endif
+
+/** The sine of the angle between the normals below which the surfaces are taken as tangent. */
+static const Real TANGENCY = 1e-8;
+
+/** Solve the n * n system in place by Gaussian elimination with partial pivoting, the solution replaces rhs. */
+static bool solveLinear(int n, Real *matrix, Real *rhs)
+{
+	for (int k=0;k<n;k++)
+	{
+		int pivot = k;
+		for (int i=k+1;i<n;i++)
+		{
+			if (fabs(matrix[i*n+k]) > fabs(matrix[pivot*n+k])) pivot = i;
+		}
+		if (matrix[pivot*n+k] == 0.0) return false;
+		if (pivot != k)
+		{
+			for (int j=0;j<n;j++) std::swap(matrix[k*n+j], matrix[pivot*n+j]);
+			std::swap(rhs[k], rhs[pivot]);
+		}
+		for (int i=k+1;i<n;i++)
+		{
+			Real factor = matrix[i*n+k] / matrix[k*n+k];
+			for (int j=k;j<n;j++) matrix[i*n+j] -= factor * matrix[k*n+j];
+			rhs[i] -= factor * rhs[k];
+		}
+	}
+	for (int k=n-1;k>=0;k--)
+	{
+		for (int j=k+1;j<n;j++) rhs[k] -= matrix[k*n+j] * rhs[j];
+		rhs[k] /= matrix[k*n+k];
+	}
+	return true;
+}
+
+TIntersector::TIntersector( const TSplinePtr &spline_a, const TSplinePtr &spline_b, int resolution /*= 8*/ ) :
+	_resolution(resolution < 1 ? 1 : resolution),
+	_tolerance(1e-10),
+	_max_iterations(20),
+	_max_steps(10000),
+	_max_depth(1),
+	_hulls_a(spline_a),
+	_hulls_b(spline_b)
+{
+	BoundingBox box = _hulls_a.getBox();
+	box.extend(_hulls_b.getBox());
+	_chord_tolerance = box.isEmpty() ? 0.0 : 1e-4 * (box.maximum() - box.minimum()).norm2();
+
+	TBezierExtractor extractor_a(spline_a), extractor_b(spline_b);
+	_faces_a.resize(_hulls_a.sizeFaces());
+	for (int i=0;i<(int)_faces_a.size();i++) compileFace(spline_a, extractor_a, _hulls_a.getFace(i), _faces_a[i]);
+	_faces_b.resize(_hulls_b.sizeFaces());
+	for (int i=0;i<(int)_faces_b.size();i++) compileFace(spline_b, extractor_b, _hulls_b.getFace(i), _faces_b[i]);
+
+	auto visitor = [&](int a, int b) { _pairs.push_back(std::make_pair(a, b)); };
+	_hulls_a.getHierarchy().visitOverlappingPairs(_hulls_b.getHierarchy(), visitor);
+	std::sort(_pairs.begin(), _pairs.end());
+}
+
+TIntersector::~TIntersector()
+{
+
+}
+
+void TIntersector::compileFace( const TSplinePtr &spline, const TBezierExtractor &extractor, const TFacePtr &tface, Face &face )
+{
+	TFaceCompiler::compileFace(spline, tface, face);
+	TFaceCompiler::compilePatches(extractor, face);
+	std::vector<BoundingBox> cells;
+	TFaceCompiler::boundCells(face, _resolution, cells);
+	face.cells.build(cells);
+}
+
+bool TIntersector::findSeed( const Face &a, const Face &b, const Real *domain_a, const Real *domain_b, int depth, Point &seed ) const
+{
+	seed.x[0] = 0.5*(domain_a[0] + domain_a[1]); seed.x[1] = 0.5*(domain_a[2] + domain_a[3]);
+	seed.x[2] = 0.5*(domain_b[0] + domain_b[1]); seed.x[3] = 0.5*(domain_b[2] + domain_b[3]);
+	if (converge(a, b, seed.x) && evaluate(a, b, seed)) return true;
+	if (depth >= _max_depth) return false;
+
+	// A seed far from a small piece of the curve, e.g. at a corner, misses it, the quarters bounding the piece are tried.
+	Real quarters_a[4][4], quarters_b[4][4];
+	BoundingBox boxes_a[4], boxes_b[4];
+	for (int i=0;i<4;i++)
+	{
+		const Real *domains[2] = {domain_a, domain_b};
+		Real (*quarters[2])[4] = {quarters_a, quarters_b};
+		for (int k=0;k<2;k++)
+		{
+			const Real *domain = domains[k];
+			Real s_half = 0.5*(domain[0] + domain[1]), t_half = 0.5*(domain[2] + domain[3]);
+			quarters[k][i][0] = i % 2 == 0 ? domain[0] : s_half; quarters[k][i][1] = i % 2 == 0 ? s_half : domain[1];
+			quarters[k][i][2] = i < 2 ? domain[2] : t_half; quarters[k][i][3] = i < 2 ? t_half : domain[3];
+		}
+		TFaceCompiler::boundCell(a, quarters_a[i][0], quarters_a[i][1], quarters_a[i][2], quarters_a[i][3], boxes_a[i]);
+		TFaceCompiler::boundCell(b, quarters_b[i][0], quarters_b[i][1], quarters_b[i][2], quarters_b[i][3], boxes_b[i]);
+	}
+	for (int i=0;i<4;i++)
+	{
+		for (int j=0;j<4;j++)
+		{
+			if (boxes_a[i].overlaps(boxes_b[j]) && findSeed(a, b, quarters_a[i], quarters_b[j], depth+1, seed)) return true;
+		}
+	}
+	return false;
+}
+
+int TIntersector::intersect( std::vector<TIntersectionCurve> &curves ) const
+{
+	int n = (int)_pairs.size();
+	std::vector<std::vector<TIntersectionCurve> > results(n);
+	// A pair of T-faces is a large task, the threads take them one by one.
+#ifdef USE_OMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+	for (int i=0;i<n;i++)
+	{
+		intersectPair(_faces_a[_pairs[i].first], _faces_b[_pairs[i].second], results[i]);
+	}
+
+	curves.clear();
+	for (int i=0;i<n;i++)
+	{
+		curves.insert(curves.end(), results[i].begin(), results[i].end());
+	}
+	return (int)curves.size();
+}
+
+int TIntersector::intersectFaces( const TFacePtr &face_a, const TFacePtr &face_b, std::vector<TIntersectionCurve> &curves ) const
+{
+	curves.clear();
+	int a = _hulls_a.findIndex(face_a), b = _hulls_b.findIndex(face_b);
+	if (a < 0 || b < 0) return 0;
+	intersectPair(_faces_a[a], _faces_b[b], curves);
+	return (int)curves.size();
+}
+
+void TIntersector::intersectPair( const Face &a, const Face &b, std::vector<TIntersectionCurve> &curves ) const
+{
+	std::vector<std::pair<int, int> > cells;
+	auto visitor = [&](int cell_a, int cell_b) { cells.push_back(std::make_pair(cell_a, cell_b)); };
+	a.cells.visitOverlappingPairs(b.cells, visitor);
+	std::sort(cells.begin(), cells.end());
+
+	Real near2 = 4.0 * _chord_tolerance * 4.0 * _chord_tolerance;
+	for (int i=0;i<(int)cells.size();i++)
+	{
+		Point seed;
+		Real domain_a[4], domain_b[4];
+		TFaceCompiler::cellDomain(a, _resolution, cells[i].first, domain_a[0], domain_a[1], domain_a[2], domain_a[3]);
+		TFaceCompiler::cellDomain(b, _resolution, cells[i].second, domain_b[0], domain_b[1], domain_b[2], domain_b[3]);
+		if (!findSeed(a, b, domain_a, domain_b, 0, seed)) continue;
+
+		// Most of the seeds fall on a curve traced from an earlier one.
+		bool traced = false;
+		for (int c=0;c<(int)curves.size() && !traced;c++)
+		{
+			const std::vector<Point3D> &points = curves[c].points;
+			for (int k=0;k<(int)points.size() && !traced;k++)
+			{
+				const Point3D &p = points[k], &q = points[(k+1) % points.size()];
+				Real pa[3] = {p.x(), p.y(), p.z()}, qa[3] = {q.x(), q.y(), q.z()};
+				traced = squaredChordDistance(seed.point, pa, qa) <= near2;
+			}
+		}
+		if (traced) continue;
+
+		std::vector<Point> forward, backward;
+		TIntersectionCurve curve;
+		curve.closed = trace(a, b, seed, 1.0, forward);
+		if (!curve.closed) trace(a, b, seed, -1.0, backward);
+		// The T-faces only touch at the seed, on their boundaries.
+		if (forward.empty() && backward.empty()) continue;
+		std::reverse(backward.begin(), backward.end());
+		backward.push_back(seed);
+		backward.insert(backward.end(), forward.begin(), forward.end());
+
+		curve.face_a = a.face;
+		curve.face_b = b.face;
+		for (int k=0;k<(int)backward.size();k++)
+		{
+			const Point &point = backward[k];
+			curve.parameters_a.push_back(Parameter(point.x[0], point.x[1]));
+			curve.parameters_b.push_back(Parameter(point.x[2], point.x[3]));
+			curve.points.push_back(Point3D(point.point[0], point.point[1], point.point[2]));
+		}
+		curves.push_back(curve);
+	}
+}
+
+bool TIntersector::converge( const Face &a, const Face &b, Real *x ) const
+{
+	// Newton iterations on Sa(x0, x1) - Sb(x2, x3) = 0, three equations of four unknowns, taking the step of the least norm.
+	Real size = max(a.size, b.size);
+	const Real lower[4] = {a.s_min, a.t_min, b.s_min, b.t_min}, upper[4] = {a.s_max, a.t_max, b.s_max, b.t_max};
+	Real A[9], B[9];
+	Real last_residual = std::numeric_limits<Real>::max();
+	for (int iteration=0;iteration<_max_iterations;iteration++)
+	{
+		a.equation->computeDerivatives(x[0], x[1], 1, A);
+		b.equation->computeDerivatives(x[2], x[3], 1, B);
+		Real r[3] = {A[0]-B[0], A[1]-B[1], A[2]-B[2]};
+		Real residual = sqrt(dot3(r, r));
+		if (residual <= _tolerance * size) return true;
+		if (residual >= last_residual && residual <= TFaceCompiler::CELL_MARGIN * size) return true;
+		last_residual = residual;
+
+		// The step is J^T y with (J J^T) y = -r, the columns of J being Sa_s, Sa_t, -Sb_s and -Sb_t.
+		const Real *J[4] = {A+3, A+6, B+3, B+6};
+		const Real signs[4] = {1.0, 1.0, -1.0, -1.0};
+		Real G[9], y[3] = {-r[0], -r[1], -r[2]};
+		for (int i=0;i<3;i++)
+		{
+			for (int j=0;j<3;j++)
+			{
+				G[i*3+j] = J[0][i]*J[0][j] + J[1][i]*J[1][j] + J[2][i]*J[2][j] + J[3][i]*J[3][j];
+			}
+		}
+		if (!solveLinear(3, G, y)) return false;
+		for (int k=0;k<4;k++)
+		{
+			x[k] = max(lower[k], min(upper[k], x[k] + signs[k] * dot3(J[k], y)));
+		}
+	}
+	return false;
+}
+
+bool TIntersector::correct( const Face &a, const Face &b, const Real *target, const Real *tangent, int fixed, Real *x ) const
+{
+	// Newton iterations on Sa - Sb = 0 and on the plane of the step, or on the parameter held on a boundary.
+	Real size = max(a.size, b.size);
+	const Real lower[4] = {a.s_min, a.t_min, b.s_min, b.t_min}, upper[4] = {a.s_max, a.t_max, b.s_max, b.t_max};
+	Real A[9], B[9];
+	Real last_residual = std::numeric_limits<Real>::max();
+	for (int iteration=0;iteration<_max_iterations;iteration++)
+	{
+		a.equation->computeDerivatives(x[0], x[1], 1, A);
+		b.equation->computeDerivatives(x[2], x[3], 1, B);
+		Real d[3] = {A[0]-target[0], A[1]-target[1], A[2]-target[2]};
+		Real rhs[4] = {B[0]-A[0], B[1]-A[1], B[2]-A[2], fixed < 0 ? -dot3(d, tangent) : 0.0};
+		Real residual = sqrt(dot3(rhs, rhs) + rhs[3]*rhs[3]);
+		if (residual <= _tolerance * size) return true;
+		if (residual >= last_residual && residual <= TFaceCompiler::CELL_MARGIN * size) return true;
+		last_residual = residual;
+
+		Real M[16];
+		for (int i=0;i<3;i++)
+		{
+			M[i*4+0] = A[3+i]; M[i*4+1] = A[6+i]; M[i*4+2] = -B[3+i]; M[i*4+3] = -B[6+i];
+		}
+		M[12] = fixed < 0 ? dot3(A+3, tangent) : 0.0;
+		M[13] = fixed < 0 ? dot3(A+6, tangent) : 0.0;
+		M[14] = 0.0; M[15] = 0.0;
+		if (fixed >= 0) M[12+fixed] = 1.0;
+		if (!solveLinear(4, M, rhs)) return false;
+		for (int k=0;k<4;k++)
+		{
+			x[k] = max(lower[k], min(upper[k], x[k] + rhs[k]));
+		}
+	}
+	return false;
+}
+
+bool TIntersector::evaluate( const Face &a, const Face &b, Point &point ) const
+{
+	Real A[9], B[9];
+	a.equation->computeDerivatives(point.x[0], point.x[1], 1, A);
+	b.equation->computeDerivatives(point.x[2], point.x[3], 1, B);
+	for (int i=0;i<3;i++) point.point[i] = A[i];
+	for (int i=0;i<6;i++)
+	{
+		point.da[i] = A[3+i];
+		point.db[i] = B[3+i];
+	}
+
+	Real na[3], nb[3];
+	cross3(A+3, A+6, na);
+	cross3(B+3, B+6, nb);
+	cross3(na, nb, point.tangent);
+	Real length = sqrt(dot3(point.tangent, point.tangent));
+	if (length <= TANGENCY * sqrt(dot3(na, na) * dot3(nb, nb))) return false;
+	for (int i=0;i<3;i++) point.tangent[i] /= length;
+	return true;
+}
+
+bool TIntersector::trace( const Face &a, const Face &b, const Point &start, Real direction, std::vector<Point> &points ) const
+{
+	const Real lower[4] = {a.s_min, a.t_min, b.s_min, b.t_min}, upper[4] = {a.s_max, a.t_max, b.s_max, b.t_max};
+	Real max_step = min(a.size, b.size) / _resolution, min_step = 1e-6 * max_step, step = max_step;
+	if (max_step <= 0.0) return false;
+
+	Point current = start;
+	Real tangent[3] = {direction*start.tangent[0], direction*start.tangent[1], direction*start.tangent[2]};
+	for (int count=0;count<_max_steps;)
+	{
+		// Predict the parameters of both T-faces along the tangent by the least squares of Su * ds + Sv * dt = step * tangent.
+		Real x[4];
+		for (int f=0;f<2;f++)
+		{
+			const Real *Su = f == 0 ? current.da : current.db, *Sv = Su + 3;
+			Real uu = dot3(Su, Su), uv = dot3(Su, Sv), vv = dot3(Sv, Sv), det = uu*vv - uv*uv;
+			Real bu = step * dot3(Su, tangent), bv = step * dot3(Sv, tangent);
+			x[2*f] = current.x[2*f] + (det != 0.0 ? (bu*vv - bv*uv) / det : 0.0);
+			x[2*f+1] = current.x[2*f+1] + (det != 0.0 ? (uu*bv - uv*bu) / det : 0.0);
+		}
+		// Shorten the step to the first boundary it crosses, the parameter stays there.
+		Real fraction = 1.0;
+		int fixed = -1;
+		for (int k=0;k<4;k++)
+		{
+			Real bound = x[k] < lower[k] ? lower[k] : x[k] > upper[k] ? upper[k] : x[k];
+			if (bound == x[k]) continue;
+			Real f = (bound - current.x[k]) / (x[k] - current.x[k]);
+			if (f < fraction)
+			{
+				fraction = max(f, 0.0);
+				fixed = k;
+			}
+		}
+		// The curve leaves the T-faces here.
+		if (fraction * step <= min_step) break;
+		for (int k=0;k<4;k++) x[k] = current.x[k] + fraction * (x[k] - current.x[k]);
+		if (fixed >= 0) x[fixed] = x[fixed] < 0.5*(lower[fixed]+upper[fixed]) ? lower[fixed] : upper[fixed];
+
+		Real target[3] = {current.point[0] + step*fraction*tangent[0], current.point[1] + step*fraction*tangent[1], current.point[2] + step*fraction*tangent[2]};
+		Point next;
+		for (int k=0;k<4;k++) next.x[k] = x[k];
+		bool corrected = correct(a, b, target, tangent, fixed, next.x) && evaluate(a, b, next);
+		Real chord[3] = {next.point[0]-current.point[0], next.point[1]-current.point[1], next.point[2]-current.point[2]};
+		Real length = sqrt(dot3(chord, chord));
+		Real sagitta = 0.0;
+		if (corrected)
+		{
+			if (dot3(next.tangent, tangent) < 0.0)
+			{
+				for (int i=0;i<3;i++) next.tangent[i] = -next.tangent[i];
+			}
+			// The sagitta of an arc of the length and the turning angle is about length * angle / 8.
+			sagitta = length * acos(max(-1.0, min(1.0, dot3(next.tangent, tangent)))) / 8.0;
+		}
+		// The corrector may also jump onto another branch, farther than the step.
+		if (!corrected || sagitta > _chord_tolerance || length > 2.0 * step)
+		{
+			if (step <= min_step) break;
+			step *= 0.5;
+			continue;
+		}
+
+		// A loop closes when its chord comes back by the start.
+		if (points.size() >= 2 && squaredChordDistance(start.point, current.point, next.point) <= 4.0 * _chord_tolerance * _chord_tolerance)
+		{
+			return true;
+		}
+		points.push_back(next);
+		current = next;
+		for (int i=0;i<3;i++) tangent[i] = next.tangent[i];
+		count++;
+		if (fixed >= 0) break;
+		if (sagitta < 0.25 * _chord_tolerance) step = min(max_step, 1.5 * step);
+	}
+	return false;
+}
+
+#ifdef use_namespace
+}
+#endif
@@ -0,0 +1,156 @@
+/*
+T-SPLINE -- A T-spline object oriented library in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 2.1 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building,
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+- Created.
+-------------------------------------------------------------------------------
+*/
+
+/**  @file  [intersector]
+  *  @brief  Intersection of two T-spline surfaces.
+  *  @author  <agent>
+  *  @date  <2026.10.19>
+  *  @version  <v1.0>
+  *  @note
+  *  This file contains the intersector which traces the intersection curves of two T-spline surfaces (SSI),
+  *  used for trimming and Boolean operations.
+*/
+
+#ifndef INTERSECTOR_H
+#define INTERSECTOR_H
+
+#include <utils.h>
+#include <tspline.h>
+#include <splbase.h>
+#include <hierarchy.h>
+#include <compiler.h>
+
+#ifdef use_namespace
+namespace TSPLINE {
+	using namespace NEWMAT;
+#endif
+
+DECLARE_SMARTPTR(TIntersector);
+
+/** An intersection curve of a pair of T-faces, a polyline in space and in the domains of both T-faces. */
+struct TIntersectionCurve
+{
+	TIntersectionCurve() : closed(false) {}
+	TFacePtr face_a;						/** The T-face of the first T-spline. */
+	TFacePtr face_b;						/** The T-face of the second T-spline. */
+	std::vector<Parameter> parameters_a;	/** The parameters of the points on face_a. */
+	std::vector<Parameter> parameters_b;	/** The parameters of the points on face_b. */
+	std::vector<Point3D> points;			/** The points of the curve. */
+	bool closed;							/** True if the last point joins the first one, which is not repeated. */
+};
+
+/**
+  *  @class  <TIntersector>
+  *  @brief  T-spline surface intersector
+  *  @note
+  *  The intersector compiles the blending equation of every T-face of both T-splines once and splits each T-face into
+  *  resolution * resolution cells bounded by the control points of its Bezier patches (see TFaceCompiler). The pairs of T-faces whose control hulls overlap are found
+  *  by traversing the TFaceHierarchy of both T-splines together, and are intersected independently on all the threads.
+  *  In a pair of T-faces every pair of overlapping cells seeds a point common to both surfaces by Newton iterations from
+  *  their centers, or from the centers of their overlapping quarters if these do not converge; a seed which is not on a curve found already is traced both ways along the cross product of the normals.
+  *  Each step predicts the parameters of both T-faces along the tangent and corrects them by Newton iterations on the exact
+  *  surfaces in the plane normal to the tangent, with the step length adapted to the chord tolerance. A curve ends on the
+  *  boundary of either T-face, exactly on it, or closes when it comes back to its seed. The curves are not joined across
+  *  the T-faces, and a curve smaller than a cell or where the surfaces touch tangentially may be missed.
+*/
+class TIntersector
+{
+public:
+	TIntersector(const TSplinePtr &spline_a, const TSplinePtr &spline_b, int resolution = 8);
+	~TIntersector();
+public:
+	/** Set the tolerance of the Newton iterations relative to the size of the T-faces. */
+	void setTolerance(Real tolerance) {_tolerance = tolerance;}
+	/** Set the maximum number of Newton iterations. */
+	void setMaxIterations(int iterations) {_max_iterations = iterations;}
+	/** Set the largest distance of a chord from the curve, 1e-4 of the size of both T-splines by default. */
+	void setChordTolerance(Real tolerance) {_chord_tolerance = tolerance;}
+	/** Set the maximum number of steps traced each way from a seed. */
+	void setMaxSteps(int steps) {_max_steps = steps;}
+	/** Set the maximum number of times a pair of cells is subdivided while no seed converges in it. */
+	void setMaxDepth(int depth) {_max_depth = depth;}
+	/** Return the number of pairs of T-faces whose control hulls overlap. */
+	int sizePairs() const {return (int)_pairs.size();}
+public:
+	/** Intersect the two T-spline surfaces on all the threads, return the number of curves. */
+	int intersect(std::vector<TIntersectionCurve> &curves) const;
+	/** Intersect a T-face of the first T-spline with a T-face of the second one, return the number of curves. */
+	int intersectFaces(const TFacePtr &face_a, const TFacePtr &face_b, std::vector<TIntersectionCurve> &curves) const;
+protected:
+	struct Face : public TCompiledFace
+	{
+		BoundingVolumeHierarchy cells;
+	};
+	/** A point on both surfaces. */
+	struct Point
+	{
+		Real x[4];			/** The parameter (s, t) on the first T-face followed by the one on the second T-face. */
+		Real point[3];
+		Real tangent[3];	/** The unit tangent of the curve. */
+		Real da[6];			/** The first derivatives Su and Sv of the first surface. */
+		Real db[6];			/** The first derivatives Su and Sv of the second surface. */
+	};
+	void compileFace(const TSplinePtr &spline, const TBezierExtractor &extractor, const TFacePtr &tface, Face &face);
+	/** Find a seed from the centers of the domains, subdividing them where their bounds overlap, return false if none converges. */
+	bool findSeed(const Face &a, const Face &b, const Real *domain_a, const Real *domain_b, int depth, Point &seed) const;
+	void intersectPair(const Face &a, const Face &b, std::vector<TIntersectionCurve> &curves) const;
+	/** Move x onto both surfaces by Newton iterations of the least change, return false if they do not converge. */
+	bool converge(const Face &a, const Face &b, Real *x) const;
+	/** Move x onto both surfaces in the plane through the target normal to the tangent, or with x[fixed] kept at its bound. */
+	bool correct(const Face &a, const Face &b, const Real *target, const Real *tangent, int fixed, Real *x) const;
+	/** Evaluate the point and the tangent at point.x, return false where the surfaces are tangent. */
+	bool evaluate(const Face &a, const Face &b, Point &point) const;
+	/** Trace the curve from the start along direction * tangent, return true if it closes. */
+	bool trace(const Face &a, const Face &b, const Point &start, Real direction, std::vector<Point> &points) const;
+private:
+	int _resolution;
+	Real _tolerance;
+	int _max_iterations;
+	Real _chord_tolerance;
+	int _max_steps;
+	int _max_depth;
+	TFaceHierarchy _hulls_a;
+	TFaceHierarchy _hulls_b;
+	std::vector<Face> _faces_a;
+	std::vector<Face> _faces_b;
+	std::vector<std::pair<int, int> > _pairs;
+};
+
+#ifdef use_namespace
+}
+#endif
+
+#endif
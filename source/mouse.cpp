@@ -994,3 +994,8 @@ void MouseDemo::findTFaceNames( std::vector<std::string> &faces )
 {
 	_factory->findTObjectNames(faces, TSPLINE::E_TFACE);
 }
+
+int MouseDemo::getTJunctionConflicts()
+{
+	return _factory->getTJunctionConflicts();
+}
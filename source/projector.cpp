@@ -0,0 +1,291 @@
+/*
+TSPLINE -- A T-spline object oriented package in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 3.0 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building,
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+   - Created.
+-------------------------------------------------------------------------------
+*/
+
+#include <projector.h>
+#include <extractor.h>
+#include <algorithm>
+#ifdef USE_OMP
+#include <omp.h>
+#endif
+
+#ifdef use_namespace
+namespace TSPLINE {
+	using namespace NEWMAT;
+#endif
+
+/** The largest number of the samples from which the Newton iterations start on a T-face. */
+static const size_t MAX_STARTS = 3;
+/** The smallest fraction of a Gauss-Newton step tried before the parameters are stepped one at a time. */
+static const Real MIN_SCALE = 1e-3;
+
+TProjector::TProjector( const TSplinePtr &spline, int resolution /*= 4*/ ) :
+	_resolution(resolution < 1 ? 1 : resolution),
+	_tolerance(1e-10),
+	_max_iterations(30)
+{
+	TFacVector faces;
+	TExtractor::extractBlendedTFacesFromTImage(spline->getTImage(), faces);
+	_faces.resize(faces.size());
+	std::vector<BoundingBox> boxes(_faces.size());
+	for (int i=0;i<(int)faces.size();i++)
+	{
+		compileFace(spline, faces[i], _faces[i], boxes[i]);
+		_indices[faces[i]] = i;
+	}
+	_hierarchy.build(boxes);
+}
+
+TProjector::~TProjector()
+{
+
+}
+
+void TProjector::compileFace( const TSplinePtr &spline, const TFacePtr &tface, Face &face, BoundingBox &box )
+{
+	TFaceCompiler::compileFace(spline, tface, face, box);
+
+	for (int i=0;i<=_resolution;i++)
+	{
+		for (int j=0;j<=_resolution;j++)
+		{
+			Parameter sample(face.s_min + (face.s_max-face.s_min)*i/_resolution, face.t_min + (face.t_max-face.t_min)*j/_resolution);
+			face.samples.push_back(sample);
+			face.points.push_back(face.equation->computePoint(sample));
+		}
+	}
+	// The samples are on the surface, the box must not miss them because of a non positive weight.
+	for (int i=0;i<(int)face.points.size();i++) box.extend(face.points[i]);
+}
+
+Real TProjector::closestPoint( const Face &face, const Point3D &point, Parameter &parameter ) const
+{
+	int n = _resolution + 1;
+	std::vector<Real> distances(face.points.size());
+	for (int i=0;i<(int)face.points.size();i++)
+	{
+		Point3D r = face.points[i] - point;
+		distances[i] = r.x()*r.x() + r.y()*r.y() + r.z()*r.z();
+	}
+
+	// A curved T-face may have several local minima, Newton starts from each sample which is nearer
+	// than its neighbours, the nearest ones first.
+	std::vector<std::pair<Real, int> > seeds;
+	for (int i=0;i<n;i++)
+	{
+		for (int j=0;j<n;j++)
+		{
+			Real d2 = distances[i*n+j];
+			bool minimum = true;
+			for (int k=max(i-1,0);k<=min(i+1,n-1) && minimum;k++)
+			{
+				for (int l=max(j-1,0);l<=min(j+1,n-1);l++)
+				{
+					if (distances[k*n+l] < d2) { minimum = false; break; }
+				}
+			}
+			if (minimum) seeds.push_back(std::make_pair(d2, i*n+j));
+		}
+	}
+	std::sort(seeds.begin(), seeds.end());
+	if (seeds.size() > MAX_STARTS) seeds.resize(MAX_STARTS);
+
+	Real best_d2 = std::numeric_limits<Real>::max();
+	for (int i=0;i<(int)seeds.size();i++)
+	{
+		Real s = face.samples[seeds[i].second].s(), t = face.samples[seeds[i].second].t();
+		Real d2 = refine(face, point, s, t);
+		if (d2 < best_d2)
+		{
+			best_d2 = d2;
+			parameter = Parameter(s, t);
+		}
+	}
+	return best_d2;
+}
+
+Real TProjector::refine( const Face &face, const Point3D &point, Real &s, Real &t ) const
+{
+	// Newton iterations on (S-P).Su = 0 and (S-P).Sv = 0. A step which goes uphill is taken again from the
+	// best parameter by Gauss-Newton, whose direction always descends, and halved until it goes downhill.
+	// Close knots of the T-points leave a kink in the surface, on which the derivatives of one side do not
+	// lead downhill: once the steps stall there, s and then t are stepped alone.
+	Real tolerance_s = _tolerance * (face.s_max - face.s_min), tolerance_t = _tolerance * (face.t_max - face.t_min);
+	const Real P[3] = {point.x(), point.y(), point.z()};
+	Real best[18], derivatives[18];
+	face.equation->computeDerivatives(s, t, 2, best);
+	Real best_d2 = (best[0]-P[0])*(best[0]-P[0]) + (best[1]-P[1])*(best[1]-P[1]) + (best[2]-P[2])*(best[2]-P[2]);
+	bool gauss_newton = false;
+	Real scale = 1.0;
+	int axis = 0;		// 0 steps both s and t, 1 holds t and 2 holds s
+	for (int iteration=0;iteration<_max_iterations;iteration++)
+	{
+		const Real *Su = best+3, *Sv = best+6;
+		Real r[3] = {best[0]-P[0], best[1]-P[1], best[2]-P[2]};
+		Real f_s = dot3(r, Su), f_t = dot3(r, Sv);
+		Real a = dot3(Su, Su), b = dot3(Su, Sv), c = dot3(Sv, Sv);
+		if (!gauss_newton)
+		{
+			Real a2 = a + dot3(r, best+9), b2 = b + dot3(r, best+12), c2 = c + dot3(r, best+15);
+			// Only a positive definite Hessian leads to a minimum.
+			if (a2 > 0.0 && a2*c2 - b2*b2 > 0.0) { a = a2; b = b2; c = c2; }
+		}
+		// A parameter on an edge of the T-face is held there while the distance descends outwards,
+		// the step goes on along the edge only.
+		bool hold_s = axis == 2 || (s <= face.s_min && f_s > 0.0) || (s >= face.s_max && f_s < 0.0);
+		bool hold_t = axis == 1 || (t <= face.t_min && f_t > 0.0) || (t >= face.t_max && f_t < 0.0);
+		bool stalled = hold_s && hold_t;
+		Real next_s = s, next_t = t;
+		if (hold_s && !hold_t)
+		{
+			if (c <= 0.0) stalled = true;
+			else next_t = t - scale * f_t / c;
+		}
+		else if (hold_t && !hold_s)
+		{
+			if (a <= 0.0) stalled = true;
+			else next_s = s - scale * f_s / a;
+		}
+		else if (!stalled)
+		{
+			Real det = a*c - b*b;
+			if (det <= 0.0) stalled = true;
+			else
+			{
+				next_s = s - scale * (c*f_s - b*f_t) / det;
+				next_t = t - scale * (a*f_t - b*f_s) / det;
+			}
+		}
+		next_s = max(face.s_min, min(face.s_max, next_s));
+		next_t = max(face.t_min, min(face.t_max, next_t));
+		if (stalled || (fabs(next_s - s) <= tolerance_s && fabs(next_t - t) <= tolerance_t))
+		{
+			if (axis == 2) break;
+			axis++; gauss_newton = false; scale = 1.0;
+			continue;
+		}
+
+		face.equation->computeDerivatives(next_s, next_t, 2, derivatives);
+		Real q[3] = {derivatives[0]-P[0], derivatives[1]-P[1], derivatives[2]-P[2]};
+		Real d2 = dot3(q, q);
+		if (d2 < best_d2)
+		{
+			best_d2 = d2; s = next_s; t = next_t;
+			std::copy(derivatives, derivatives+18, best);
+			gauss_newton = false; scale = 1.0;
+		}
+		else if (!gauss_newton)
+		{
+			gauss_newton = true;
+		}
+		else if (scale > MIN_SCALE)
+		{
+			scale *= 0.5;
+		}
+		else
+		{
+			if (axis == 2) break;
+			axis++; gauss_newton = false; scale = 1.0;
+		}
+	}
+	return best_d2;
+}
+
+void TProjector::fillProjection( const Face &face, const Point3D &point, const Parameter &parameter, TProjection &projection ) const
+{
+	Real derivatives[9];
+	face.equation->computeDerivatives(parameter.s(), parameter.t(), 1, derivatives);
+	projection.face = face.face;
+	projection.parameter = parameter;
+	projection.point = Point3D(derivatives[0], derivatives[1], derivatives[2]);
+	Vector3D dsdu(derivatives[3], derivatives[4], derivatives[5]);
+	Vector3D dsdv(derivatives[6], derivatives[7], derivatives[8]);
+	projection.normal = dsdu * dsdv; projection.normal.normalize();
+	projection.distance = (projection.point - point).norm2();
+}
+
+int TProjector::project( const Point3D &point, TProjection &projection ) const
+{
+	projection = TProjection();
+	int best_face = -1;
+	Parameter best_parameter;
+	auto visitor = [&](int index, Real, Real bound2) -> Real
+	{
+		Parameter parameter;
+		Real d2 = closestPoint(_faces[index], point, parameter);
+		if (d2 < bound2)
+		{
+			best_face = index;
+			best_parameter = parameter;
+			return d2;
+		}
+		return bound2;
+	};
+	_hierarchy.visitNearest(point, std::numeric_limits<Real>::max(), visitor);
+	if (best_face < 0) return 0;
+
+	fillProjection(_faces[best_face], point, best_parameter, projection);
+	return 1;
+}
+
+int TProjector::project( const std::vector<Point3D> &points, std::vector<TProjection> &projections ) const
+{
+	projections.resize(points.size());
+	int n = (int)points.size(), count = 0;
+#ifdef USE_OMP
+#pragma omp parallel for schedule(dynamic, 64) reduction(+:count)
+#endif
+	for (int i=0;i<n;i++)
+	{
+		count += project(points[i], projections[i]);
+	}
+	return count;
+}
+
+int TProjector::projectOnFace( const TFacePtr &face, const Point3D &point, TProjection &projection ) const
+{
+	projection = TProjection();
+	std::map<TFacePtr, int>::const_iterator found = _indices.find(face);
+	if (found == _indices.end()) return 0;
+
+	Parameter parameter;
+	closestPoint(_faces[found->second], point, parameter);
+	fillProjection(_faces[found->second], point, parameter, projection);
+	return 1;
+}
+
+#ifdef use_namespace
+}
+#endif
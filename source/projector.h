@@ -0,0 +1,130 @@
+/*
+T-SPLINE -- A T-spline object oriented library in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 2.1 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building,
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+- Created.
+-------------------------------------------------------------------------------
+*/
+
+/**  @file  [projector]
+  *  @brief  Projection of points onto a T-spline surface.
+  *  @author  <agent>
+  *  @date  <2026.10.19>
+  *  @version  <v1.0>
+  *  @note
+  *  This file contains the projector which finds the closest points on a T-spline surface (point inversion).
+*/
+
+#ifndef PROJECTOR_H
+#define PROJECTOR_H
+
+#include <utils.h>
+#include <tspline.h>
+#include <splbase.h>
+#include <bvh.h>
+#include <compiler.h>
+
+#ifdef use_namespace
+namespace TSPLINE {
+	using namespace NEWMAT;
+#endif
+
+DECLARE_SMARTPTR(TProjector);
+
+/** The closest point of a projection. */
+struct TProjection
+{
+	TProjection() : distance(-1.0) {}
+	TFacePtr face;			/** The T-face of the closest point, 0 if the projection failed. */
+	Parameter parameter;	/** The parameter (s, t) of the closest point. */
+	Point3D point;			/** The closest point on the surface. */
+	Vector3D normal;		/** The unit normal of the surface at the closest point. */
+	Real distance;			/** The distance from the projected point to the closest point. */
+};
+
+/**
+  *  @class  <TProjector>
+  *  @brief  T-spline projector
+  *  @note
+  *  The projector compiles the blending equation of every T-face once (see TDerivator::prepareEquationByTFace)
+  *  and bounds each T-face by the box of its blending T-points, which contains the surface of the T-face for
+  *  positive weights. A query visits the T-faces nearest first through a BoundingVolumeHierarchy and skips
+  *  those whose boxes are farther than the closest point found so far. On a T-face the closest point starts
+  *  from the nearest local minima of a grid of samples and is refined by Newton iterations on the first and second
+  *  derivatives, clamped to the T-face. The queries are const and may run on many threads at the same time.
+*/
+class TProjector
+{
+public:
+	TProjector(const TSplinePtr &spline, int resolution = 4);
+	~TProjector();
+public:
+	/** Set the tolerance of the Newton iterations relative to the size of the T-face. */
+	void setTolerance(Real tolerance) {_tolerance = tolerance;}
+	/** Set the maximum number of Newton iterations. */
+	void setMaxIterations(int iterations) {_max_iterations = iterations;}
+	/** Return the number of T-faces. */
+	int sizeFaces() const {return (int)_faces.size();}
+	/** Get the bounding volume hierarchy of the T-faces. */
+	const BoundingVolumeHierarchy &getHierarchy() const {return _hierarchy;}
+public:
+	/** Project the point onto the T-spline surface, return 0 if there is no T-face. */
+	int project(const Point3D &point, TProjection &projection) const;
+	/** Project the points on all the threads, return the number of points projected. */
+	int project(const std::vector<Point3D> &points, std::vector<TProjection> &projections) const;
+	/** Project the point onto the T-face only, return 0 if the T-face is not in the T-spline. */
+	int projectOnFace(const TFacePtr &face, const Point3D &point, TProjection &projection) const;
+protected:
+	struct Face : public TCompiledFace
+	{
+		std::vector<Parameter> samples;
+		std::vector<Point3D> points;	/** The points of the samples. */
+	};
+	void compileFace(const TSplinePtr &spline, const TFacePtr &tface, Face &face, BoundingBox &box);
+	/** Find the closest point on the T-face, return the squared distance. */
+	Real closestPoint(const Face &face, const Point3D &point, Parameter &parameter) const;
+	/** Refine (s, t) by the Newton iterations, return the squared distance. */
+	Real refine(const Face &face, const Point3D &point, Real &s, Real &t) const;
+	void fillProjection(const Face &face, const Point3D &point, const Parameter &parameter, TProjection &projection) const;
+private:
+	int _resolution;
+	Real _tolerance;
+	int _max_iterations;
+	std::vector<Face> _faces;
+	std::map<TFacePtr, int> _indices;
+	BoundingVolumeHierarchy _hierarchy;
+};
+
+#ifdef use_namespace
+}
+#endif
+
+#endif
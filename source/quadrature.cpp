@@ -0,0 +1,294 @@
+/*
+TSPLINE -- A T-spline object oriented package in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 3.0 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building,
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+   - Created.
+-------------------------------------------------------------------------------
+*/
+
+#include <quadrature.h>
+
+#ifdef use_namespace
+namespace TSPLINE {
+	using namespace NEWMAT;
+#endif
+
+/** The largest order (degree + 1) of the Bernstein polynomials, the same as TBezierExtractor. */
+static const int MAX_ORDER = 6;
+
+/** The Bernstein polynomials of the degree at x in [0, 1] and their derivatives. */
+static void bernstein(int degree, Real x, Real *values, Real *derivatives)
+{
+	// The polynomials of one degree less by the triangle of de Casteljau give the derivatives.
+	Real lower[MAX_ORDER] = {1.0};
+	for (int p=1;p<degree;p++)
+	{
+		for (int i=p;i>0;i--) lower[i] = (1.0-x)*lower[i] + x*lower[i-1];
+		lower[0] *= 1.0-x;
+	}
+	for (int i=0;i<=degree;i++)
+	{
+		Real left = i > 0 ? lower[i-1] : 0.0, right = i < degree ? lower[i] : 0.0;
+		values[i] = x*left + (1.0-x)*right;
+		derivatives[i] = degree * (left - right);
+	}
+	if (degree == 0)
+	{
+		values[0] = 1.0;
+		derivatives[0] = 0.0;
+	}
+}
+
+TQuadratureBasis::TQuadratureBasis( const TSplinePtr &spline, int order /*= 4*/ ) :
+	_order(order < 1 ? 1 : order),
+	_extractor(spline)
+{
+	_point_weights.resize(_extractor.sizePoints());
+	for (int i=0;i<(int)_point_weights.size();i++) _point_weights[i] = _extractor.getPoint(i)->getW();
+
+	int n = _extractor.sizeFaces();
+	_patches.resize(n);
+#ifdef USE_OMP
+#pragma omp parallel for schedule(dynamic, 4)
+#endif
+	for (int i=0;i<n;i++)
+	{
+		_extractor.extractFace(_extractor.getFace(i), _patches[i], true);
+	}
+	for (int i=0;i<n;i++) _indices[_extractor.getFace(i)] = i;
+
+	_gauss_points.resize(_order);
+	_gauss_weights.resize(_order);
+	gaussLegendre(_order, &_gauss_points[0], &_gauss_weights[0]);
+}
+
+TQuadratureBasis::~TQuadratureBasis()
+{
+
+}
+
+int TQuadratureBasis::findIndex( const TFacePtr &face ) const
+{
+	std::map<TFacePtr, int>::const_iterator found = _indices.find(face);
+	return found == _indices.end() ? -1 : found->second;
+}
+
+int TQuadratureBasis::sizeCells() const
+{
+	int count = 0;
+	for (int i=0;i<(int)_patches.size();i++) count += (int)_patches[i].size();
+	return count;
+}
+
+int TQuadratureBasis::evaluate( std::vector<TQuadratureCell> &cells ) const
+{
+	int n = (int)_patches.size();
+	std::vector<std::vector<TQuadratureCell> > results(n);
+#ifdef USE_OMP
+#pragma omp parallel for schedule(dynamic, 4)
+#endif
+	for (int i=0;i<n;i++)
+	{
+		evaluateFace(i, results[i]);
+	}
+
+	cells.clear();
+	cells.reserve(sizeCells());
+	for (int i=0;i<n;i++)
+	{
+		cells.insert(cells.end(), results[i].begin(), results[i].end());
+	}
+	return (int)cells.size();
+}
+
+int TQuadratureBasis::evaluateFace( int index, std::vector<TQuadratureCell> &cells ) const
+{
+	const std::vector<TBezierPatch> &patches = _patches[index];
+	cells.resize(patches.size());
+	for (int i=0;i<(int)patches.size();i++)
+	{
+		evaluateCell(patches[i], cells[i]);
+	}
+	return (int)cells.size();
+}
+
+void TQuadratureBasis::evaluateCell( const TBezierPatch &patch, TQuadratureCell &cell ) const
+{
+	int nu = patch.degree_s + 1, nv = patch.degree_t + 1, nb = nu * nv;
+	int nfunctions = (int)patch.indices.size(), npoints = _order * _order;
+	Real hs = patch.s_max - patch.s_min, ht = patch.t_max - patch.t_min;
+	cell.face = patch.face;
+	cell.indices = patch.indices;
+	cell.parameters.resize(npoints);
+	cell.weights.resize(npoints);
+	cell.values.resize(3*nfunctions*npoints);
+
+	// The Bernstein polynomials along each direction at the Gauss points, with the derivatives in s and t.
+	std::vector<Real> bu(_order*nu), dbu(_order*nu), bv(_order*nv), dbv(_order*nv);
+	for (int a=0;a<_order;a++)
+	{
+		bernstein(patch.degree_s, _gauss_points[a], &bu[a*nu], &dbu[a*nu]);
+		bernstein(patch.degree_t, _gauss_points[a], &bv[a*nv], &dbv[a*nv]);
+		for (int i=0;i<nu;i++) dbu[a*nu+i] /= hs;
+		for (int j=0;j<nv;j++) dbv[a*nv+j] /= ht;
+	}
+
+	std::vector<Real> b(3*nb);
+	for (int a=0;a<_order;a++)
+	{
+		for (int c=0;c<_order;c++)
+		{
+			int point = a*_order + c;
+			cell.parameters[point] = Parameter(patch.s_min + hs*_gauss_points[a], patch.t_min + ht*_gauss_points[c]);
+			cell.weights[point] = _gauss_weights[a] * _gauss_weights[c] * hs * ht;
+			for (int i=0;i<nu;i++)
+			{
+				for (int j=0;j<nv;j++)
+				{
+					b[3*(i*nv+j)] = bu[a*nu+i] * bv[c*nv+j];
+					b[3*(i*nv+j)+1] = dbu[a*nu+i] * bv[c*nv+j];
+					b[3*(i*nv+j)+2] = bu[a*nu+i] * dbv[c*nv+j];
+				}
+			}
+
+			rationalize(patch, &b[0], 1, &cell.values[3*nfunctions*point]);
+		}
+	}
+}
+
+int TQuadratureBasis::findCell( int index, const Parameter &parameter ) const
+{
+	const std::vector<TBezierPatch> &patches = _patches[index];
+	int nearest = -1;
+	Real best = std::numeric_limits<Real>::max();
+	for (int i=0;i<(int)patches.size();i++)
+	{
+		const TBezierPatch &patch = patches[i];
+		Real ds = max(max(patch.s_min - parameter.s(), parameter.s() - patch.s_max), 0.0);
+		Real dt = max(max(patch.t_min - parameter.t(), parameter.t() - patch.t_max), 0.0);
+		if (ds + dt < best)
+		{
+			best = ds + dt;
+			nearest = i;
+			if (best == 0.0) break;
+		}
+	}
+	return nearest;
+}
+
+void TQuadratureBasis::evaluateAt( int index, int cell, const Parameter &parameter, int order, Real *values ) const
+{
+	const TBezierPatch &patch = _patches[index][cell];
+	int nu = patch.degree_s + 1, nv = patch.degree_t + 1;
+	Real hs = patch.s_max - patch.s_min, ht = patch.t_max - patch.t_min;
+	Real bu[MAX_ORDER], dbu[MAX_ORDER], bv[MAX_ORDER], dbv[MAX_ORDER];
+	bernstein(patch.degree_s, (parameter.s() - patch.s_min) / hs, bu, dbu);
+	bernstein(patch.degree_t, (parameter.t() - patch.t_min) / ht, bv, dbv);
+
+	Real b[3*MAX_ORDER*MAX_ORDER];
+	int stride = order > 0 ? 3 : 1;
+	for (int i=0;i<nu;i++)
+	{
+		for (int j=0;j<nv;j++)
+		{
+			Real *bij = &b[stride*(i*nv+j)];
+			bij[0] = bu[i] * bv[j];
+			if (order <= 0) continue;
+			bij[1] = dbu[i] / hs * bv[j];
+			bij[2] = bu[i] * dbv[j] / ht;
+		}
+	}
+	rationalize(patch, b, order, values);
+}
+
+void TQuadratureBasis::rationalize( const TBezierPatch &patch, const Real *bernstein, int order, Real *values ) const
+{
+	// The weighted blending functions by the extraction operator, then their quotient by the sum.
+	int nb = (int)patch.points.size(), nfunctions = (int)patch.indices.size();
+	int stride = order > 0 ? 3 : 1;
+	Real W[3] = {0.0, 0.0, 0.0};
+	for (int k=0;k<nfunctions;k++)
+	{
+		const Real *row = &patch.operators[k*nb];
+		Real sums[3] = {0.0, 0.0, 0.0};
+		for (int m=0;m<nb;m++)
+		{
+			for (int d=0;d<stride;d++) sums[d] += row[m] * bernstein[stride*m+d];
+		}
+		Real w = patch.indices[k] >= 0 ? _point_weights[patch.indices[k]] : patch.tpoints[k]->getW();
+		for (int d=0;d<stride;d++)
+		{
+			values[stride*k+d] = w * sums[d];
+			W[d] += values[stride*k+d];
+		}
+	}
+	Real inverse = safeDivide(1.0, W[0]);
+	for (int k=0;k<nfunctions;k++)
+	{
+		Real N = values[stride*k] * inverse;
+		if (order > 0)
+		{
+			values[3*k+1] = (values[3*k+1] - N*W[1]) * inverse;
+			values[3*k+2] = (values[3*k+2] - N*W[2]) * inverse;
+		}
+		values[stride*k] = N;
+	}
+}
+
+void TQuadratureBasis::gaussLegendre( int n, Real *points, Real *weights )
+{
+	// Newton iterations on the Legendre polynomial from the asymptotic roots, the points are symmetric.
+	for (int i=0;i<(n+1)/2;i++)
+	{
+		Real x = cos(M_PI * (i + 0.75) / (n + 0.5)), derivative = 1.0;
+		for (int iteration=0;iteration<100;iteration++)
+		{
+			Real p0 = 1.0, p1 = x;
+			for (int k=2;k<=n;k++)
+			{
+				Real p2 = ((2*k-1)*x*p1 - (k-1)*p0) / k;
+				p0 = p1; p1 = p2;
+			}
+			derivative = n * (x*p1 - p0) / (x*x - 1.0);
+			Real dx = p1 / derivative;
+			x -= dx;
+			if (fabs(dx) <= 1e-15) break;
+		}
+		Real weight = 1.0 / ((1.0 - x*x) * derivative * derivative);
+		points[i] = 0.5 * (1.0 - x);
+		points[n-1-i] = 0.5 * (1.0 + x);
+		weights[i] = weights[n-1-i] = weight;
+	}
+}
+
+#ifdef use_namespace
+}
+#endif
@@ -0,0 +1,136 @@
+/*
+T-SPLINE -- A T-spline object oriented library in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 2.1 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building,
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+- Created.
+-------------------------------------------------------------------------------
+*/
+
+/**  @file  [quadrature]
+  *  @brief  Basis functions of a T-spline at the Gauss points.
+  *  @author  <agent>
+  *  @date  <2026.10.19>
+  *  @version  <v1.0>
+  *  @note
+  *  This file contains the sparse evaluation of the T-spline basis functions and their derivatives at the
+  *  Gauss points of the knot cells, used to assemble the matrices of isogeometric analysis (IGA).
+*/
+
+#ifndef QUADRATURE_H
+#define QUADRATURE_H
+
+#include <utils.h>
+#include <tspline.h>
+#include <bezier.h>
+
+#ifdef use_namespace
+namespace TSPLINE {
+	using namespace NEWMAT;
+#endif
+
+DECLARE_SMARTPTR(TQuadratureBasis);
+
+/** The basis functions which are not zero on a knot cell, at its Gauss points. */
+struct TQuadratureCell
+{
+	TFacePtr face;
+	std::vector<Parameter> parameters;	/** The Gauss points in the domain of the T-face, s major. */
+	std::vector<Real> weights;			/** The Gauss weights times the area of the cell in the domain. */
+	std::vector<int> indices;			/** The indices of the T-points whose basis functions are not zero on the cell. */
+	std::vector<Real> values;			/** N, dN/ds and dN/dt of each index at each point, 3 * indices.size() reals per point. */
+};
+
+/**
+  *  @class  <TQuadratureBasis>
+  *  @brief  T-spline basis at the Gauss points
+  *  @note
+  *  The Bezier extraction of every T-face is computed once (see TBezierExtractor). On a knot cell the Bernstein polynomials and
+  *  their derivatives are evaluated at order * order Gauss points, multiplied by the extraction operator into the B-spline
+  *  blending functions b_k, and made rational by the weights of the T-points: N_k = w_k b_k / sum(w_j b_j). The rational basis
+  *  is a partition of unity and its sum with the T-points is the T-spline surface. The indices of the basis functions are
+  *  the ones of TBezierExtractor::getPoint, and the same on all the points of a cell, as an element matrix needs them.
+  *  The T-faces are evaluated independently on all the threads.
+*/
+class TQuadratureBasis
+{
+public:
+	TQuadratureBasis(const TSplinePtr &spline, int order = 4);
+	~TQuadratureBasis();
+public:
+	/** Return the number of Gauss points along each direction of a cell. */
+	int getOrder() const {return _order;}
+	/** Return the number of basis functions, one per T-point. */
+	int sizeFunctions() const {return _extractor.sizePoints();}
+	/** Get the T-point of the indexed basis function. */
+	TPointPtr getPoint(int index) const {return _extractor.getPoint(index);}
+	/** Return the number of T-faces. */
+	int sizeFaces() const {return _extractor.sizeFaces();}
+	/** Get the indexed T-face. */
+	TFacePtr getFace(int index) const {return _extractor.getFace(index);}
+	/** Find the index of the T-face, return -1 if it is not a T-face of the T-spline. */
+	int findIndex(const TFacePtr &face) const;
+	/** Return the number of knot cells of all the T-faces. */
+	int sizeCells() const;
+	/** Return the number of knot cells of the indexed T-face. */
+	int sizeCells(int index) const {return (int)_patches[index].size();}
+	/** Get the indices of the T-points whose basis functions are not zero on the cell of the indexed T-face. */
+	const std::vector<int> &getIndices(int index, int cell) const {return _patches[index][cell].indices;}
+	/** Get the T-points of the indices of the cell of the indexed T-face, also the ones of index -1 outside the T-pointset. */
+	const TPntVector &getTPoints(int index, int cell) const {return _patches[index][cell].tpoints;}
+public:
+	/** Evaluate the basis of the cells of all the T-faces in their order, return the number of cells. */
+	int evaluate(std::vector<TQuadratureCell> &cells) const;
+	/** Evaluate the basis of the cells of the indexed T-face, return the number of cells. */
+	int evaluateFace(int index, std::vector<TQuadratureCell> &cells) const;
+	/** Find the cell of the indexed T-face containing the parameter, or the nearest one, return -1 if there is none. */
+	int findCell(int index, const Parameter &parameter) const;
+	/** Evaluate N, and dN/ds and dN/dt if the order is 1, of the functions of the cell at any parameter, 1 or 3 reals per index. */
+	void evaluateAt(int index, int cell, const Parameter &parameter, int order, Real *values) const;
+	/** Fill the n Gauss-Legendre points and weights on [0, 1]. */
+	static void gaussLegendre(int n, Real *points, Real *weights);
+protected:
+	void evaluateCell(const TBezierPatch &patch, TQuadratureCell &cell) const;
+	/** Turn the Bernstein polynomials (and their derivatives) into the rational basis by the extraction operator of the patch. */
+	void rationalize(const TBezierPatch &patch, const Real *bernstein, int order, Real *values) const;
+private:
+	int _order;
+	TBezierExtractor _extractor;
+	std::vector<Real> _point_weights;	/** The weights of the T-points. */
+	std::vector<std::vector<TBezierPatch> > _patches;	/** The patches of each T-face with the extraction operators. */
+	std::map<TFacePtr, int> _indices;
+	std::vector<Real> _gauss_points, _gauss_weights;
+};
+
+#ifdef use_namespace
+}
+#endif
+
+#endif
@@ -0,0 +1,245 @@
+/*
+TSPLINE -- A T-spline object oriented package in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 3.0 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building,
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+   - Created.
+-------------------------------------------------------------------------------
+*/
+
+#include <raycaster.h>
+#include <algorithm>
+#ifdef USE_OMP
+#include <omp.h>
+#endif
+
+#ifdef use_namespace
+namespace TSPLINE {
+	using namespace NEWMAT;
+#endif
+
+static inline Point3D reciprocal(const Vector3D &direction)
+{
+	// A zero component gives an infinite reciprocal, which the slab tests rely on.
+	return Point3D(1.0 / direction.i(), 1.0 / direction.j(), 1.0 / direction.k());
+}
+
+TRayCaster::TRayCaster( const TSplinePtr &spline, int resolution /*= 16*/ ) :
+	_resolution(resolution < 1 ? 1 : resolution),
+	_tolerance(1e-10),
+	_max_iterations(20),
+	_max_depth(1)
+{
+	TBezierExtractor extractor(spline);
+	_faces.resize(extractor.sizeFaces());
+	std::vector<BoundingBox> boxes(_faces.size());
+	for (int i=0;i<(int)_faces.size();i++)
+	{
+		compileFace(spline, extractor, extractor.getFace(i), _faces[i], boxes[i]);
+	}
+	_hierarchy.build(boxes);
+}
+
+TRayCaster::~TRayCaster()
+{
+
+}
+
+void TRayCaster::compileFace( const TSplinePtr &spline, const TBezierExtractor &extractor, const TFacePtr &tface, Face &face, BoundingBox &box )
+{
+	TFaceCompiler::compileFace(spline, tface, face, box);
+	TFaceCompiler::compilePatches(extractor, face);
+	std::vector<BoundingBox> cells;
+	TFaceCompiler::boundCells(face, _resolution, cells, &face.slabs);
+	face.cells.build(cells);
+}
+
+bool TRayCaster::solve( const Face &face, const TRay &ray, Real &s, Real &t, Real &lambda ) const
+{
+	// Newton iterations on F = S(s, t) - origin - lambda * direction = 0, whose Jacobian has the columns Su, Sv and -direction.
+	Real tolerance_s = _tolerance * (face.s_max - face.s_min), tolerance_t = _tolerance * (face.t_max - face.t_min);
+	const Real O[3] = {ray.origin.x(), ray.origin.y(), ray.origin.z()};
+	const Real D[3] = {-ray.direction.i(), -ray.direction.j(), -ray.direction.k()};
+	Real derivatives[9], c12[3], c[3];
+	Real last_residual = std::numeric_limits<Real>::max();
+	for (int iteration=0;iteration<_max_iterations;iteration++)
+	{
+		face.equation->computeDerivatives(s, t, 1, derivatives);
+		const Real *Su = derivatives+3, *Sv = derivatives+6;
+		Real F[3] = {O[0] - derivatives[0] - lambda*D[0], O[1] - derivatives[1] - lambda*D[1], O[2] - derivatives[2] - lambda*D[2]};
+		// Near the rounding errors of the points the residual stops decreasing before the tolerance is reached.
+		Real residual = sqrt(dot3(F, F));
+		if (residual <= _tolerance * face.size) return true;
+		if (residual >= last_residual && residual <= TFaceCompiler::CELL_MARGIN * face.size) return true;
+		last_residual = residual;
+		cross3(Sv, D, c12);
+		Real det = dot3(Su, c12);
+		if (fabs(det) <= M_EPS * M_EPS) return false;
+		// Cramer's rule, F holds the right hand side -F here.
+		Real step_s = dot3(F, c12) / det;
+		cross3(F, D, c);
+		Real step_t = dot3(Su, c) / det;
+		cross3(Sv, F, c);
+		Real step_lambda = dot3(Su, c) / det;
+		Real next_s = max(face.s_min, min(face.s_max, s + step_s));
+		Real next_t = max(face.t_min, min(face.t_max, t + step_t));
+		lambda += step_lambda;
+		if (fabs(step_s) <= tolerance_s && fabs(step_t) <= tolerance_t)
+		{
+			// A step stopped by an edge of the T-face converges to no hit.
+			s = next_s; t = next_t;
+			return residual <= TFaceCompiler::CELL_MARGIN * face.size;
+		}
+		s = next_s; t = next_t;
+	}
+	return false;
+}
+
+bool TRayCaster::intersectCell( const Face &face, const TRay &ray, const Point3D &inverse, Real s0, Real s1, Real t0, Real t1, 
+	const TCellSlab &slab, Real entry, Real exit, int depth, Real &t_far, Parameter &parameter ) const
+{
+	// The ray must pass between the planes of the slab inside the box.
+	Point3D offset = ray.origin - slab.center;
+	Real approach = slab.normal.x()*ray.direction.i() + slab.normal.y()*ray.direction.j() + slab.normal.z()*ray.direction.k();
+	Real height = slab.normal.x()*offset.x() + slab.normal.y()*offset.y() + slab.normal.z()*offset.z();
+	if (approach != 0.0)
+	{
+		Real near = (-slab.thickness - height) / approach, far = (slab.thickness - height) / approach;
+		entry = max(entry, min(near, far));
+		exit = min(exit, max(near, far));
+		if (entry > exit) return false;
+	}
+	else if (fabs(height) > slab.thickness)
+	{
+		return false;
+	}
+
+	bool found = false;
+	Real s = 0.5*(s0 + s1), t = 0.5*(t0 + t1), lambda = 0.5*(entry + exit);
+	if (solve(face, ray, s, t, lambda) && lambda >= ray.t_min)
+	{
+		if (lambda < t_far)
+		{
+			t_far = lambda;
+			parameter = Parameter(s, t);
+			found = true;
+		}
+		// A hit not behind the cell, even in a neighbouring cell, leaves nothing nearer to search in the cell.
+		if (lambda <= exit) return found;
+	}
+	if (depth >= _max_depth) return found;
+
+	// Subdivide the cell, the sub-cells missed by the ray or behind the nearest hit are pruned.
+	Real s_half = 0.5*(s0 + s1), t_half = 0.5*(t0 + t1);
+	const Real domains[4][4] = {{s0, s_half, t0, t_half}, {s_half, s1, t0, t_half}, {s0, s_half, t_half, t1}, {s_half, s1, t_half, t1}};
+	std::pair<Real, int> order[4];
+	Real exits[4];
+	TCellSlab slabs[4];
+	int count = 0;
+	for (int i=0;i<4;i++)
+	{
+		BoundingBox box;
+		TFaceCompiler::boundCell(face, domains[i][0], domains[i][1], domains[i][2], domains[i][3], box, &slabs[i]);
+		Real near = ray.t_min, far = t_far;
+		if (box.clipRay(ray.origin, inverse, near, far))
+		{
+			exits[i] = far;
+			order[count++] = std::make_pair(near, i);
+		}
+	}
+	std::sort(order, order+count);
+	for (int i=0;i<count;i++)
+	{
+		if (order[i].first > t_far) break;
+		const Real *domain = domains[order[i].second];
+		if (intersectCell(face, ray, inverse, domain[0], domain[1], domain[2], domain[3], slabs[order[i].second], 
+			order[i].first, exits[order[i].second], depth+1, t_far, parameter)) found = true;
+	}
+	return found;
+}
+
+void TRayCaster::fillHit( const Face &face, const Parameter &parameter, Real distance, TRayHit &hit ) const
+{
+	Real derivatives[9];
+	face.equation->computeDerivatives(parameter.s(), parameter.t(), 1, derivatives);
+	hit.face = face.face;
+	hit.parameter = parameter;
+	hit.point = Point3D(derivatives[0], derivatives[1], derivatives[2]);
+	Vector3D dsdu(derivatives[3], derivatives[4], derivatives[5]);
+	Vector3D dsdv(derivatives[6], derivatives[7], derivatives[8]);
+	hit.normal = dsdu * dsdv; hit.normal.normalize();
+	hit.distance = distance;
+}
+
+int TRayCaster::intersect( const TRay &ray, TRayHit &hit ) const
+{
+	hit = TRayHit();
+	Point3D inverse = reciprocal(ray.direction);
+	Real nearest = ray.t_max;
+	int best_face = -1;
+	Parameter best_parameter;
+	auto visitor = [&](int index, Real, Real, Real) -> Real
+	{
+		const Face &face = _faces[index];
+		auto cell_visitor = [&](int cell, Real cell_entry, Real cell_exit, Real) -> Real
+		{
+			Real s0, s1, t0, t1;
+			TFaceCompiler::cellDomain(face, _resolution, cell, s0, s1, t0, t1);
+			if (intersectCell(face, ray, inverse, s0, s1, t0, t1, face.slabs[cell], cell_entry, cell_exit, 
+				0, nearest, best_parameter)) best_face = index;
+			return nearest;
+		};
+		face.cells.visitRay(ray.origin, inverse, ray.t_min, nearest, cell_visitor);
+		return nearest;
+	};
+	_hierarchy.visitRay(ray.origin, inverse, ray.t_min, nearest, visitor);
+	if (best_face < 0) return 0;
+
+	fillHit(_faces[best_face], best_parameter, nearest, hit);
+	return 1;
+}
+
+int TRayCaster::intersect( const std::vector<TRay> &rays, std::vector<TRayHit> &hits ) const
+{
+	hits.resize(rays.size());
+	int n = (int)rays.size(), count = 0;
+#ifdef USE_OMP
+#pragma omp parallel for schedule(dynamic, 64) reduction(+:count)
+#endif
+	for (int i=0;i<n;i++)
+	{
+		count += intersect(rays[i], hits[i]);
+	}
+	return count;
+}
+
+#ifdef use_namespace
+}
+#endif
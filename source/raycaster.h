@@ -0,0 +1,148 @@
+/*
+T-SPLINE -- A T-spline object oriented library in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 2.1 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building,
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+- Created.
+-------------------------------------------------------------------------------
+*/
+
+/**  @file  [raycaster]
+  *  @brief  Intersection of rays with a T-spline surface.
+  *  @author  <agent>
+  *  @date  <2026.10.19>
+  *  @version  <v1.0>
+  *  @note
+  *  This file contains the ray caster which finds the first hits of rays on the exact T-spline surface,
+  *  used for picking and ray casting.
+*/
+
+#ifndef RAYCASTER_H
+#define RAYCASTER_H
+
+#include <utils.h>
+#include <tspline.h>
+#include <splbase.h>
+#include <bvh.h>
+#include <compiler.h>
+#include <limits>
+
+#ifdef use_namespace
+namespace TSPLINE {
+	using namespace NEWMAT;
+#endif
+
+DECLARE_SMARTPTR(TRayCaster);
+
+/** A ray origin + t * direction with t in [t_min, t_max]. */
+struct TRay
+{
+	TRay() : t_min(0.0), t_max(std::numeric_limits<Real>::max()) {}
+	TRay(const Point3D &o, const Vector3D &d) : origin(o), direction(d), t_min(0.0), t_max(std::numeric_limits<Real>::max()) {}
+	Point3D origin;
+	Vector3D direction;
+	Real t_min;
+	Real t_max;
+};
+
+/** The first hit of a ray. */
+struct TRayHit
+{
+	TRayHit() : distance(-1.0) {}
+	TFacePtr face;			/** The T-face hit, 0 if the ray hits nothing. */
+	Parameter parameter;	/** The parameter (s, t) of the hit. */
+	Point3D point;			/** The hit point on the surface. */
+	Vector3D normal;		/** The unit normal of the surface at the hit point. */
+	Real distance;			/** The ray parameter t of the hit, in units of the ray direction, -1 if nothing is hit. */
+};
+
+/**
+  *  @class  <TRayCaster>
+  *  @brief  T-spline ray caster
+  *  @note
+  *  The ray caster compiles the blending equation and the rational Bezier patches (see TBezierExtractor) of
+  *  every T-face once and splits each T-face into resolution * resolution cells of its parameter domain. A cell
+  *  is bounded by the box and by a slab around a plane of the control points of the patches restricted to it,
+  *  which contain the surface of the cell for positive weights; the cells of a T-face are kept in a
+  *  BoundingVolumeHierarchy, and the T-faces, bounded by their blending T-points, in another one. A ray visits
+  *  the cells it hits nearest first and solves S(s, t) = origin + t * direction by Newton iterations from the
+  *  center of each cell; a cell for which Newton finds no hit up to where the ray leaves it is subdivided into
+  *  four, and the sub-cells missed by the ray or behind the nearest hit are pruned. A ray crossing the surface
+  *  twice within one cell may get the farther crossing. The queries are const and may run on many threads at
+  *  the same time.
+*/
+class TRayCaster
+{
+public:
+	TRayCaster(const TSplinePtr &spline, int resolution = 16);
+	~TRayCaster();
+public:
+	/** Set the tolerance of the Newton iterations relative to the size of the T-face and of its domain. */
+	void setTolerance(Real tolerance) {_tolerance = tolerance;}
+	/** Set the maximum number of Newton iterations. */
+	void setMaxIterations(int iterations) {_max_iterations = iterations;}
+	/** Set the maximum number of times a cell is subdivided. */
+	void setMaxDepth(int depth) {_max_depth = depth;}
+	/** Return the number of T-faces. */
+	int sizeFaces() const {return (int)_faces.size();}
+	/** Get the bounding volume hierarchy of the T-faces. */
+	const BoundingVolumeHierarchy &getHierarchy() const {return _hierarchy;}
+public:
+	/** Intersect the ray with the T-spline surface, return 0 if it hits nothing. */
+	int intersect(const TRay &ray, TRayHit &hit) const;
+	/** Intersect the rays on all the threads, return the number of rays which hit. */
+	int intersect(const std::vector<TRay> &rays, std::vector<TRayHit> &hits) const;
+protected:
+	struct Face : public TCompiledFace
+	{
+		std::vector<TCellSlab> slabs;	/** The slabs of the cells, tighter than their boxes for a tilted cell. */
+		BoundingVolumeHierarchy cells;
+	};
+	void compileFace(const TSplinePtr &spline, const TBezierExtractor &extractor, const TFacePtr &tface, Face &face, BoundingBox &box);
+	/** Search a hit nearer than t_far in the cell passed by the ray from entry to exit, return true if one is found. */
+	bool intersectCell(const Face &face, const TRay &ray, const Point3D &inverse, Real s0, Real s1, Real t0, Real t1, 
+		const TCellSlab &slab, Real entry, Real exit, int depth, Real &t_far, Parameter &parameter) const;
+	/** Solve S(s, t) = origin + lambda * direction by Newton iterations, return false if they do not converge. */
+	bool solve(const Face &face, const TRay &ray, Real &s, Real &t, Real &lambda) const;
+	void fillHit(const Face &face, const Parameter &parameter, Real distance, TRayHit &hit) const;
+private:
+	int _resolution;
+	Real _tolerance;
+	int _max_iterations;
+	int _max_depth;
+	std::vector<Face> _faces;
+	BoundingVolumeHierarchy _hierarchy;
+};
+
+#ifdef use_namespace
+}
+#endif
+
+#endif
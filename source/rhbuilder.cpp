@@ -28,7 +28,44 @@ Revision_history:
 */
 #include <rhbuilder.h>
 
-RhBuilder::RhBuilder( const string &filename )
+RhBuilder::RhBuilder( const string &filename ) :
+	_partial(false)
+{
+	buildTObjects(filename);
+	prepareTObjects();
+}
+
+RhBuilder::RhBuilder( const string &filename, const std::vector<std::string> &face_names ) :
+	_partial(true)
+{
+	buildTObjects(filename);
+	for (std::vector<std::string>::const_iterator iter = face_names.begin(); iter != face_names.end(); iter++)
+	{
+		TFacePtr face = _factory->findTObject<TFace>(*iter);
+		if (face) _region.push_back(face);
+	}
+	prepareTObjects(_region);
+}
+
+RhBuilder::RhBuilder( const string &filename, const Parameter &northwest, const Parameter &southeast ) :
+	_partial(true)
+{
+	buildTObjects(filename);
+	ParameterSquare window(northwest, southeast);
+	for (TFacVIterator iter = _faces.begin(); iter != _faces.end(); iter++)
+	{
+		if (!*iter) continue;
+		ParameterSquare square((*iter)->northWest(), (*iter)->southEast());
+		if (square.sMin() <= window.sMax() && square.sMax() >= window.sMin() &&
+			square.tMin() <= window.tMax() && square.tMax() >= window.tMin())
+		{
+			_region.push_back(*iter);
+		}
+	}
+	prepareTObjects(_region);
+}
+
+void RhBuilder::buildTObjects( const string &filename )
 {
 	_parser = makePtr<RhParser>(filename);
 	_factory = makePtr<TFactory>();
@@ -59,8 +96,6 @@ RhBuilder::RhBuilder( const string &filename )
 	patchTFaces(image_spreader);
 	patchTVertices(image_spreader);
 	patchTNodesAndTPoints(connect_spreader);
-
-	prepareTObjects();
 }
 
 RhBuilder::~RhBuilder()
@@ -75,34 +110,34 @@ TSplinePtr RhBuilder::buildTSpline(const RhTsplinePtr &rhtsp)
 
 void RhBuilder::createTSpline(const RhTsplinePtr &rhtsp)
 {
-	_factory->createTSpline(rhtsp->filename);
+	_spline = _factory->createTSpline(rhtsp->filename);
 }
 
 void RhBuilder::createTImage(const RhTsplinePtr &rhtsp)
 {
-	_factory->createTImage("image");
+	_image = _factory->createTImage("image");
 }
 
 void RhBuilder::createTConnect(const RhTsplinePtr &rhtsp)
 {
-	_factory->createTConnect("connect");
+	_connect = _factory->createTConnect("connect");
 }
 
 void RhBuilder::createTPointset(const RhTsplinePtr &rhtsp)
 {
-	_factory->createTPointset("pointset");
+	_pointset = _factory->createTPointset("pointset");
 }
 
 void RhBuilder::createTVertices(const RhImageSpreaderPtr &imgsp)
 {
 	RhVtxVIterator it = imgsp->getVerticesBegin();
 	int i = 1;
+	_vertices.assign(imgsp->getVerticesEnd() - it + 1, TVertexPtr());
 	for(;it!=imgsp->getVerticesEnd();it++,i++)
 	{
 		if(*it)
 		{
-			string name = vId(i);
-			_factory->createTVertex(name, imgsp->getVertexSParameter(i), imgsp->getVertexTParameter(i));
+			_vertices[i] = _factory->createTVertex(vId(i), imgsp->getVertexSParameter(i), imgsp->getVertexTParameter(i));
 		}
 	}
 }
@@ -110,13 +145,13 @@ void RhBuilder::createTVertices(const RhImageSpreaderPtr &imgsp)
 void RhBuilder::createTEdges( const RhTsplinePtr &rhtsp )
 {
 	RhEdgVector &edges = rhtsp->edges;
+	_edges.assign(edges.size() + 1, TEdgePtr());
 	for (int i=1;i<=edges.size();i++)
 	{
 		RhEdgePtr edge = edges[i-1];
 		if (edge)
 		{
-			string name = eId(i);
-			_factory->createTEdge(name);
+			_edges[i] = _factory->createTEdge(eId(i));
 		}
 	}
 }
@@ -124,13 +159,13 @@ void RhBuilder::createTEdges( const RhTsplinePtr &rhtsp )
 void RhBuilder::createTLinks( const RhTsplinePtr &rhtsp )
 {
 	RhLnkVector &links = rhtsp->links;
+	_links.assign(links.size() + 1, TLinkPtr());
 	for (int i=1;i<=links.size();i++)
 	{
 		RhLinkPtr link = links[i-1];
 		if (link)
 		{
-			string name = lId(i);
-			_factory->createTLink(name);
+			_links[i] = _factory->createTLink(lId(i));
 		}
 	}
 }
@@ -138,13 +173,13 @@ void RhBuilder::createTLinks( const RhTsplinePtr &rhtsp )
 void RhBuilder::createTEdgeConditions( const RhTsplinePtr &rhtsp )
 {
 	RhEdgConVector &edge_conditions = rhtsp->edge_conditions;
+	_edge_conditions.assign(edge_conditions.size() + 1, TEdgeConditionPtr());
 	for (int i=1;i<=edge_conditions.size();i++)
 	{
 		RhEdgeConditionPtr edge_condition = edge_conditions[i-1];
 		if (edge_condition)
 		{
-			string name = ecId(i);
-			_factory->createTEdgeCondition(name);
+			_edge_conditions[i] = _factory->createTEdgeCondition(ecId(i));
 		}
 	}
 }
@@ -152,13 +187,13 @@ void RhBuilder::createTEdgeConditions( const RhTsplinePtr &rhtsp )
 void RhBuilder::createTFaces( const RhTsplinePtr &rhtsp )
 {
 	RhFacVector &faces = rhtsp->faces;
+	_faces.assign(faces.size() + 1, TFacePtr());
 	for (int i=1;i<=faces.size();i++)
 	{
 		RhFacePtr face = faces[i-1];
 		if (face)
 		{
-			string name = fId(i);
-			_factory->createTFace(name);
+			_faces[i] = _factory->createTFace(fId(i));
 		}
 	}
 }
@@ -167,12 +202,12 @@ void RhBuilder::createTNodes( const RhConnectSpreaderPtr &consp )
 {
 	RhSmpKntVIterator it = consp->getSimpleKnotsBegin();
 	int i = 1;
+	_nodes.assign(consp->getSimpleKnotsEnd() - it + 1, TNodeV4Ptr());
 	for (;it!=consp->getSimpleKnotsEnd();it++,i++)
 	{
 		if(*it)
 		{
-			string name = nId(i);
-			_factory->createTNodeV4(name);
+			_nodes[i] = _factory->createTNodeV4(nId(i));
 		}
 	}
 }
@@ -180,79 +215,86 @@ void RhBuilder::createTNodes( const RhConnectSpreaderPtr &consp )
 void RhBuilder::createTPoints( const RhTsplinePtr &rhtsp )
 {
 	RhPntVector &points = rhtsp->control_points;
+	_points.assign(points.size() + 1, TPointPtr());
 	for (int i=1;i<=points.size();i++)
 	{
 		RhPointPtr point = points[i-1];
 		if (point)
 		{
-			string name = pId(i);
-			_factory->createTPoint(name, point->x, point->y, point->z, point->w);
+			_points[i] = _factory->createTPoint(pId(i), point->x, point->y, point->z, point->w);
 		}
 	}
 }
 
 void RhBuilder::patchTSpline( const RhTsplinePtr &rhtsp )
 {
-	TSplinePtr spline = _factory->findTSpline();
-	_factory->patchTSpline(spline, "image", "connect", "pointset");
+	_factory->patchTSpline(_spline, "image", "connect", "pointset");
 }
 
 void RhBuilder::patchTImage( const RhTsplinePtr &rhtsp )
 {
-	std::vector<std::string> faces, links, edges, vertices;
-	_factory->findTObjectNames(faces, TSPLINE::E_TFACE);
-	_factory->findTObjectNames(links, TSPLINE::E_TLINK);
-	_factory->findTObjectNames(edges, TSPLINE::E_TEDGE);
-	_factory->findTObjectNames(vertices, TSPLINE::E_TVERTEX);
-	TSplinePtr spline = _factory->findTSpline();
-	TImagePtr image = spline->getTImage();
-	if (image) _factory->patchTImage(image, faces, links, edges, vertices);
+	// The objects are added in the order of their ids, which is also the order they were created.
+	for (TFacVIterator iter = _faces.begin(); iter != _faces.end(); iter++)
+	{
+		if (*iter) _image->addFace(*iter);
+	}
+	for (TLnkVIterator iter = _links.begin(); iter != _links.end(); iter++)
+	{
+		if (*iter) _image->addLink(*iter);
+	}
+	for (TEdgVIterator iter = _edges.begin(); iter != _edges.end(); iter++)
+	{
+		if (*iter) _image->addEdge(*iter);
+	}
+	for (TVtxVIterator iter = _vertices.begin(); iter != _vertices.end(); iter++)
+	{
+		if (*iter) _image->addVertex(*iter);
+	}
 }
 
 void RhBuilder::patchTConnect( const RhTsplinePtr &rhtsp )
 {
-	std::vector<std::string> nodes;
-	_factory->findTObjectNames(nodes, TSPLINE::E_TNODE);
-	TSplinePtr spline = _factory->findTSpline();
-	TConnectPtr connect = spline->getTConnect();
-	if (connect) _factory->patchTConnect(connect, nodes);
+	for (TNodV4VIterator iter = _nodes.begin(); iter != _nodes.end(); iter++)
+	{
+		if (*iter) _connect->addObject(*iter);
+	}
 }
 
 void RhBuilder::patchTPointset( const RhTsplinePtr &rhtsp )
 {
-	std::vector<std::string> points;
-	_factory->findTObjectNames(points, TSPLINE::E_TPOINT);
-	TSplinePtr spline = _factory->findTSpline();
-	TPointsetPtr pointset = spline->getTPointset();
-	if (pointset) _factory->patchTPointset(pointset, points);
+	for (TPntVIterator iter = _points.begin(); iter != _points.end(); iter++)
+	{
+		if (*iter) _pointset->addObject(*iter);
+	}
 }
 
 void RhBuilder::patchTVertices( const RhImageSpreaderPtr &imgsp )
 {
+	// Index the T-links by their start and end T-vertices, the first one wins as TFactory::findTLinkByStartEndVertices.
+	std::map<std::pair<TVertex*, TVertex*>, TLinkPtr> links;
+	for (TLnkVIterator iter = _links.begin(); iter != _links.end(); iter++)
+	{
+		if (*iter) links.insert(std::make_pair(std::make_pair((*iter)->getStartVertex().get(), (*iter)->getEndVertex().get()), *iter));
+	}
+
 	RhVtxVIterator it = imgsp->getVerticesBegin();
 	int i = 1;
-	//Matrix vertex_parameter = imgsp->getVertexParameter();
 	for (;it!=imgsp->getVerticesEnd();it++,i++)
 	{
 		if(*it)
 		{
-			string name = vId(i);
-			string nortvertexname, westvertexname, southvertexname, eastvertexname;
-			int nid, wid, sid, eid;
-			nid = imgsp->getVertexNeighbour(i-1)->getNorthVertex();
-			wid = imgsp->getVertexNeighbour(i-1)->getWestVertex();
-			sid = imgsp->getVertexNeighbour(i-1)->getSouthVertex();
-			eid = imgsp->getVertexNeighbour(i-1)->getEastVertex();
-			if(nid>0)
-				nortvertexname = vId(nid);
-			if(wid>0)
-				westvertexname = vId(wid);
-			if(sid>0)
-				southvertexname = vId(sid);
-			if(eid>0)
-				eastvertexname = vId(eid);
-
-			_factory->patchTVertexByVertices(name, nortvertexname, westvertexname, southvertexname, eastvertexname);
+			TVertexPtr vertex = _vertices[i];
+			RhVertexNeighbourPtr neighbour = imgsp->getVertexNeighbour(i-1);
+			int ids[4] = {neighbour->getNorthVertex(), neighbour->getWestVertex(), 
+				neighbour->getSouthVertex(), neighbour->getEastVertex()};
+			TLinkPtr neighbours[4];
+			for (int k=0;k<4;k++)
+			{
+				std::map<std::pair<TVertex*, TVertex*>, TLinkPtr>::iterator found = 
+					links.find(std::make_pair(vertex.get(), findById(_vertices, ids[k]).get()));
+				if (found != links.end()) neighbours[k] = found->second;
+			}
+			vertex->setNeighbours(neighbours[0], neighbours[1], neighbours[2], neighbours[3]);
 		}
 	}
 }
@@ -265,23 +307,12 @@ void RhBuilder::patchTEdges( const RhImageSpreaderPtr &imgsp )
 	{
 		if(*it)
 		{
-			string name = eId(i);
-			string vstart, vend, fleft, fright;
-			vstart = vId(imgsp->getEdgeNeighbour(i-1)->getVertexStart());
-			vend = vId(imgsp->getEdgeNeighbour(i-1)->getVertexEnd());
-
-			int fl = imgsp->getEdgeNeighbour(i-1)->getFaceLeft();
-			int fr = imgsp->getEdgeNeighbour(i-1)->getFaceRight();
-			if(fl>0)
-				fleft = fId(fl);
-			else
-				fleft = "";
-			if(fr>0)
-				fright = fId(fr);
-			else
-				fright = "";
-
-			_factory->patchTEdge(name, vstart, vend, fleft, fright);
+			RhEdgeNeighbourPtr neighbour = imgsp->getEdgeNeighbour(i-1);
+			TEdgePtr edge = _edges[i];
+			edge->setStartVertex(findById(_vertices, neighbour->getVertexStart()));
+			edge->setEndVertex(findById(_vertices, neighbour->getVertexEnd()));
+			edge->setLeftFace(findById(_faces, neighbour->getFaceLeft()));
+			edge->setRightFace(findById(_faces, neighbour->getFaceRight()));
 		}
 	}
 }
@@ -294,10 +325,8 @@ void RhBuilder::patchTLinks( const RhImageSpreaderPtr &imgsp )
 	{
 		if(*it)
 		{
-			string name = lId(i);
 			bool orientation = getLinkBinaryOrientation(i-1,imgsp);
-			string edgename = eId((*it)->edge + 1);
-			_factory->patchTLink(name, edgename, orientation);
+			_links[i]->setOrientedEdge(findById(_edges, (*it)->edge + 1), orientation);
 		}
 	}
 }
@@ -310,14 +339,12 @@ void RhBuilder::patchTFaces( const RhImageSpreaderPtr &imgsp )
 	{
 		if(*it)
 		{
-			string name = fId(i);
-			vector<string> link_loop_name;
+			TFacePtr face = _faces[i];
 			RhLinkLoopPtr link_loop = imgsp->findRhLinkLoop(imgsp->getLink((*it)->link));
 			for (VIntIterator itt = link_loop->linkIdIteratorBegin();itt!=link_loop->linkIdIteratorEnd();itt++)
 			{
-				link_loop_name.push_back(lId(*itt));
+				face->addLink(findById(_links, *itt));
 			}
-			_factory->patchTFace(name, link_loop_name);
 		}
 	}
 }
@@ -330,22 +357,13 @@ void RhBuilder::patchTNodesAndTPoints( const RhConnectSpreaderPtr &consp )
 	{
 		if(*it)
 		{
-			string name, vertex_name, controlpoint_name, northknot_name, westknot_name, southknot_name, eastknot_name;
-			name = nId(i);
-			vertex_name = vId((*it)->getVertex());
-			controlpoint_name = pId((*it)->getPoint());
-			int nid, wid, sid, eid;
-			nid = (*it)->getNorth();
-			wid = (*it)->getWest();
-			sid = (*it)->getSouth();
-			eid = (*it)->getEast();
-			northknot_name = getNodeName(nid);
-			westknot_name = getNodeName(wid);
-			southknot_name = getNodeName(sid);
-			eastknot_name = getNodeName(eid);
-
-			_factory->patchTNodeV4(name, vertex_name, controlpoint_name, northknot_name, westknot_name, southknot_name, eastknot_name);
-			_factory->patchTPoint(controlpoint_name, name);
+			TNodeV4Ptr node = _nodes[i];
+			TPointPtr point = findById(_points, (*it)->getPoint());
+			node->setTMappableObject(findById(_vertices, (*it)->getVertex()));
+			node->setTPoint(point);
+			node->setNeighbours(findById(_nodes, (*it)->getNorth()), findById(_nodes, (*it)->getWest()), 
+				findById(_nodes, (*it)->getSouth()), findById(_nodes, (*it)->getEast()));
+			if (point) point->setTNode(node);
 		}
 	}
 }
@@ -359,12 +377,8 @@ void RhBuilder::patchTEdgeConditions(const RhTsplinePtr &rhtsp)
 		RhEdgeConditionPtr edge_condition = edge_conditions[i-1];
 		if(edge_condition)
 		{
-			string name = ecId(i);
-			string edge_name = eId(edge_condition->edge+1);//edge_condition->edge, inde by 0; but edge name index by 1
-			if(!edge_condition->boundary_condition)
-				_factory->patchTEdgeCondition(name,edge_name,true);
-			else
-				_factory->patchTEdgeCondition(name,edge_name,false);
+			TEdgePtr edge = findById(_edges, edge_condition->edge+1);//edge_condition->edge, inde by 0; but edge ids index by 1
+			_edge_conditions[i]->setEdgeCondition(edge, !edge_condition->boundary_condition);
 		}
 	}
 }
@@ -418,18 +432,32 @@ bool RhBuilder::getLinkBinaryOrientation(const int linkid, const RhImageSpreader
 	return false;
 }
 
-std::string RhBuilder::getNodeName(int id)
+void RhBuilder::prepareTObjects()
 {
-	if(id>0)
-		return nId(id);
-	else
-		return "";
+	_factory->prepareTNodeHalfLinkages();
+	_factory->prepareTJunctions();
+	_factory->prepareImageConnect();
 }
 
-void RhBuilder::prepareTObjects()
+void RhBuilder::prepareTObjects( const TFacVector &region )
 {
+	// The half linkages and T-junctions decide the knot crosses of all the T-nodes, so they
+	// are prepared in the whole T-image; only the blending T-nodes are restricted to the region.
 	_factory->prepareTNodeHalfLinkages();
 	_factory->prepareTJunctions();
-	_factory->prepareImageConnect();
+	_factory->prepareImageConnect(region);
+}
+
+void RhBuilder::findPreparedTFaces( TFacVector &faces )
+{
+	if (_partial)
+	{
+		faces.insert(faces.end(), _region.begin(), _region.end());
+		return;
+	}
+	for (TFacVIterator iter = _faces.begin(); iter != _faces.end(); iter++)
+	{
+		if (*iter) faces.push_back(*iter);
+	}
 }
 
@@ -56,6 +56,10 @@ class RhBuilder
 public:
 	/** Build the tspline structure from the Rhino T-Spline file. */
 	RhBuilder(const string &filename);
+	/** Build the tspline structure, but prepare the blending T-nodes of the named T-faces only. */
+	RhBuilder(const string &filename, const std::vector<std::string> &face_names);
+	/** Build the tspline structure, but prepare the blending T-nodes of the T-faces touching the parameter window only. */
+	RhBuilder(const string &filename, const Parameter &northwest, const Parameter &southeast);
 	~RhBuilder();
 
 	/** Return the tspline pointer. */
@@ -64,6 +68,10 @@ public:
 	TGroupPtr findTGroup(){return _factory->findTGroup();};
 	/** Find the TFace from face name. */
 	void findTFaceNames(std::vector<std::string> &faces){_factory->findTObjectNames(faces, TSPLINE::E_TFACE);};
+	/** Find the T-faces which can be evaluated, all of them unless a region was requested. */
+	void findPreparedTFaces(TFacVector &faces);
+	/** Return the number of T-junction extension pairs which split the same face along different lines. */
+	int getTJunctionConflicts(){return _factory->getTJunctionConflicts();};
 protected:
 	TSplinePtr buildTSpline(const RhTsplinePtr &rhtsp);
 
@@ -111,31 +119,56 @@ protected:
 	/** Patch TNodes. */
 	void patchTNodesAndTPoints(const RhConnectSpreaderPtr &consp);
 
+	/** Create and patch all the TObjects. */
+	void buildTObjects(const string &filename);
 	/** Prepate TObjects. */
 	void prepareTObjects();
+	/** Prepate TObjects, only the T-faces of the region get their blending T-nodes. */
+	void prepareTObjects(const TFacVector &region);
 private:
 	/** Return the link orientation. */
 	bool getLinkBinaryOrientation(const int linkid, const RhImageSpreaderPtr &imgsp);
-	/** Return node name by id. */
-	string getNodeName(int id);
-
-	/** Create vertex name by id. */
-	string vId(int id) { string s = "v" + to_string((long long)id); return s; }
-	/** Create edge name by id. */
-	string eId(int id) { string s = "e" + to_string((long long)id); return s; }
-	/** Create link name by id. */
-	string lId(int id) { string s = "l" + to_string((long long)id); return s; }
-	/** Create edge condition name by id. */
-	string ecId(int id) { string s = "ec" + to_string((long long)id); return s; }
-	/** Create face name by id. */
-	string fId(int id) { string s = "f" + to_string((long long)id); return s; }
-	/** Create node name by id. */
-	string nId(int id) { string s = "n" + to_string((long long)id); return s; }
-	/** Create point name by id. */
-	string pId(int id) { string s = "p" + to_string((long long)id); return s; }
+	/** Return the object by its 1-based id, 0 if there is none. */
+	template <class T>
+	static std::shared_ptr<T> findById(const std::vector<std::shared_ptr<T> > &objects, int id)
+	{
+		return (id > 0 && id < (int)objects.size()) ? objects[id] : std::shared_ptr<T>();
+	}
+
+	/** Create vertex symbol by id. */
+	int vId(int id) { return TSymbolTable::Instance()->intern("v", id); }
+	/** Create edge symbol by id. */
+	int eId(int id) { return TSymbolTable::Instance()->intern("e", id); }
+	/** Create link symbol by id. */
+	int lId(int id) { return TSymbolTable::Instance()->intern("l", id); }
+	/** Create edge condition symbol by id. */
+	int ecId(int id) { return TSymbolTable::Instance()->intern("ec", id); }
+	/** Create face symbol by id. */
+	int fId(int id) { return TSymbolTable::Instance()->intern("f", id); }
+	/** Create node symbol by id. */
+	int nId(int id) { return TSymbolTable::Instance()->intern("n", id); }
+	/** Create point symbol by id. */
+	int pId(int id) { return TSymbolTable::Instance()->intern("p", id); }
 private:
 	RhParserPtr _parser;
 	TFactoryPtr _factory;
+
+	// The created objects indexed by their 1-based ids in the Rhino T-Spline file, so that
+	// the patches link them directly instead of resolving their symbols in the factory.
+	TSplinePtr _spline;
+	TImagePtr _image;
+	TConnectPtr _connect;
+	TPointsetPtr _pointset;
+	TVtxVector _vertices;
+	TEdgVector _edges;
+	TLnkVector _links;
+	TEdgConVector _edge_conditions;
+	TFacVector _faces;
+	TNodV4Vector _nodes;
+	TPntVector _points;
+
+	bool _partial;
+	TFacVector _region;
 };
 
 #endif
\ No newline at end of file
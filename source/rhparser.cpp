@@ -28,298 +28,434 @@ Revision_history:
 */
 #include <rhparser.h>
 #include <sstream>
+#include <cstring>
+#include <cctype>
+#include <cstdlib>
+#include <clocale>
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+#if !defined(__cpp_lib_to_chars) && defined(__APPLE__)
+#include <xlocale.h>
+#endif
 
-RhParser::RhParser( const string& filename )
+#if !defined(__cpp_lib_to_chars)
+/** The C locale for the numbers, created once, since the application may set another one (QCoreApplication does). */
+#ifdef _WIN32
+static _locale_t numericLocale()
 {
-	readFile(filename);
+	static _locale_t locale = _create_locale(LC_NUMERIC, "C");
+	return locale;
 }
-
-RhTsplinePtr RhParser::readFile( const string& filename )
+#else
+static locale_t numericLocale()
 {
-	std::ifstream fin;
-	fin.open(filename);
-	string cmd;
+	static locale_t locale = newlocale(LC_NUMERIC_MASK, "C", (locale_t)0);
+	return locale;
+}
+#endif
+#endif
 
-	fin >> cmd;
-	if (cmd.compare("#TS0200") != 0) return 0;
-	_rh_tspline = makePtr<RhTspline>();
-	_rh_tspline->filename = filename;
-	skipLine(fin);
+/** Check if the token equals to the tag. */
+static inline bool tokenIs(const char *token, int length, const char *tag)
+{
+	return length == (int)strlen(tag) && strncmp(token, tag, length) == 0;
+}
 
-	fin >> cmd;
-	if (cmd.compare("degree") == 0)
-	{
-		fin >> _rh_tspline->degree;
-	}
-	skipLine(fin);
-	fin >> cmd;
-	if (cmd.compare("cap-type") == 0)
-	{
-		fin >> _rh_tspline->cap_type;
-	}
-	skipLine(fin);
-	fin >> cmd;
-	if (cmd.compare("star-smoothness") == 0)
-	{
-		fin >> _rh_tspline->star_smoothness;
-	}
-	skipLine(fin);
-	fin >> cmd;
-	if (cmd.compare("units") == 0)
-	{
-		fin >> _rh_tspline->unit_value >> _rh_tspline->unit_name;
-	}
-	skipLine(fin);
-	fin >> cmd;
-	if (cmd.compare("force-bezier-end-conditions") == 0)
-	{
-		fin >> _rh_tspline->force_bezier_end_conditions;
-	}
-	skipLine(fin);
-	while (!fin.eof())
+/** Alias the records of an array by smart pointers, a blank record gives a null pointer. */
+template<class T>
+static void aliasRecordArray(const RhRecordsPtr &owner, RhRecordArray<T> &array, std::vector<std::shared_ptr<T> > &pointers)
+{
+	pointers.clear();
+	pointers.reserve(array.slots.size());
+	for (std::vector<int>::const_iterator iter = array.slots.begin(); iter != array.slots.end(); iter++)
 	{
-		fin >> cmd;
-		if (cmd.compare("f") == 0)
-		{
-			extractFace(fin);
-		}
-		else if (cmd.compare("e") == 0)
+		if (*iter < 0)
 		{
-			extractEdge(fin);
+			pointers.push_back(std::shared_ptr<T>());
 		}
-		else if (cmd.compare("ec") == 0)
-		{
-			extractEdgeCondition(fin);
-		}
-		else if (cmd.compare("v") == 0)
-		{
-			extractVertex(fin);
-		}
-		else if (cmd.compare("l") == 0)
-		{
-			extractLink(fin);
-		}
-		else if (cmd.compare("ver") == 0)
-		{
-			extractVersion(fin);
-		}
-		else if (cmd.compare("0m") == 0)
-		{
-			extractMeta(fin);
-		}
-		else if (cmd.compare("0g") == 0)
-		{
-			extractGrip(fin);
-		}
-		else if (cmd.compare("tol") == 0)
+		else
 		{
-			extractTolerance(fin);
+			pointers.push_back(std::shared_ptr<T>(owner, &array.records[*iter]));
 		}
-		else
+	}
+}
+
+RhParser::RhParser( const string& filename ) :
+	_cursor(0), _end(0)
+{
+	readFile(filename);
+}
+
+RhTsplinePtr RhParser::readFile( const string& filename )
+{
+	std::ifstream fin(filename.c_str(), std::ios::in | std::ios::binary);
+	if (!fin) return 0;
+	fin.seekg(0, std::ios::end);
+	std::streamoff size = fin.tellg();
+	if (size <= 0) return 0;
+	fin.seekg(0, std::ios::beg);
+
+	std::vector<char> buffer((size_t)size + 1, '\0');
+	fin.read(&buffer[0], size);
+	size = fin.gcount();
+
+	if (!parseBuffer(&buffer[0], &buffer[0] + size)) return 0;
+	_rh_tspline->filename = filename;
+	return _rh_tspline;
+}
+
+RhTsplinePtr RhParser::parseBuffer( const char *begin, const char *end )
+{
+	_cursor = begin;
+	_end = end;
+
+	const char *token = 0;
+	int length = readToken(token);
+	if (!tokenIs(token, length, "#TS0200")) return 0;
+	_rh_tspline = makePtr<RhTspline>();
+	_records = makePtr<RhRecords>();
+	skipLine();
+
+	while ((length = readToken(token)) > 0)
+	{
+		bool known = false;
+		switch (token[0])
 		{
-			skipLine(fin);
+		case 'f':
+			if (length == 1)
+			{
+				extractFace(); known = true;
+			}
+			else if (tokenIs(token, length, "force-bezier-end-conditions"))
+			{
+				readInt(_rh_tspline->force_bezier_end_conditions); skipLine(); known = true;
+			}
+			break;
+		case 'e':
+			if (length == 1)
+			{
+				extractEdge(); known = true;
+			}
+			else if (tokenIs(token, length, "ec"))
+			{
+				extractEdgeCondition(); known = true;
+			}
+			break;
+		case 'v':
+			if (length == 1)
+			{
+				extractVertex(); known = true;
+			}
+			else if (tokenIs(token, length, "ver"))
+			{
+				extractVersion(); known = true;
+			}
+			break;
+		case 'l':
+			if (length == 1)
+			{
+				extractLink(); known = true;
+			}
+			break;
+		case '0':
+			if (tokenIs(token, length, "0m"))
+			{
+				extractMeta(); known = true;
+			}
+			else if (tokenIs(token, length, "0g"))
+			{
+				extractGrip(); known = true;
+			}
+			break;
+		case 't':
+			if (tokenIs(token, length, "tol"))
+			{
+				extractTolerance(); known = true;
+			}
+			break;
+		case 'd':
+			if (tokenIs(token, length, "degree"))
+			{
+				readInt(_rh_tspline->degree); skipLine(); known = true;
+			}
+			break;
+		case 'c':
+			if (tokenIs(token, length, "cap-type"))
+			{
+				readInt(_rh_tspline->cap_type); skipLine(); known = true;
+			}
+			break;
+		case 's':
+			if (tokenIs(token, length, "star-smoothness"))
+			{
+				readInt(_rh_tspline->star_smoothness); skipLine(); known = true;
+			}
+			break;
+		case 'u':
+			if (tokenIs(token, length, "units"))
+			{
+				readReal(_rh_tspline->unit_value);
+				length = readToken(token);
+				_rh_tspline->unit_name.assign(token, length);
+				skipLine(); known = true;
+			}
+			break;
+		default:
+			break;
 		}
+		if (!known) skipLine();
 	}
+
+	aliasRecords();
 	return _rh_tspline;
 }
 
-bool RhParser::extractFace( ifstream &s )
+bool RhParser::extractFace()
 {
-	if (!detectLine(s))
+	if (!detectLine())
 	{
-		_rh_tspline->faces.push_back(0);
-		skipLine(s);
+		_records->faces.appendBlank();
+		skipLine();
 		return false;
 	}
-	RhFacePtr face = makePtr<RhFace>();
-	s >> face->link >> face->flag;
-	skipLine(s);
-	_rh_tspline->faces.push_back(face);
-	return castBool(face);
+	RhFace &face = _records->faces.append();
+	readInt(face.link); readInt(face.flag);
+	skipLine();
+	return true;
 }
 
-bool RhParser::extractEdge( ifstream &s )
+bool RhParser::extractEdge()
 {
-	if (!detectLine(s))
+	if (!detectLine())
 	{
-		_rh_tspline->edges.push_back(0);
-		skipLine(s);
+		_records->edges.appendBlank();
+		skipLine();
 		return false;
 	}
-	RhEdgePtr edge = makePtr<RhEdge>();
-	s >> edge->link >> edge->interval;
-	skipLine(s);
-	_rh_tspline->edges.push_back(edge);
-	return castBool(edge);
+	RhEdge &edge = _records->edges.append();
+	readInt(edge.link); readReal(edge.interval);
+	skipLine();
+	return true;
 }
 
-bool RhParser::extractVertex( ifstream &s )
+bool RhParser::extractVertex()
 {
-	if (!detectLine(s))
+	if (!detectLine())
 	{
-		_rh_tspline->vertices.push_back(0);
-		skipLine(s);
+		_records->vertices.appendBlank();
+		skipLine();
 		return false;
 	}
-	RhVertexPtr vertex = makePtr<RhVertex>();
-	s >> vertex->link >> vertex->direction;
-	skipLine(s);
-	_rh_tspline->vertices.push_back(vertex);
-	return castBool(vertex);
+	RhVertex &vertex = _records->vertices.append();
+	readInt(vertex.link);
+	const char *token = 0;
+	int length = readToken(token);
+	vertex.direction.assign(token, length);
+	skipLine();
+	return true;
 }
 
-bool RhParser::extractLink( ifstream &s )
+bool RhParser::extractLink()
 {
-	if (!detectLine(s))
+	if (!detectLine())
 	{
-		_rh_tspline->links.push_back(0);
-		skipLine(s);
+		_records->links.appendBlank();
+		skipLine();
 		return false;
 	}
-	RhLinkPtr link = makePtr<RhLink>();
-	s >> link->previous_link >> link->next_link >> link->opp_link 
-		>> link->vertex >> link->face >> link->edge >> link->flag;
-	skipLine(s);
-	_rh_tspline->links.push_back(link);
-	return castBool(link);
+	RhLink &link = _records->links.append();
+	readInt(link.previous_link); readInt(link.next_link); readInt(link.opp_link);
+	readInt(link.vertex); readInt(link.face); readInt(link.edge); readInt(link.flag);
+	skipLine();
+	return true;
 }
 
-bool RhParser::extractEdgeCondition( ifstream &s )
+bool RhParser::extractEdgeCondition()
 {
-	if (!detectLine(s))
+	if (!detectLine())
 	{
-		_rh_tspline->edge_conditions.push_back(0);
-		skipLine(s);
+		_records->edge_conditions.appendBlank();
+		skipLine();
 		return false;
 	}
-	RhEdgeConditionPtr edge_condition = makePtr<RhEdgeCondition>();
-	s >> edge_condition->edge >> edge_condition->boundary_condition;
-	skipLine(s);
-	_rh_tspline->edge_conditions.push_back(edge_condition);
-	return castBool(edge_condition);
+	RhEdgeCondition &edge_condition = _records->edge_conditions.append();
+	readInt(edge_condition.edge); readInt(edge_condition.boundary_condition);
+	skipLine();
+	return true;
 }
 
-bool RhParser::extractMeta( ifstream &s )
+bool RhParser::extractMeta()
 {
-	if (!detectLine(s))
+	if (!detectLine())
 	{
-		_rh_tspline->vertices.push_back(0);
-		skipLine(s);
+		skipLine();
 		return false;
 	}
-	string p1; s >> p1;
-	if (p1.compare("odd-grip-map") == 0)
+	const char *p1 = 0;
+	int length = readToken(p1);
+	if (tokenIs(p1, length, "odd-grip-map"))
 	{
 		_rh_tspline->odd_grip_map = true;
 	}
-	else if (p1.compare("gvp") == 0)
+	else if (tokenIs(p1, length, "gvp"))
 	{
-		RhGripPtr grip = makePtr<RhGrip>();
-		s >> grip->index;
-		grip->with_p = true;
-		_rh_tspline->grips.push_back(grip);
+		RhGrip &grip = _records->grips.append();
+		readInt(grip.index);
+		grip.with_p = true;
 	}
-	else if (p1.compare("gv") == 0)
+	else if (tokenIs(p1, length, "gv"))
 	{
-		RhGripPtr grip = makePtr<RhGrip>();
-		s >> grip->index;
-		grip->with_p = false;
-		_rh_tspline->grips.push_back(grip);
+		RhGrip &grip = _records->grips.append();
+		readInt(grip.index);
+		grip.with_p = false;
 	}
-	else if (p1.compare("cg") == 0)
+	else if (tokenIs(p1, length, "cg"))
 	{
-		RhCompoundGripTagPtr cgt = makePtr<RhCompoundGripTag>();
-		s >> cgt->vertex >> cgt->valence;
-		for (int i=0;i<cgt->valence;i++)
+		RhCompoundGripTag &cgt = _records->compound_grip_tags.append();
+		readInt(cgt.vertex); readInt(cgt.valence);
+		for (int i=0;i<cgt.valence;i++)
 		{
-			int dim = 0; s >> dim;
-			cgt->dims.push_back(dim);
+			int dim = 0; readInt(dim);
+			cgt.dims.push_back(dim);
 		}
-		while (detectLine(s))
+		while (detectLine())
 		{
-			int grip = 0; s >> grip;
-			cgt->grips.push_back(grip);
-			skipBlank(s);
+			int grip = 0;
+			if (!readInt(grip)) break;
+			cgt.grips.push_back(grip);
 		}
-		_rh_tspline->compound_grip_tags.push_back(cgt);
 	}
-	skipLine(s);
+	skipLine();
 	return false;
 }
 
-bool RhParser::extractGrip( ifstream &s )
+bool RhParser::extractGrip()
 {
-	if (!detectLine(s))
+	if (!detectLine())
 	{
-		_rh_tspline->control_points.push_back(0);
-		skipLine(s);
+		_records->control_points.appendBlank();
+		skipLine();
 		return false;
 	}
-	RhPointPtr point = makePtr<RhPoint>();
-	s >> point->x >> point->y >> point->z >> point->w;
-	skipLine(s);
-	_rh_tspline->control_points.push_back(point);
+	RhPoint &point = _records->control_points.append();
+	readReal(point.x); readReal(point.y); readReal(point.z); readReal(point.w);
+	skipLine();
 	return true;
 }
 
-bool RhParser::extractTolerance( ifstream &s )
+bool RhParser::extractTolerance()
 {
-	if (!detectLine(s))
+	if (!detectLine())
 	{
 		_rh_tspline->tolerance = 0.0;
-		skipLine(s);
+		skipLine();
 		return false;
 	}
-	s >> _rh_tspline->tolerance;
-	skipLine(s);
+	readReal(_rh_tspline->tolerance);
+	skipLine();
 	return true;
 }
 
-bool RhParser::extractVersion( ifstream &s )
+bool RhParser::extractVersion()
 {
-	if (!detectLine(s))
+	if (!detectLine())
 	{
 		_rh_tspline->version = 0;
-		skipLine(s);
+		skipLine();
 		return false;
 	}
-	s >> _rh_tspline->version;
-	skipLine(s);
+	readInt(_rh_tspline->version);
+	skipLine();
 	return true;
 }
 
-void RhParser::skipLine( ifstream &s )
+void RhParser::aliasRecords()
 {
-	char c = s.peek();
-	if (c != '\n')
+	_rh_tspline->records = _records;
+	aliasRecordArray(_records, _records->faces, _rh_tspline->faces);
+	aliasRecordArray(_records, _records->edges, _rh_tspline->edges);
+	aliasRecordArray(_records, _records->vertices, _rh_tspline->vertices);
+	aliasRecordArray(_records, _records->links, _rh_tspline->links);
+	aliasRecordArray(_records, _records->edge_conditions, _rh_tspline->edge_conditions);
+	aliasRecordArray(_records, _records->grips, _rh_tspline->grips);
+	aliasRecordArray(_records, _records->compound_grip_tags, _rh_tspline->compound_grip_tags);
+	aliasRecordArray(_records, _records->control_points, _rh_tspline->control_points);
+}
+
+int RhParser::readToken( const char *&token )
+{
+	while (_cursor < _end && isspace((unsigned char)*_cursor)) _cursor++;
+	token = _cursor;
+	while (_cursor < _end && !isspace((unsigned char)*_cursor)) _cursor++;
+	return (int)(_cursor - token);
+}
+
+bool RhParser::readInt( int &value )
+{
+	skipBlank();
+	const char *p = _cursor;
+	bool negative = false;
+	if (p < _end && (*p == '-' || *p == '+'))
 	{
-		char tmp[128];
-		s.get(tmp, 128);
+		negative = (*p == '-'); p++;
 	}
-	else
+	if (p >= _end || *p < '0' || *p > '9') return false;
+	int result = 0;
+	while (p < _end && *p >= '0' && *p <= '9')
 	{
-		char c = s.get();
+		result = result * 10 + (*p - '0'); p++;
 	}
+	value = negative ? -result : result;
+	_cursor = p;
+	return true;
 }
 
-void RhParser::skipBlank( ifstream &s )
+bool RhParser::readReal( Real &value )
 {
-	char t = s.peek();
-	while (t == ' ' || t == '\t')
-	{
-		t = s.get();
-		t = s.peek();
-	}
+	skipBlank();
+	if (_cursor >= _end || *_cursor == '\r' || *_cursor == '\n') return false;
+	// The decimal point is always '.', whatever the locale of the application.
+#if defined(__cpp_lib_to_chars)
+	const char *first = (*_cursor == '+') ? _cursor + 1 : _cursor;
+	double result = 0.0;
+	std::from_chars_result parsed = std::from_chars(first, _end, result);
+	if (parsed.ec != std::errc() || parsed.ptr == first) return false;
+	value = result;
+	_cursor = parsed.ptr;
+#else
+	// The buffer is terminated by a null character, so strtod stops at the end.
+	char *stop = 0;
+#ifdef _WIN32
+	Real result = _strtod_l(_cursor, &stop, numericLocale());
+#else
+	Real result = strtod_l(_cursor, &stop, numericLocale());
+#endif
+	if (stop == _cursor) return false;
+	value = result;
+	_cursor = stop;
+#endif
+	return true;
 }
 
-bool RhParser::detectLine( ifstream &s )
+void RhParser::skipLine()
 {
-	char t = s.peek();
-	if (t == ' ' || t == '\t')
-	{
-		skipBlank(s);
-		t = s.peek();
-	}
+	const char *p = (const char *)memchr(_cursor, '\n', _end - _cursor);
+	_cursor = p ? p + 1 : _end;
+}
+
+void RhParser::skipBlank()
+{
+	while (_cursor < _end && (*_cursor == ' ' || *_cursor == '\t')) _cursor++;
+}
+
+bool RhParser::detectLine()
+{
+	skipBlank();
+	if (_cursor >= _end) return false;
+	char t = *_cursor;
 	if (t == '\r' || t == '\n' || t == '#')
 	{
 		return false;
@@ -328,4 +464,4 @@ bool RhParser::detectLine( ifstream &s )
 	{
 		return true;
 	}
-}
\ No newline at end of file
+}
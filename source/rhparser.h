@@ -54,6 +54,7 @@ DECLARE_ASSISTANCES(RhGrip, RhGrp)
 DECLARE_ASSISTANCES(RhCompoundGripTag, RhCgt)
 DECLARE_ASSISTANCES(RhPoint, RhPnt)
 DECLARE_ASSISTANCES(RhTspline, RhTsp)
+DECLARE_SMARTPTR(RhRecords)
 
 enum E_RDIRECTION {NORTH, WEST, SOUTH, EAST};
 
@@ -168,6 +169,42 @@ struct RhPoint : public RhObject
 	Real x, y, z, w;
 };
 
+/**  
+  *  @class  <RhRecordArray> 
+  *  @brief  Records of one type stored contiguously.  
+  *  @note  
+  *  The records of a type are kept in one array, and every record line of the file has a slot 
+  *  which is the index of its record, or -1 for a blank record.
+*/
+template<class T>
+struct RhRecordArray
+{
+	std::vector<T> records;
+	std::vector<int> slots;
+	/** Append a record and return it. */
+	T &append() { slots.push_back((int)records.size()); records.push_back(T()); return records.back(); }
+	/** Append a blank record. */
+	void appendBlank() { slots.push_back(-1); }
+};
+
+/**  
+  *  @class  <RhRecords> 
+  *  @brief  The record arrays of a rhino T-spline file.  
+  *  @note  
+  *  The smart pointers of RhTspline alias the records, so no record is allocated on its own.
+*/
+struct RhRecords
+{
+	RhRecordArray<RhFace> faces;
+	RhRecordArray<RhEdge> edges;
+	RhRecordArray<RhVertex> vertices;
+	RhRecordArray<RhLink> links;
+	RhRecordArray<RhEdgeCondition> edge_conditions;
+	RhRecordArray<RhGrip> grips;
+	RhRecordArray<RhCompoundGripTag> compound_grip_tags;
+	RhRecordArray<RhPoint> control_points;
+};
+
 /**  
   *  @class  <RhTspline> 
   *  @brief  The definition of RhTspline class.  
@@ -202,6 +239,7 @@ struct RhTspline : public RhObject
 	RhPntVector control_points;
 	Real tolerance;
 	int version;
+	RhRecordsPtr records;
 };
 
 /**  
@@ -209,6 +247,8 @@ struct RhTspline : public RhObject
   *  @brief  The definition of RhParser class.  
   *  @note  
   *  Parse the rhino T-spline format file.  
+  *  The file is read into memory at once and scanned by a cursor, the record tags are dispatched 
+  *  by a switch and the records are stored into the flat arrays of RhRecords.
 */
 class RhParser
 {
@@ -219,38 +259,50 @@ public:
 protected:
 	/** Read file. */
 	RhTsplinePtr readFile(const string& filename);
+	/** Parse the content of a file, which must be followed by a null character. */
+	RhTsplinePtr parseBuffer(const char *begin, const char *end);
 public:
 	/** Return the RhTspline pointer. */
 	RhTsplinePtr getRhTspline() const { return _rh_tspline; }
 
 protected:
-	/** Extract all faces from file. */
-	bool extractFace(ifstream &s);
-	/** Extract all edges from file. */
-	bool extractEdge(ifstream &s);
-	/** Extract all vertices from file. */
-	bool extractVertex(ifstream &s);
-	/** Extract all links from file. */
-	bool extractLink(ifstream &s);
-	/** Extract all edgeconditions from file. */
-	bool extractEdgeCondition(ifstream &s);
-	/** Extract all meta0 from file. */
-	bool extractMeta(ifstream &s);
-	/** Extract all grips from file. */
-	bool extractGrip(ifstream &s);
-	/** Extract tolerance from file. */
-	bool extractTolerance(ifstream &s);
-	/** Extract version from file. */
-	bool extractVersion(ifstream &s);
+	/** Extract a face from the line. */
+	bool extractFace();
+	/** Extract an edge from the line. */
+	bool extractEdge();
+	/** Extract a vertex from the line. */
+	bool extractVertex();
+	/** Extract a link from the line. */
+	bool extractLink();
+	/** Extract an edgecondition from the line. */
+	bool extractEdgeCondition();
+	/** Extract a meta0 from the line. */
+	bool extractMeta();
+	/** Extract a grip from the line. */
+	bool extractGrip();
+	/** Extract tolerance from the line. */
+	bool extractTolerance();
+	/** Extract version from the line. */
+	bool extractVersion();
+	/** Alias the records by the smart pointers of RhTspline. */
+	void aliasRecords();
 
+	/** Read a token, return its length. */
+	int readToken(const char *&token);
+	/** Read an integer on the line. */
+	bool readInt(int &value);
+	/** Read a real on the line. */
+	bool readReal(Real &value);
 	/** Skip one line. */
-	void skipLine(ifstream &s);
+	void skipLine();
 	/** Skip blank. */
-	void skipBlank(ifstream &s);
+	void skipBlank();
 	/** Check if the line has a T-spline element. */
-	bool detectLine(ifstream &s);
+	bool detectLine();
 private:
-
+	const char *_cursor;
+	const char *_end;
+	RhRecordsPtr _records;
 	RhTsplinePtr _rh_tspline;	
 };
 
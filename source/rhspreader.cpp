@@ -412,16 +412,14 @@ void RhImageSpreader::organizeVertexIndices()
 		RhVertexNeighbourPtr vertex_nbr = makePtr<RhVertexNeighbour>();
 		if(_vertices[i])
 		{
-			for (int k=0;k<vertex_s.size();k++)
-			{
-				if(_vertex_paramter(i+1,1) == vertex_s[k])
-					vertex_nbr->setTmeshCol(k);
-			}
-			for (int k=0;k<vertex_t.size();k++)
-			{
-				if(_vertex_paramter(i+1,2) == vertex_t[k])
-					vertex_nbr->setTmeshRow(k);
-			}
+			double s = _vertex_paramter(i+1,1);
+			std::vector<double>::iterator it_s = lower_bound(vertex_s.begin(),vertex_s.end(),s);
+			if(it_s != vertex_s.end() && *it_s == s)
+				vertex_nbr->setTmeshCol(it_s - vertex_s.begin());
+			double t = _vertex_paramter(i+1,2);
+			std::vector<double>::iterator it_t = lower_bound(vertex_t.begin(),vertex_t.end(),t,std::greater<double>());
+			if(it_t != vertex_t.end() && *it_t == t)
+				vertex_nbr->setTmeshRow(it_t - vertex_t.begin());
 		}
 		else
 		{
@@ -431,7 +429,6 @@ void RhImageSpreader::organizeVertexIndices()
 	}
 
 	_tmesh.resize(vertex_t.size(), vertex_s.size());
-	_tmesh = -1;
 }
 
 void RhImageSpreader::generateTMesh()
@@ -440,7 +437,7 @@ void RhImageSpreader::generateTMesh()
 	{
 		if(_vertices[i])
 		{
-			_tmesh(_vertex_nbr[i]->getTmeshRow()+1, _vertex_nbr[i]->getTmeshCol()+1) = i;
+			_tmesh.set(_vertex_nbr[i]->getTmeshRow()+1, _vertex_nbr[i]->getTmeshCol()+1, i);
 		}
 	}
 }
@@ -489,6 +486,40 @@ void RhImageSpreader::setLinkage(const int vertexid, const int linkedvertex, con
 	}
 }
 
+void RhSparseGrid::resize(const int nrows, const int ncols)
+{
+	_rows.clear();
+	_rows.resize(nrows);
+	_ncols = ncols;
+	_size = 0;
+}
+
+int RhSparseGrid::operator()(const int row, const int col) const
+{
+	if(!contains(row,col))
+		return -1;
+	const Row &cells = _rows[row-1];
+	RowConstIterator it = cells.find(col);
+	return it != cells.end() ? it->second : -1;
+}
+
+void RhSparseGrid::set(const int row, const int col, const int index)
+{
+	if(!contains(row,col))
+		return;
+	Row &cells = _rows[row-1];
+	if(index<0)
+	{
+		_size -= (int)cells.erase(col);
+		return;
+	}
+	std::pair<Row::iterator,bool> inserted = cells.insert(std::make_pair(col,index));
+	if(inserted.second)
+		_size++;
+	else
+		inserted.first->second = index;
+}
+
 RotMatrix* RotMatrix::_instance = 0;
 RotMatrix* RotMatrix::Instance()
 {
@@ -520,6 +551,7 @@ Matrix RotMatrix::rot90base(const Matrix &mt)
 }
 
 RhComplexKnot::RhComplexKnot(const int nrows, const int ncols)
+	:_rotation(nrows,ncols)
 {
 	_matrix.resize(nrows,ncols);
 	_matrix = -1;
@@ -529,21 +561,25 @@ RhComplexKnot::RhComplexKnot(const int nrows, const int ncols)
 
 void RhComplexKnot::addSimpleKnot(const RhSimpleKnotPtr &knot, const int row, const int col)
 {
-	if(row > _matrix.nrows() || row<1 || col > _matrix.ncols() || col<1)
+	if(row > _rotation.nrows() || row<1 || col > _rotation.ncols() || col<1)
 		return ;
+	int orow, ocol;
+	_rotation.map(row,col,orow,ocol);
 	_knot.push_back(knot);
-	_matrix(row,col) = _id++;
+	_matrix(orow,ocol) = _id++;
 }
 
 RhSimpleKnotPtr RhComplexKnot::operator()(const int nrows, const int ncols)
 {
-	if(nrows > _matrix.nrows() || nrows<1 || ncols > _matrix.ncols() || ncols<1)
+	if(nrows > _rotation.nrows() || nrows<1 || ncols > _rotation.ncols() || ncols<1)
 		cout<<"out of the range."<<endl;
 	else 
 	{
-		int index = _matrix(nrows,ncols);
+		int orow, ocol;
+		_rotation.map(nrows,ncols,orow,ocol);
+		int index = _matrix(orow,ocol);
 		if(index>-1)
-			return _knot[_matrix(nrows,ncols)];
+			return _knot[index];
 	}
 	return NULL;
 }
@@ -555,15 +591,12 @@ RhComplexKnotPtr RhComplexKnot::asComplex()
 
 void RhComplexKnot::rotate(int num)
 {
-	if(num<0)
-		num += 4;
-	RotMatrix::Instance()->rot90(_matrix,num);
+	_rotation.rotate(num);
 }
 
 RhKnotMatrix::RhKnotMatrix(const int nrows, const int ncols)
 {
 	_matrix.resize(nrows,ncols);
-	_matrix = -1;
 	_id = 0;
 }
 
@@ -575,7 +608,7 @@ RhSimpleKnotPtr RhKnotMatrix::operator()(const int nrows, const int ncols)
 	{
 		int index = _matrix(nrows,ncols);
 		if(index>-1)
-			return _knots[_matrix(nrows,ncols)];
+			return _knots[index];
 	}
 	return NULL;
 }
@@ -585,13 +618,12 @@ void RhKnotMatrix::addKnot(const RhSimpleKnotPtr &knot, const int nrows, const i
 	if(nrows > _matrix.nrows() || nrows<1 || ncols > _matrix.ncols() || ncols<1)
 		return;
 	_knots.push_back(knot);
-	_matrix(nrows,ncols) = _id++;
+	_matrix.set(nrows,ncols,_id++);
 }
 
 RhKnotIdMatrix::RhKnotIdMatrix(const int nrows, const int ncols)
 {
 	_matrix.resize(nrows,ncols);
-	_matrix = -1;
 	_id = 0;
 }
 
@@ -603,7 +635,7 @@ Matrix RhKnotIdMatrix::operator()(const int nrows, const int ncols)
 	{
 		int index = _matrix(nrows,ncols);
 		if(index>-1)
-			return _complexid[_matrix(nrows,ncols)];
+			return _complexid[index];
 	}
 	/*an error has occurd, return a null-matrix*/
 	Matrix m(0,0);
@@ -615,7 +647,7 @@ void RhKnotIdMatrix::addKnotid(const Matrix &id, int row, int col)
 	if(row > _matrix.nrows() || row<1 || col > _matrix.ncols() || col<1)
 		return;
 	_complexid.push_back(id);
-	_matrix(row,col) = _id++;
+	_matrix.set(row,col,_id++);
 }
 
 RhKnotConstruct::RhKnotConstruct(const RhGrpVector &grips, const RhCgtVector &cgs, const int vsize)
@@ -671,16 +703,18 @@ RhConnectSpreader::RhConnectSpreader(const RhTsplinePtr &rhtsp, const RhImageSpr
 	deriveKnotLinkages(imgspr->getTmesh());
 }
 
-void RhConnectSpreader::constructKnotMatrix(const Matrix &tmesh)
+void RhConnectSpreader::constructKnotMatrix(const RhSparseGrid &tmesh)
 {
 	int nrows = tmesh.nrows();
 	int ncols = tmesh.ncols();
 	_knot_matrix = makePtr<RhKnotMatrix>(nrows, ncols);
 	for (int i=1;i<=nrows;i++)
 	{
-		for (int j=1;j<=ncols;j++)
+		const RhSparseGrid::Row &cells = tmesh.row(i);
+		for (RhSparseGrid::RowConstIterator it=cells.begin();it!=cells.end();it++)
 		{
-			int vertexid = tmesh(i,j);
+			int j = it->first;
+			int vertexid = it->second;
 			if(vertexid>=0)
 			{
 				RhSimpleKnotPtr knots = constructKnots(vertexid);
@@ -690,7 +724,7 @@ void RhConnectSpreader::constructKnotMatrix(const Matrix &tmesh)
 	}
 }
 
-void RhConnectSpreader::deriveKnotLinkages(const Matrix &tmesh)
+void RhConnectSpreader::deriveKnotLinkages(const RhSparseGrid &tmesh)
 {
 	int nrows = tmesh.nrows();
 	int ncols = tmesh.ncols();
@@ -699,8 +733,10 @@ void RhConnectSpreader::deriveKnotLinkages(const Matrix &tmesh)
 	int k = 0;
 	for (int i=1;i<=nrows;i++)
 	{
-		for (int j=1;j<=ncols;j++)
+		const RhSparseGrid::Row &cells = tmesh.row(i);
+		for (RhSparseGrid::RowConstIterator it=cells.begin();it!=cells.end();it++)
 		{
+			int j = it->first;
 			RhSimpleKnotPtr smpcpx_knot = (*_knot_matrix.get())(i,j);
 			if(smpcpx_knot)
 			{
@@ -743,8 +779,10 @@ void RhConnectSpreader::deriveKnotLinkages(const Matrix &tmesh)
 
 	for (int i=1;i<=nrows;i++)
 	{
-		for (int j=1;j<=ncols;j++)
+		const RhSparseGrid::Row &cells = _knotid_matrix->row(i);
+		for (RhSparseGrid::RowConstIterator it=cells.begin();it!=cells.end();it++)
 		{
+			int j = it->first;
 			Matrix complexid = (*_knotid_matrix.get())(i,j);
 			if(complexid.size()>0)
 			{
@@ -826,105 +864,21 @@ RhSimpleKnotPtr RhConnectSpreader::constructKnots(const int vertexid)
 	else
 		knotsGrp = makePtr<RhComplexKnot>(nrows,ncols);
 
-	//A wedge
-	Matrix aindices(anrows,ancols);
+	//A wedge, its grips are rotated twice
 	int gripoffset = 0;
-	for (int i=1;i<=anrows*ancols;i++)
-	{
-		aindices(floor((i-1)/(float)ancols)+1,(i-1)%ancols+1) = i;
-	}
-	aindices = RotMatrix::Instance()->rot90(aindices,2);
-	int actualnrows = aindices.nrows();
-	int actualncols = aindices.ncols();
-	for (int i=1;i<=actualnrows;i++)
-	{
-		for (int j=1;j<=actualncols;j++)
-		{
-			int gripindex = aindices(i,j) + gripoffset;
-			RhSimpleKnotPtr knots = makePtr<RhSimpleKnot>();
-			knots->setVertex(vertexid+1);
-			knots->setPoint(mknot->grip(gripindex-1)+1);
-			if(knots->getPoint()!=0)//newmat index
-				knotsGrp->addSimpleKnot(knots,i,j);
-		}
-	}
+	addWedgeKnots(knotsGrp, mknot, vertexid, RhRotation(anrows,ancols,2), gripoffset, 0, 0);
 
-	//B wedge
-	Matrix bindices(bnrows,bncols);
+	//B wedge, three times
 	gripoffset+= anrows*ancols;
-	for (int i=1;i<=bnrows*bncols;i++)
-	{
-		bindices(floor((i-1)/(float)bncols)+1,(i-1)%bncols+1) = i;
-	}
-    Matrix tempb = RotMatrix::Instance()->rot90(bindices,2);
-	bindices = RotMatrix::Instance()->rot90(tempb);
-	actualnrows = bindices.nrows();
-	actualncols = bindices.ncols();
-	for (int i=1;i<=actualnrows;i++)
-	{
-		for (int j=1;j<=actualncols;j++)
-		{
-			int gripindex = bindices(i,j) + gripoffset;
-			RhSimpleKnotPtr knots = makePtr<RhSimpleKnot>();
-			knots->setVertex(vertexid+1);
-			knots->setPoint(mknot->grip(gripindex-1)+1);
-			if(knots->getPoint()!=0)//newmat index
-				knotsGrp->addSimpleKnot(knots,i+anrows,j);
-		}
-	}
+	addWedgeKnots(knotsGrp, mknot, vertexid, RhRotation(bnrows,bncols,3), gripoffset, anrows, 0);
 
-	//C wedge
-	Matrix cindices(cnrows,cncols);
+	//C wedge, four times which keeps it
 	gripoffset+= bnrows*bncols;
-	for (int i=1;i<=cnrows*cncols;i++)
-	{
-		cindices(floor((i-1)/(float)cncols)+1,(i-1)%cncols+1) = i;
-	}
-    Matrix tempc1,tempc2;
-    tempc1 = RotMatrix::Instance()->rot90(cindices,2);
-    tempc2 = RotMatrix::Instance()->rot90(tempc1);
-	cindices = RotMatrix::Instance()->rot90(tempc2);
-	actualnrows = cindices.nrows();
-	actualncols = cindices.ncols();
-	for (int i=1;i<=actualnrows;i++)
-	{
-		for (int j=1;j<=actualncols;j++)
-		{
-			int gripindex = cindices(i,j) + gripoffset;
-			RhSimpleKnotPtr knots = makePtr<RhSimpleKnot>();
-			knots->setVertex(vertexid+1);
-			knots->setPoint(mknot->grip(gripindex-1)+1);
-			if(knots->getPoint()!=0)//newmat index
-				knotsGrp->addSimpleKnot(knots,i+anrows+1,j+bnrows);
-		}
-	}
+	addWedgeKnots(knotsGrp, mknot, vertexid, RhRotation(cnrows,cncols,4), gripoffset, anrows+1, bnrows);
 
-	//D wedge
-	Matrix dindices(dnrows,dncols);
+	//D wedge, five times which is once
 	gripoffset+= cnrows*cncols;
-	for (int i = 1;i<=dnrows*dncols;i++)
-	{
-		dindices(floor((i-1)/(float)dncols)+1,(i-1)%dncols+1) = i;
-	}
-    Matrix tempd1, tempd2, tempd3;
-    tempd1 = RotMatrix::Instance()->rot90(dindices,2);
-    tempd2 = RotMatrix::Instance()->rot90(tempd1);
-    tempd3 = RotMatrix::Instance()->rot90(tempd2);
-	dindices = RotMatrix::Instance()->rot90(tempd3);
-	actualnrows = dindices.nrows();
-	actualncols = dindices.ncols();
-	for (int i=1;i<=actualnrows;i++)
-	{
-		for (int j=1;j<=actualncols;j++)
-		{
-			int gripindex = dindices(i,j) + gripoffset;
-			RhSimpleKnotPtr knots = makePtr<RhSimpleKnot>();
-			knots->setVertex(vertexid+1);
-			knots->setPoint(mknot->grip(gripindex-1)+1);
-			if(knots->getPoint()!=0)//newmat index
-				knotsGrp->addSimpleKnot(knots,i,j+bnrows+1);
-		}
-	}
+	addWedgeKnots(knotsGrp, mknot, vertexid, RhRotation(dnrows,dncols,5), gripoffset, 0, bnrows+1);
 
 	//middle
 	RhSimpleKnotPtr knots = makePtr<RhSimpleKnot>();
@@ -948,6 +902,25 @@ RhSimpleKnotPtr RhConnectSpreader::constructKnots(const int vertexid)
 	return knotsGrp;
 }
 
+void RhConnectSpreader::addWedgeKnots(const RhSimpleKnotPtr &knotsGrp, const RhMKnotPtr &mknot, const int vertexid,
+	const RhRotation &wedge, const int gripoffset, const int rowoffset, const int coloffset)
+{
+	int actualnrows = wedge.nrows();
+	int actualncols = wedge.ncols();
+	for (int i=1;i<=actualnrows;i++)
+	{
+		for (int j=1;j<=actualncols;j++)
+		{
+			int gripindex = wedge.index(i,j) + gripoffset;
+			RhSimpleKnotPtr knots = makePtr<RhSimpleKnot>();
+			knots->setVertex(vertexid+1);
+			knots->setPoint(mknot->grip(gripindex-1)+1);
+			if(knots->getPoint()!=0)//newmat index
+				knotsGrp->addSimpleKnot(knots,i+rowoffset,j+coloffset);
+		}
+	}
+}
+
 int RhConnectSpreader::direction2Orientation(const std::string &direction)
 {
 	if(direction == "EAST")
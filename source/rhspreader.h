@@ -51,6 +51,7 @@ DECLARE_SMARTPTR(RhKnotConstruct);
 DECLARE_SMARTPTR(RhConnectSpreader);
 DECLARE_SMARTPTR(RhKnotMatrix);
 DECLARE_SMARTPTR(RhKnotIdMatrix);
+DECLARE_SMARTPTR(RhSparseGrid);
 DECLARE_ASSISTANCES(RhLinkLoop, RhLnkLup);
 DECLARE_ASSISTANCES(RhEdgeNeighbour, RhEdgNbr);
 DECLARE_ASSISTANCES(RhVertexNeighbour, RhVtxNbr);
@@ -62,6 +63,45 @@ DECLARE_ASSISTANCES(RhComplexKnot, RhCpxKnt);
 typedef vector<int> VInt;
 typedef VInt::iterator VIntIterator;
 
+/**  
+  *  @class  <RhSparseGrid> 
+  *  @brief  Sparse grid of indices.  
+  *  @note  
+  *  RhSparseGrid keeps the occupied cells of a nrows*ncols grid in sorted maps per row, 
+  *  so its memory and iteration scale with the occupied cells, not with the grid area. 
+  *  The rows and columns start from 1 and an empty cell reads -1.
+*/
+class RhSparseGrid
+{
+public:
+	typedef std::map<int, int> Row;
+	typedef Row::const_iterator RowConstIterator;
+public:
+	RhSparseGrid(const int nrows = 0, const int ncols = 0) : _rows(nrows), _ncols(ncols), _size(0) {};
+	~RhSparseGrid(){};
+
+	/** Resize the grid and clear all the cells. */
+	void resize(const int nrows, const int ncols);
+	/** Return the row dimension of the grid. */
+	int nrows() const {return (int)_rows.size();};
+	/** Return the column dimension of the grid. */
+	int ncols() const {return _ncols;};
+	/** Return the number of occupied cells. */
+	int size() const {return _size;};
+	/** Check if (row, col) is inside the grid. */
+	bool contains(const int row, const int col) const {return row>=1 && row<=nrows() && col>=1 && col<=_ncols;};
+	/** Return the index at (row, col), -1 for an empty cell. */
+	int operator()(const int row, const int col) const;
+	/** Set the index at (row, col). */
+	void set(const int row, const int col, const int index);
+	/** Return the occupied cells of a row, ordered by column. */
+	const Row &row(const int row) const {return _rows[row-1];};
+private:
+	vector<Row> _rows;
+	int _ncols;
+	int _size;
+};
+
 /**  
   *  @class  <RhLinkLoop> 
   *  @brief  Linkloop class.  
@@ -256,7 +296,7 @@ public:
 	/** Return t parameter of vertex by index. */
 	Real getVertexTParameter(int index){return _vertex_paramter(index,2);};
 	/** Return the tmesh. */
-	Matrix getTmesh(){return _tmesh;};
+	const RhSparseGrid &getTmesh(){return _tmesh;};
 protected:
 	/** Return the linkloop of the face. */
 	RhLinkLoopPtr getLinkLoop(const RhFacePtr &face);
@@ -287,7 +327,7 @@ private:
 	ColumnVector _link_orientations;	
 	Matrix _vertex_paramter;			
 	ColumnVector _vertex_flag;			
-	Matrix _tmesh;						
+	RhSparseGrid _tmesh;				
 };
 
 /**  
@@ -309,6 +349,51 @@ private:
 	~RotMatrix(){};
 };
 
+/**  
+  *  @class  <RhRotation> 
+  *  @brief  Counter clockwise rotation of a matrix as an index mapping.  
+  *  @note  
+  *  RhRotation maps the (row, col) of a matrix rotated by num*90 degrees counter clockwise, 
+  *  the same as RotMatrix::rot90, to the (row, col) of the original matrix, so the rotated 
+  *  matrix never has to be stored.
+*/
+class RhRotation
+{
+public:
+	RhRotation(const int nrows = 0, const int ncols = 0, const int num = 0)
+		:_nrows(nrows),_ncols(ncols),_num(0){rotate(num);};
+	~RhRotation(){};
+
+	/** Rotate further in counter clockwise by num times. */
+	void rotate(const int num){_num = ((_num + num) % 4 + 4) % 4;};
+	/** Return the row dimension of the rotated matrix. */
+	int nrows() const {return (_num % 2) ? _ncols : _nrows;};
+	/** Return the column dimension of the rotated matrix. */
+	int ncols() const {return (_num % 2) ? _nrows : _ncols;};
+	/** Map (row, col) of the rotated matrix to (orow, ocol) of the original matrix. */
+	void map(const int row, const int col, int &orow, int &ocol) const
+	{
+		switch(_num)
+		{
+		case 1: orow = col; ocol = _ncols + 1 - row; break;
+		case 2: orow = _nrows + 1 - row; ocol = _ncols + 1 - col; break;
+		case 3: orow = _nrows + 1 - col; ocol = row; break;
+		default: orow = row; ocol = col; break;
+		}
+	};
+	/** Map (row, col) of the rotated matrix to the 1-based row by row index in the original matrix. */
+	int index(const int row, const int col) const
+	{
+		int orow, ocol;
+		map(row,col,orow,ocol);
+		return (orow-1)*_ncols + ocol;
+	};
+private:
+	int _nrows;
+	int _ncols;
+	int _num;
+};
+
 /**  
   *  @class  <RhKnot> 
   *  @brief  Knot class.  
@@ -454,12 +539,13 @@ public:
 	void rotate(int num);
 
 	/** Return the row dimension of the RhComplexKnot. */
-	int nrows(){return _matrix.nrows();};
+	int nrows(){return _rotation.nrows();};
 	/** Return the column dimension of the RhComplexKnot. */
-	int ncols(){return _matrix.ncols();};
+	int ncols(){return _rotation.ncols();};
 private:
 	RhSmpKntVector _knot;	
 	Matrix _matrix;
+	RhRotation _rotation;
 	int _id;
 };
 
@@ -482,7 +568,7 @@ public:
 	void addKnot(const RhSimpleKnotPtr &knot, const int nrows, const int ncols);
 private:
 	RhSmpKntVector _knots;
-	Matrix _matrix;
+	RhSparseGrid _matrix;
 	int _id;
 };
 
@@ -503,9 +589,11 @@ public:
 
 	/** Add KnotId Matrix to the RhKnotIdMatrix. */
 	void addKnotid(const Matrix &id, const int nrows, const int ncols);
+	/** Return the occupied cells of a row, ordered by column. */
+	const RhSparseGrid::Row &row(const int nrows) const {return _matrix.row(nrows);};
 private:
 	vector<Matrix> _complexid;
-	Matrix _matrix;
+	RhSparseGrid _matrix;
 	int _id;
 };
 
@@ -559,9 +647,9 @@ public:
 	~RhConnectSpreader(){};
 
 	/** Construct knot matrix . */
-	void constructKnotMatrix(const Matrix &tmesh);
+	void constructKnotMatrix(const RhSparseGrid &tmesh);
 	/** Derive the neighbours of all knots . */
-	void deriveKnotLinkages(const Matrix &tmesh);
+	void deriveKnotLinkages(const RhSparseGrid &tmesh);
 	/** Return RhSimpleKnot by index . */
 	RhSimpleKnotPtr getSimpleKnot(int index){return _simple_knots[index];};
 	/** Return the begin iterator of RhSimpleKnots. */
@@ -571,6 +659,9 @@ public:
 protected:
 	/** Construct RhSimpleKnot by vertex id . */
 	RhSimpleKnotPtr constructKnots(const int vertexid);
+	/** Add the knots of a wedge, whose grips are numbered row by row and then rotated, into the knot group. */
+	void addWedgeKnots(const RhSimpleKnotPtr &knotsGrp, const RhMKnotPtr &mknot, const int vertexid,
+		const RhRotation &wedge, const int gripoffset, const int rowoffset, const int coloffset);
 	/** Convert direction to orientation . */
 	int direction2Orientation(const std::string &direction);
 	/** Return the rotation angle by orientation . */
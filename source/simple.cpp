@@ -432,3 +432,8 @@ void SimpleDemo::findTFaceNames( std::vector<std::string> &faces )
 {
 	_factory->findTObjectNames(faces, TSPLINE::E_TFACE);
 }
+
+int SimpleDemo::getTJunctionConflicts()
+{
+	return _factory->getTJunctionConflicts();
+}
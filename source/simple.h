@@ -75,6 +75,8 @@ public:
 	TGroupPtr findTGroup();
 	/** Find all the T-face names. */
 	void findTFaceNames(std::vector<std::string> &faces);
+	/** Return the number of T-junction extension pairs which split the same face along different lines. */
+	int getTJunctionConflicts();
 protected:
 	void createTSpline();
 	void createTImage();
@@ -0,0 +1,420 @@
+/*
+T-SPLINE -- A T-spline object oriented library in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 2.1 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building,
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+   - Created.
+-------------------------------------------------------------------------------
+*/
+
+#include <slicer.h>
+#include <algorithm>
+
+#ifdef use_namespace
+namespace TSPLINE {
+	using namespace NEWMAT;
+#endif
+
+/** The number of times a segment between two crossings is halved at most. */
+static const int MAX_REFINEMENTS = 10;
+/** The distance relative to the T-edge within which an end of a contour is at its T-vertex. */
+static const Real CORNER_TOLERANCE = 1e-9;
+
+TSlicer::TSlicer( const TSplinePtr &spline, int resolution /*= 16*/ ) :
+	_resolution(resolution < 1 ? 1 : resolution),
+	_tolerance(1e-10),
+	_max_iterations(30),
+	_hulls(spline)
+{
+	BoundingBox box = _hulls.getBox();
+	Real size = box.isEmpty() ? 0.0 : (box.maximum() - box.minimum()).norm2();
+	_chord_tolerance = 1e-4 * size;
+
+	_faces.resize(_hulls.sizeFaces());
+	for (int i=0;i<(int)_faces.size();i++)
+	{
+		compileFace(spline, _hulls.getFace(i), _faces[i]);
+	}
+}
+
+TSlicer::~TSlicer()
+{
+
+}
+
+void TSlicer::compileFace( const TSplinePtr &spline, const TFacePtr &tface, Face &face )
+{
+	TFaceCompiler::compileFace(spline, tface, face);
+	for (TLnkLIterator iter=tface->linkIteratorBegin();iter!=tface->linkIteratorEnd();iter++)
+	{
+		face.edges.push_back((*iter)->getTEdge());
+	}
+
+	for (int i=0;i<=_resolution;i++)
+	{
+		for (int j=0;j<=_resolution;j++)
+		{
+			Parameter sample(face.s_min + (face.s_max-face.s_min)*i/_resolution, face.t_min + (face.t_max-face.t_min)*j/_resolution);
+			face.points.push_back(face.equation->computePoint(sample));
+		}
+	}
+}
+
+int TSlicer::slice( Real height, std::vector<TContour> &contours ) const
+{
+	contours.clear();
+	Real huge = std::numeric_limits<Real>::max();
+	BoundingBox plane(Point3D(-huge, -huge, height), Point3D(huge, huge, height));
+	std::vector<int> indices;
+	auto visitor = [&](int index) { indices.push_back(index); };
+	_hulls.getHierarchy().visitOverlapping(plane, visitor);
+	// The T-faces are sliced in the order of the T-image, so that the contours do not depend on the tree.
+	std::sort(indices.begin(), indices.end());
+
+	std::vector<TContour> open;
+	std::vector<End> ends;
+	for (int i=0;i<(int)indices.size();i++)
+	{
+		sliceFace(_faces[indices[i]], height, open, ends, contours);
+	}
+	chainContours(open, ends, contours);
+	return (int)contours.size();
+}
+
+int TSlicer::slice( const std::vector<Real> &heights, std::vector<std::vector<TContour> > &slices ) const
+{
+	slices.resize(heights.size());
+	int n = (int)heights.size(), count = 0;
+	// A plane is a large task, the threads take them one by one.
+#ifdef USE_OMP
+#pragma omp parallel for schedule(dynamic, 1) reduction(+:count)
+#endif
+	for (int i=0;i<n;i++)
+	{
+		count += slice(heights[i], slices[i]);
+	}
+	return count;
+}
+
+void TSlicer::sliceFace( const Face &face, Real height, std::vector<TContour> &open, std::vector<End> &ends, std::vector<TContour> &contours ) const
+{
+	int n = _resolution + 1;
+	std::vector<Real> values(face.points.size());
+	bool above = false, below = false;
+	for (int i=0;i<(int)values.size();i++)
+	{
+		// A sample on the plane counts as above it, the same on both sides of a grid line.
+		values[i] = face.points[i].z() - height;
+		if (values[i] >= 0.0) above = true; else below = true;
+	}
+	if (!above || !below) return;
+
+	// The crossing of a grid line is solved once and shared by the cells on both sides of it.
+	std::vector<int> lines(2*n*n, -1);
+	std::vector<Crossing> crossings;
+	auto crossing = [&](int i0, int j0, int i1, int j1) -> int
+	{
+		int &line = lines[2*(i0*n+j0) + (i1 > i0 ? 0 : 1)];
+		if (line < 0)
+		{
+			line = (int)crossings.size();
+			crossings.push_back(Crossing());
+			solveCrossing(face, height, 
+				face.s_min + (face.s_max-face.s_min)*i0/_resolution, face.t_min + (face.t_max-face.t_min)*j0/_resolution,
+				face.s_min + (face.s_max-face.s_min)*i1/_resolution, face.t_min + (face.t_max-face.t_min)*j1/_resolution,
+				values[i0*n+j0], values[i1*n+j1], crossings.back());
+		}
+		return line;
+	};
+
+	// Each crossing is joined to the crossings of the one or two cells it borders.
+	std::vector<int> neighbors;
+	auto join = [&](int a, int b)
+	{
+		neighbors.resize(2*crossings.size(), -1);
+		neighbors[2*a + (neighbors[2*a] < 0 ? 0 : 1)] = b;
+		neighbors[2*b + (neighbors[2*b] < 0 ? 0 : 1)] = a;
+	};
+	for (int i=0;i<_resolution;i++)
+	{
+		for (int j=0;j<_resolution;j++)
+		{
+			// The corners counterclockwise from (i, j), the edge k goes from the corner k to the next one.
+			int corners[4][2] = {{i, j}, {i+1, j}, {i+1, j+1}, {i, j+1}};
+			bool signs[4];
+			for (int k=0;k<4;k++) signs[k] = values[corners[k][0]*n+corners[k][1]] >= 0.0;
+			int edges[4], count = 0;
+			for (int k=0;k<4;k++)
+			{
+				if (signs[k] == signs[(k+1)%4]) continue;
+				const int *a = corners[k], *b = corners[(k+1)%4];
+				// A grid line is keyed by its lower end.
+				edges[count++] = (a[0] < b[0] || a[1] < b[1]) ? crossing(a[0], a[1], b[0], b[1]) : crossing(b[0], b[1], a[0], a[1]);
+			}
+			if (count == 2)
+			{
+				join(edges[0], edges[1]);
+			}
+			else if (count == 4)
+			{
+				// A saddle, the center tells whether the corners 0 and 2 are connected across it.
+				Parameter center(face.s_min + (face.s_max-face.s_min)*(i+0.5)/_resolution, face.t_min + (face.t_max-face.t_min)*(j+0.5)/_resolution);
+				bool sign = face.equation->computePoint(center).z() - height >= 0.0;
+				if (sign == signs[0])
+				{
+					join(edges[0], edges[1]);
+					join(edges[2], edges[3]);
+				}
+				else
+				{
+					join(edges[3], edges[0]);
+					join(edges[1], edges[2]);
+				}
+			}
+		}
+	}
+	neighbors.resize(2*crossings.size(), -1);
+
+	// Trace from the crossings on the boundary first, then around the loops inside the T-face.
+	std::vector<char> visited(crossings.size(), 0);
+	for (int pass=0;pass<2;pass++)
+	{
+		for (int start=0;start<(int)crossings.size();start++)
+		{
+			if (visited[start] || (pass == 0 && neighbors[2*start+1] >= 0)) continue;
+			TContour contour;
+			contour.points.push_back(crossings[start].point);
+			visited[start] = 1;
+			int previous = -1, current = start;
+			for (;;)
+			{
+				int next = neighbors[2*current] != previous ? neighbors[2*current] : neighbors[2*current+1];
+				if (next < 0) break;
+				refineSegment(face, height, crossings[current], crossings[next], 0, contour.points);
+				if (next == start)
+				{
+					contour.points.pop_back();
+					contour.closed = true;
+					break;
+				}
+				visited[next] = 1;
+				previous = current;
+				current = next;
+			}
+			if (contour.closed)
+			{
+				contours.push_back(contour);
+			}
+			else
+			{
+				open.push_back(contour);
+				ends.push_back(End());
+				locateEnd(face, crossings[start].parameter, ends.back());
+				ends.push_back(End());
+				locateEnd(face, crossings[current].parameter, ends.back());
+			}
+		}
+	}
+}
+
+void TSlicer::solveCrossing( const Face &face, Real height, Real s0, Real t0, Real s1, Real t1, Real f0, Real f1, Crossing &crossing ) const
+{
+	// Newton iterations along the grid line, kept in the bracket [u0, u1] by bisection.
+	Real u0 = 0.0, u1 = 1.0, u = f0 / (f0 - f1);
+	Real derivatives[9];
+	for (int iteration=0;;iteration++)
+	{
+		face.equation->computeDerivatives(s0 + u*(s1-s0), t0 + u*(t1-t0), 1, derivatives);
+		Real f = derivatives[2] - height;
+		if (fabs(f) <= _tolerance * face.size || iteration >= _max_iterations) break;
+		if ((f >= 0.0) == (f0 >= 0.0)) { u0 = u; f0 = f; } else { u1 = u; }
+		Real df = derivatives[5]*(s1-s0) + derivatives[8]*(t1-t0);
+		Real next = df != 0.0 ? u - f / df : -1.0;
+		if (next <= u0 || next >= u1) next = 0.5 * (u0 + u1);
+		if (next == u) break;
+		u = next;
+	}
+	crossing.parameter = Parameter(s0 + u*(s1-s0), t0 + u*(t1-t0));
+	crossing.point = Point3D(derivatives[0], derivatives[1], derivatives[2]);
+}
+
+void TSlicer::projectOnContour( const Face &face, Real height, Real &s, Real &t ) const
+{
+	Real derivatives[9];
+	for (int iteration=0;iteration<_max_iterations;iteration++)
+	{
+		face.equation->computeDerivatives(s, t, 1, derivatives);
+		Real f = derivatives[2] - height;
+		Real g2 = derivatives[5]*derivatives[5] + derivatives[8]*derivatives[8];
+		if (fabs(f) <= _tolerance * face.size || g2 <= 0.0) break;
+		s = max(face.s_min, min(face.s_max, s - f * derivatives[5] / g2));
+		t = max(face.t_min, min(face.t_max, t - f * derivatives[8] / g2));
+	}
+}
+
+void TSlicer::refineSegment( const Face &face, Real height, const Crossing &a, const Crossing &b, int depth, std::vector<Point3D> &points ) const
+{
+	if (depth < MAX_REFINEMENTS)
+	{
+		Crossing middle;
+		Real s = 0.5 * (a.parameter.s() + b.parameter.s()), t = 0.5 * (a.parameter.t() + b.parameter.t());
+		Real ds = b.parameter.s() - a.parameter.s(), dt = b.parameter.t() - a.parameter.t();
+		projectOnContour(face, height, s, t);
+		// Newton may slide to another branch of the contour, then the chord is kept.
+		Real ms = s - 0.5 * (a.parameter.s() + b.parameter.s()), mt = t - 0.5 * (a.parameter.t() + b.parameter.t());
+		if (ms*ms + mt*mt <= ds*ds + dt*dt)
+		{
+			middle.parameter = Parameter(s, t);
+			middle.point = face.equation->computePoint(middle.parameter);
+			if (squaredChordDistance(middle.point, a.point, b.point) > _chord_tolerance * _chord_tolerance)
+			{
+				refineSegment(face, height, a, middle, depth+1, points);
+				refineSegment(face, height, middle, b, depth+1, points);
+				return;
+			}
+		}
+	}
+	points.push_back(b.point);
+}
+
+void TSlicer::locateEnd( const Face &face, const Parameter &parameter, End &end ) const
+{
+	end.face = face.face;
+	end.edge.reset();
+	end.vertex.reset();
+	end.position = 0.0;
+	// The T-vertices of a side may differ in the last bits, the end is on the nearest T-edge in the parameter space.
+	Real s = parameter.s(), t = parameter.t(), nearest = std::numeric_limits<Real>::max();
+	for (int i=0;i<(int)face.edges.size();i++)
+	{
+		const TEdgePtr &edge = face.edges[i];
+		Real s0 = edge->getStartVertex()->getS(), t0 = edge->getStartVertex()->getT();
+		Real s1 = edge->getEndVertex()->getS(), t1 = edge->getEndVertex()->getT();
+		Real ds = s1 - s0, dt = t1 - t0, length2 = ds*ds + dt*dt;
+		Real u = length2 > 0.0 ? ((s-s0)*ds + (t-t0)*dt) / length2 : 0.0;
+		u = max(0.0, min(1.0, u));
+		Real es = s - s0 - u*ds, et = t - t0 - u*dt, distance = es*es + et*et;
+		if (distance < nearest)
+		{
+			nearest = distance;
+			end.edge = edge;
+			// An end at a corner is shared by the T-faces around the T-vertex rather than by those of the T-edge.
+			end.vertex = u <= CORNER_TOLERANCE ? edge->getStartVertex() : (u >= 1.0 - CORNER_TOLERANCE ? edge->getEndVertex() : TVertexPtr());
+			// The position is the parameter along the T-edge, shared by the T-faces on both sides of it.
+			end.position = fabs(ds) >= fabs(dt) ? s : t;
+		}
+	}
+}
+
+void TSlicer::chainContours( const std::vector<TContour> &open, const std::vector<End> &ends, std::vector<TContour> &contours ) const
+{
+	// The end 2 * k is the first point of the open contour k, the end 2 * k + 1 its last point.
+	int n = (int)open.size();
+	std::vector<std::pair<std::pair<TObject *, Real>, int> > order;
+	for (int k=0;k<2*n;k++)
+	{
+		TObject *shared = ends[k].vertex ? (TObject *)ends[k].vertex.get() : (TObject *)ends[k].edge.get();
+		if (shared) order.push_back(std::make_pair(std::make_pair(shared, ends[k].position), k));
+	}
+	std::sort(order.begin(), order.end());
+
+	// Match each end to the nearest free end on the same T-edge from the T-face on the other side of it, or at the same T-vertex from another T-face.
+	std::vector<int> matches(2*n, -1);
+	for (int first=0, last=0;first<(int)order.size();first=last)
+	{
+		while (last < (int)order.size() && order[last].first.first == order[first].first.first) last++;
+		for (int i=first;i<last;i++)
+		{
+			int end = order[i].second;
+			if (matches[end] >= 0) continue;
+			int best = -1;
+			Real best_distance = std::numeric_limits<Real>::max();
+			for (int j=first;j<last;j++)
+			{
+				int other = order[j].second;
+				if (matches[other] >= 0 || ends[other].face == ends[end].face) continue;
+				Real distance = fabs(order[j].first.second - order[i].first.second);
+				if (distance < best_distance)
+				{
+					best_distance = distance;
+					best = other;
+				}
+			}
+			if (best >= 0)
+			{
+				matches[end] = best;
+				matches[best] = end;
+			}
+		}
+	}
+
+	// Follow the chains from a free end first, the rest are loops.
+	std::vector<char> used(n, 0);
+	for (int pass=0;pass<2;pass++)
+	{
+		for (int k=0;k<n;k++)
+		{
+			if (used[k]) continue;
+			int side = 0;
+			if (pass == 0)
+			{
+				if (matches[2*k] < 0) side = 0;
+				else if (matches[2*k+1] < 0) side = 1;
+				else continue;
+			}
+			TContour contour;
+			int current = k;
+			for (;;)
+			{
+				used[current] = 1;
+				// The first point of a joined contour is the last point of the former one.
+				const std::vector<Point3D> &points = open[current].points;
+				int skip = contour.points.empty() ? 0 : 1;
+				if (side == 0) contour.points.insert(contour.points.end(), points.begin() + skip, points.end());
+				else contour.points.insert(contour.points.end(), points.rbegin() + skip, points.rend());
+				int match = matches[2*current + 1 - side];
+				if (match < 0) break;
+				if (used[match/2])
+				{
+					contour.points.pop_back();
+					contour.closed = true;
+					break;
+				}
+				current = match / 2;
+				side = match % 2;
+			}
+			contours.push_back(contour);
+		}
+	}
+}
+
+#ifdef use_namespace
+}
+#endif
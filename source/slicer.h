@@ -0,0 +1,152 @@
+/*
+T-SPLINE -- A T-spline object oriented library in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 2.1 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building,
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+- Created.
+-------------------------------------------------------------------------------
+*/
+
+/**  @file  [slicer]
+  *  @brief  Planar slicing of a T-spline surface.
+  *  @author  <agent>
+  *  @date  <2026.10.19>
+  *  @version  <v1.0>
+  *  @note
+  *  This file contains the slicer which cuts a T-spline surface by horizontal planes into contours,
+  *  used for CAM and additive manufacturing.
+*/
+
+#ifndef SLICER_H
+#define SLICER_H
+
+#include <utils.h>
+#include <tspline.h>
+#include <splbase.h>
+#include <hierarchy.h>
+#include <compiler.h>
+
+#ifdef use_namespace
+namespace TSPLINE {
+	using namespace NEWMAT;
+#endif
+
+DECLARE_SMARTPTR(TSlicer);
+
+/** A contour of a slice, a polyline on the surface at the height of the plane. */
+struct TContour
+{
+	TContour() : closed(false) {}
+	std::vector<Point3D> points;
+	bool closed;	/** True if the last point joins the first one, which is not repeated. */
+};
+
+/**
+  *  @class  <TSlicer>
+  *  @brief  T-spline slicer
+  *  @note
+  *  The slicer compiles the blending equation of every T-face once with a grid of (resolution + 1) * (resolution + 1)
+  *  samples of its domain. A plane z = h only visits the T-faces whose control hulls it crosses (see TFaceHierarchy).
+  *  On a T-face the signs of z - h at the samples are marched cell by cell; where they change along a grid line the
+  *  crossing is found by Newton iterations on the exact surface, and the crossings are joined through the cells, a saddle
+  *  cell being resolved by the sign at its center. Between two crossings points are inserted on the exact contour until
+  *  every chord is within the chord tolerance of it. The contours ending on the boundaries of the T-faces are then joined
+  *  through the T-edges and the T-vertices they end on, to the contours of the T-faces on the other side, so that a
+  *  contour closes across the T-faces; it stays open on a boundary T-edge. A contour narrower than a cell may be missed
+  *  or left open. The queries are const, and many planes are sliced on all the threads at once.
+*/
+class TSlicer
+{
+public:
+	TSlicer(const TSplinePtr &spline, int resolution = 16);
+	~TSlicer();
+public:
+	/** Set the tolerance of the Newton iterations relative to the size of the T-face. */
+	void setTolerance(Real tolerance) {_tolerance = tolerance;}
+	/** Set the maximum number of Newton iterations. */
+	void setMaxIterations(int iterations) {_max_iterations = iterations;}
+	/** Set the largest distance of a chord from the contour, 1e-4 of the size of the T-spline by default. */
+	void setChordTolerance(Real tolerance) {_chord_tolerance = tolerance;}
+	/** Return the number of T-faces. */
+	int sizeFaces() const {return (int)_faces.size();}
+	/** Get the box of the control points of the T-spline. */
+	BoundingBox getBox() const {return _hulls.getBox();}
+public:
+	/** Slice the surface by the plane z = height, return the number of contours. */
+	int slice(Real height, std::vector<TContour> &contours) const;
+	/** Slice the surface by the planes at the heights on all the threads, return the number of contours. */
+	int slice(const std::vector<Real> &heights, std::vector<std::vector<TContour> > &slices) const;
+protected:
+	struct Face : public TCompiledFace
+	{
+		std::vector<Point3D> points;	/** The points of the samples. */
+		std::vector<TEdgePtr> edges;	/** The T-edges around the T-face. */
+	};
+	/** A crossing of the plane with a grid line. */
+	struct Crossing
+	{
+		Parameter parameter;
+		Point3D point;
+	};
+	/** The end of an open contour, on a T-edge of its T-face. */
+	struct End
+	{
+		TFacePtr face;
+		TEdgePtr edge;	/** Null if the end is not on a T-edge. */
+		TVertexPtr vertex;	/** The T-vertex if the end is at a corner of the T-face. */
+		Real position;	/** The parameter along the T-edge. */
+	};
+	void compileFace(const TSplinePtr &spline, const TFacePtr &tface, Face &face);
+	/** Trace the contours on the T-face, the open ones end on its boundary. */
+	void sliceFace(const Face &face, Real height, std::vector<TContour> &open, std::vector<End> &ends, std::vector<TContour> &contours) const;
+	/** Find the T-edge of the T-face which the parameter on its boundary lies on. */
+	void locateEnd(const Face &face, const Parameter &parameter, End &end) const;
+	/** Find where the plane crosses the grid line from (s0, t0) to (s1, t1), whose ends are at f0 and f1 of opposite signs from it. */
+	void solveCrossing(const Face &face, Real height, Real s0, Real t0, Real s1, Real t1, Real f0, Real f1, Crossing &crossing) const;
+	/** Move (s, t) onto the contour by Newton iterations along the gradient of z. */
+	void projectOnContour(const Face &face, Real height, Real &s, Real &t) const;
+	/** Append the points of the contour after a up to b, so that the chords are within the chord tolerance. */
+	void refineSegment(const Face &face, Real height, const Crossing &a, const Crossing &b, int depth, std::vector<Point3D> &points) const;
+	/** Join the open contours whose ends meet on a T-edge from the T-faces on both sides of it into the contours. */
+	void chainContours(const std::vector<TContour> &open, const std::vector<End> &ends, std::vector<TContour> &contours) const;
+private:
+	int _resolution;
+	Real _tolerance;
+	int _max_iterations;
+	Real _chord_tolerance;
+	std::vector<Face> _faces;
+	TFaceHierarchy _hulls;
+};
+
+#ifdef use_namespace
+}
+#endif
+
+#endif
@@ -0,0 +1,308 @@
+/*
+TSPLINE -- A T-spline object oriented package in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 3.0 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building,
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+   - Created.
+-------------------------------------------------------------------------------
+*/
+
+#include <snapshot.h>
+#include <derivator.h>
+#include <extractor.h>
+#include <thread>
+
+#ifdef use_namespace
+namespace TSPLINE {
+	using namespace NEWMAT;
+#endif
+
+TSplineSnapshot::TSplineSnapshot( const TSplinePtr &spline, unsigned long version /*= 0*/ ) :
+	_version(version)
+{
+	compilePoints(spline);
+	compileFaces(spline);
+}
+
+TSplineSnapshot::TSplineSnapshot( const TSplineSnapshot &previous, const TSplinePtr &spline, 
+	const TFacVector &dirty_faces, unsigned long version /*= 0*/ ) :
+	_version(version)
+{
+	compilePoints(spline);
+
+	TFacVector faces;
+	TExtractor::extractBlendedTFacesFromTImage(spline->getTImage(), faces);
+	if ((int)faces.size() != previous.numberOfFaces())
+	{
+		// The topology has changed, nothing can be shared.
+		compileFaces(spline);
+		return;
+	}
+
+	_faces = previous._faces;
+	std::map<TFacePtr, int> indices;
+	for (int i=0;i<(int)faces.size();i++)
+	{
+		indices[faces[i]] = i;
+	}
+	for (TFacVConstIterator iter = dirty_faces.begin(); iter != dirty_faces.end(); iter++)
+	{
+		std::map<TFacePtr, int>::iterator found = indices.find(*iter);
+		if (found != indices.end())
+		{
+			_faces[found->second] = Face();
+			compileFace(spline, *iter, _faces[found->second]);
+		}
+	}
+}
+
+TSplineSnapshot::~TSplineSnapshot()
+{
+
+}
+
+void TSplineSnapshot::compilePoints( const TSplinePtr &spline )
+{
+	TPointsetPtr pointset = spline->getTPointset();
+	if (pointset)
+	{
+		_points.reserve(pointset->size());
+		for (TObjVIterator iter = pointset->iteratorBegin(); iter != pointset->iteratorEnd(); iter++)
+		{
+			TPointPtr point = castPtr<TPoint>(*iter);
+			if (!point) continue;
+			_points.push_back(ControlPoint(point->getSymbol(),
+				Point3D(point->getX(), point->getY(), point->getZ()), point->getW()));
+		}
+	}
+}
+
+void TSplineSnapshot::compileFaces( const TSplinePtr &spline )
+{
+	TFacVector faces;
+	TExtractor::extractBlendedTFacesFromTImage(spline->getTImage(), faces);
+	_faces.resize(faces.size());
+	for (int i=0;i<(int)faces.size();i++)
+	{
+		compileFace(spline, faces[i], _faces[i]);
+	}
+}
+
+void TSplineSnapshot::compileFace( const TSplinePtr &spline, const TFacePtr &tface, Face &face )
+{
+	face.symbol = tface->getSymbol();
+	TFaceCompiler::compileFace(spline, tface, face);
+	// The T-face is known by its symbol and its links, the snapshot holds no T-object.
+	face.face.reset();
+	for (TLnkLIterator iter = tface->linkIteratorBegin(); iter != tface->linkIteratorEnd(); iter++)
+	{
+		TVertexPtr v_start = (*iter)->getStartVertex();
+		TVertexPtr v_end = (*iter)->getEndVertex();
+		face.links.push_back(v_start->getS());
+		face.links.push_back(v_start->getT());
+		face.links.push_back(v_end->getS());
+		face.links.push_back(v_end->getT());
+	}
+}
+
+bool TSplineSnapshot::pointInFace( const Face &face, const Parameter &parameter ) const
+{
+	// The same crossing count as TLinkVisitorCheckParameterIntersection, with local counters.
+	int count = 0, online = 0;
+	for (size_t i = 0; i + 3 < face.links.size(); i += 4)
+	{
+		Real max_s = max(face.links[i], face.links[i+2]);
+		Real min_s = min(face.links[i], face.links[i+2]);
+		Real max_t = max(face.links[i+1], face.links[i+3]);
+		Real min_t = min(face.links[i+1], face.links[i+3]);
+		if (fabs(max_t-min_t) <= M_EPS)
+		{
+			if (parameter.t() >= min_t && parameter.t() <= max_t &&
+				parameter.s() >= min_s && parameter.s() <= max_s)
+			{
+				online++;
+			}
+		}
+		else if (parameter.t() > max_t || parameter.t() < min_t)
+		{
+			continue;
+		}
+		else if (parameter.s() > min_s)
+		{
+			count++;
+		}
+		else if (parameter.s() == min_s)
+		{
+			online++;
+		}
+	}
+	return (count % 2 == 1) || (online > 0);
+}
+
+int TSplineSnapshot::findFace( const Parameter &parameter ) const
+{
+	for (size_t i = 0; i < _faces.size(); i++)
+	{
+		if (pointInFace(_faces[i], parameter))
+			return (int)i;
+	}
+	return -1;
+}
+
+int TSplineSnapshot::pointDerive( const Parameter &parameter, Point3D &point ) const
+{
+	point.clear();
+	int index = findFace(parameter);
+	if (index < 0) return 0;
+
+	point = _faces[index].equation->computePoint(parameter);
+	return 1;
+}
+
+int TSplineSnapshot::pointAndNormalDerive( const Parameter &parameter, Point3D &point, Vector3D &normal ) const
+{
+	point.clear();
+	int index = findFace(parameter);
+	if (index < 0) return 0;
+
+	Matrix derivatives = _faces[index].equation->computeUpToFirstDerivatives(parameter);
+	point = Point3D(derivatives(1,3), derivatives(2,3), derivatives(3,3));
+	Vector3D dsdu(derivatives(1,1), derivatives(2,1), derivatives(3,1));
+	Vector3D dsdv(derivatives(1,2), derivatives(2,2), derivatives(3,2));
+	normal = dsdu * dsdv; normal.normalize();
+	return 1;
+}
+
+ReturnMatrix TSplineSnapshot::secondPartialDerive( const Parameter &parameter ) const
+{
+	int index = findFace(parameter);
+	if (index < 0) return 0;
+
+	return _faces[index].equation->computeUpToSecondDerivatives(parameter);
+}
+
+ReturnMatrix TSplineSnapshot::firstAndSecondFundamentalForm( const Parameter &parameter ) const
+{
+	ColumnVector fform(6); fform = 0.0;
+	int index = findFace(parameter);
+	if (index >= 0) _faces[index].equation->computeFundamentalForm(parameter, fform.data());
+
+	fform.Release();
+	return fform;
+}
+
+int TSplineSnapshot::principalCurvature( const Parameter &parameter, Real &k1, Real &k2 ) const
+{
+	int index = findFace(parameter);
+	if (index < 0) return 0;
+
+	Real form[6];
+	_faces[index].equation->computeFundamentalForm(parameter, form);
+	TDerivator::principalCurvatureByFundamentalForm(form, k1, k2);
+	return 1;
+}
+
+TSnapshotPublisher::TSnapshotPublisher() :
+	_current(0),
+	_epoch(0),
+	_version(0)
+{
+	_readers[0] = 0;
+	_readers[1] = 0;
+}
+
+TSnapshotPublisher::~TSnapshotPublisher()
+{
+	delete _current.load();
+}
+
+unsigned long TSnapshotPublisher::publish( const TSplinePtr &spline )
+{
+	return publish(spline, 0);
+}
+
+unsigned long TSnapshotPublisher::publish( const TSplinePtr &spline, const TFacVector &dirty_faces )
+{
+	return publish(spline, &dirty_faces);
+}
+
+unsigned long TSnapshotPublisher::publish( const TSplinePtr &spline, const TFacVector *dirty_faces )
+{
+	std::lock_guard<std::mutex> lock(_writer);
+	// Compiling reads the T-spline, so it must not run concurrently with an edit.
+	// Only the writer deletes snapshots, so the current one can be read here without entering.
+	const TSplineSnapshot *current = _current.load();
+	const TSplineSnapshot *snapshot = 0;
+	if (current && dirty_faces)
+	{
+		snapshot = new TSplineSnapshot(*current, spline, *dirty_faces, ++_version);
+	}
+	else
+	{
+		snapshot = new TSplineSnapshot(spline, ++_version);
+	}
+	const TSplineSnapshot *retired = _current.exchange(snapshot);
+	unsigned int epoch = _epoch.fetch_add(1);
+	// New readers enter the other epoch, wait for the ones which may still see the retired snapshot.
+	while (_readers[epoch & 1].load() != 0)
+	{
+		std::this_thread::yield();
+	}
+	delete retired;
+	return _version;
+}
+
+unsigned long TSnapshotPublisher::currentVersion() const
+{
+	const TSplineSnapshot *snapshot = _current.load();
+	return snapshot ? snapshot->getVersion() : 0;
+}
+
+const TSplineSnapshot * TSnapshotPublisher::enter( unsigned int &slot )
+{
+	for (;;)
+	{
+		unsigned int epoch = _epoch.load();
+		slot = epoch & 1;
+		_readers[slot].fetch_add(1);
+		if (_epoch.load() == epoch) break;
+		_readers[slot].fetch_sub(1);
+	}
+	return _current.load();
+}
+
+void TSnapshotPublisher::leave( unsigned int slot )
+{
+	_readers[slot].fetch_sub(1);
+}
+
+#ifdef use_namespace
+}
+#endif
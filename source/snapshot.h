@@ -0,0 +1,194 @@
+/*
+T-SPLINE -- A T-spline object oriented library in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 2.1 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building,
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+- Created.
+-------------------------------------------------------------------------------
+*/
+
+/**  @file  [snapshot]
+  *  @brief  Read-only snapshots of a T-spline.
+  *  @author  <agent>
+  *  @date  <2026.10.19>
+  *  @version  <v1.0>
+  *  @note
+  *  This file contains an immutable compiled view of a T-spline and a publisher which swaps
+  *  the views atomically, so that many threads can evaluate a T-spline while it is edited.
+*/
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <utils.h>
+#include <tspline.h>
+#include <splbase.h>
+#include <compiler.h>
+#include <atomic>
+#include <mutex>
+
+#ifdef use_namespace
+namespace TSPLINE {
+	using namespace NEWMAT;
+#endif
+
+DECLARE_SMARTPTR(TSplineSnapshot);
+DECLARE_SMARTPTR(TSnapshotPublisher);
+
+/**
+  *  @class  <TSplineSnapshot>
+  *  @brief  An immutable compiled view of a T-spline.
+  *  @note
+  *  The snapshot copies the control points and compiles one blending equation per T-face,
+  *  so it shares nothing mutable with the T-spline it was taken from. All the queries are const
+  *  and may be called from any number of threads at the same time. The T-face of a parameter
+  *  is found with the same test as TFinder::findTFaceByParameter.
+*/
+class TSplineSnapshot
+{
+public:
+	TSplineSnapshot(const TSplinePtr &spline, unsigned long version = 0);
+	/** Take a snapshot sharing the equations of the T-faces not listed as dirty with a previous snapshot. */
+	TSplineSnapshot(const TSplineSnapshot &previous, const TSplinePtr &spline, 
+		const TFacVector &dirty_faces, unsigned long version = 0);
+	~TSplineSnapshot();
+public:
+	/** A control point with its weight. */
+	struct ControlPoint
+	{
+		ControlPoint(int sb, const Point3D &pt, Real w) : symbol(sb), point(pt), weight(w) {}
+		int symbol;
+		Point3D point;
+		Real weight;
+	};
+public:
+	/** Get the version of the snapshot. */
+	unsigned long getVersion() const {return _version;}
+	/** Return the number of control points. */
+	int numberOfPoints() const {return (int)_points.size();}
+	/** Get the indexed control point. */
+	const ControlPoint &getPoint(int index) const {return _points[index];}
+	/** Return the number of T-faces. */
+	int numberOfFaces() const {return (int)_faces.size();}
+	/** Get the symbol of the indexed T-face. */
+	int getFaceSymbol(int index) const {return _faces[index].symbol;}
+	/** Find the index of the T-face containing the parameter, return -1 if there is none. */
+	int findFace(const Parameter &parameter) const;
+public:
+	/** Derive the zero oder point on the T-spline surface. */
+	int pointDerive(const Parameter &parameter, Point3D &point) const;
+	/** Derive both the zero and the first oder point and normal on the T-spline surface. */
+	int pointAndNormalDerive(const Parameter &parameter, Point3D &point, Vector3D &normal) const;
+	/** Calculate the first and second partial derivatives in a 3*6 matrix, see TDerivator::secondPartialDerive. */
+	ReturnMatrix secondPartialDerive(const Parameter &parameter) const;
+	/** Calculate the first and second fundamental form coefficients E F G L M N. */
+	ReturnMatrix firstAndSecondFundamentalForm(const Parameter &parameter) const;
+	/** Derive the principal curvature of the point on the T-spline surface. */
+	int principalCurvature(const Parameter &parameter, Real &k1, Real &k2) const;
+protected:
+	struct Face : public TCompiledFace
+	{
+		int symbol;
+		std::vector<Real> links;	// s and t of the start and the end vertex of each link
+	};
+	void compilePoints(const TSplinePtr &spline);
+	void compileFaces(const TSplinePtr &spline);
+	void compileFace(const TSplinePtr &spline, const TFacePtr &tface, Face &face);
+	bool pointInFace(const Face &face, const Parameter &parameter) const;
+private:
+	unsigned long _version;
+	std::vector<ControlPoint> _points;
+	std::vector<Face> _faces;
+};
+
+/**
+  *  @class  <TSnapshotPublisher>
+  *  @brief  Publisher of T-spline snapshots.
+  *  @note
+  *  The current snapshot is held by an atomic pointer. Readers enter an epoch by a counter and
+  *  never lock; a writer compiles a new snapshot, swaps the pointer, advances the epoch and waits
+  *  until the readers of the former epoch are gone before the replaced snapshot is deleted (RCU).
+  *  Writers are serialized by a mutex. A thread holding a TSnapshotReader must not publish.
+*/
+class TSnapshotPublisher
+{
+	friend class TSnapshotReader;
+public:
+	TSnapshotPublisher();
+	~TSnapshotPublisher();
+public:
+	/** Compile a snapshot of the T-spline and publish it, return the version of the snapshot. */
+	unsigned long publish(const TSplinePtr &spline);
+	/** Publish a snapshot in which only the dirty T-faces are compiled again, see TSplineEditor::takeDirtyFaces. */
+	unsigned long publish(const TSplinePtr &spline, const TFacVector &dirty_faces);
+	/** Return the version of the current snapshot, 0 if nothing has been published. */
+	unsigned long currentVersion() const;
+protected:
+	unsigned long publish(const TSplinePtr &spline, const TFacVector *dirty_faces);
+	const TSplineSnapshot *enter(unsigned int &slot);
+	void leave(unsigned int slot);
+private:
+	std::atomic<const TSplineSnapshot *> _current;
+	std::atomic<unsigned int> _epoch;
+	std::atomic<int> _readers[2];
+	std::mutex _writer;
+	unsigned long _version;
+};
+
+/**
+  *  @class  <TSnapshotReader>
+  *  @brief  Scoped read access to the current snapshot.
+  *  @note
+  *  The snapshot seen by a reader stays valid until the reader is destroyed, even if newer
+  *  snapshots are published meanwhile. Readers should be short-lived, since a writer waits for them.
+*/
+class TSnapshotReader
+{
+public:
+	TSnapshotReader(TSnapshotPublisher &publisher) : _publisher(publisher) { _snapshot = _publisher.enter(_slot); }
+	~TSnapshotReader() { _publisher.leave(_slot); }
+public:
+	/** Get the snapshot, 0 if nothing has been published. */
+	const TSplineSnapshot *get() const {return _snapshot;}
+	const TSplineSnapshot *operator->() const {return _snapshot;}
+private:
+	TSnapshotReader(const TSnapshotReader &);
+	TSnapshotReader &operator=(const TSnapshotReader &);
+private:
+	TSnapshotPublisher &_publisher;
+	const TSplineSnapshot *_snapshot;
+	unsigned int _slot;
+};
+
+#ifdef use_namespace
+}
+#endif
+
+#endif
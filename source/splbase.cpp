@@ -407,6 +407,11 @@ K5Domain CubicSpline::domain( Real u ) const
 {
 	Real k1 = getKnot(1), k2 = getKnot(2), k3 = getKnot(3), k4 = getKnot(4), k5 = getKnot(5);
 
+	// A parameter near to a knot is taken on the knot, the same as BSplineBasis::piece.
+	for (int i=1;i<=5;i++)
+	{
+		if (isEqual(u, getKnot(i))) { u = getKnot(i); break; }
+	}
 	if( (k1<=u && k2>u) || (isEqual(k5,k2) && isEqual(u,k2)) )
 	{
 		return K5_E1;
@@ -706,11 +711,38 @@ void CrossCubicSpline::setUVNodes( const ColumnVector &ku, const ColumnVector &k
 	CrossSpline::setUVNodes(ku, kv);
 }
 
-BlendingEquation::BlendingEquation()
-	:_tmx(4,4), _tmy(4,4), _tmz(4,4), _tm1(4,4)
+#ifdef MATRIX_FORM
+/** 
+  * Convert the homogeneous sums of BlendingBasis::evaluate into the point and its derivatives up to the order,
+  * stored in the order S, Su, Sv, Suu, Suv, Svv, 3 reals each.
+*/
+static void rationalDerivatives(const Real *sums, int order, Real *derivatives)
+{
+	Real W = sums[3];
+	for (int c=0;c<3;c++)
+	{
+		Real S = sums[c] / W;
+		derivatives[c] = S;
+		if (order < 1) continue;
+		Real S_u = (sums[4+c] - sums[7]*S) / W;
+		Real S_v = (sums[8+c] - sums[11]*S) / W;
+		derivatives[3+c] = S_u;
+		derivatives[6+c] = S_v;
+		if (order < 2) continue;
+		derivatives[9+c] = (sums[12+c] - 2.0*sums[7]*S_u - sums[15]*S) / W;
+		derivatives[12+c] = (sums[16+c] - sums[19]*S - sums[7]*S_v - sums[11]*S_u) / W;
+		derivatives[15+c] = (sums[20+c] - 2.0*sums[11]*S_v - sums[23]*S) / W;
+	}
+}
+#endif
+
+BlendingEquation::BlendingEquation( int degree_s /*= 3*/, int degree_t /*= 3*/ )
 {
-	_cross_spline = makePtr<CrossCubicSpline>();
-	_tmx = 0, _tmy = 0,	_tmz = 0, _tm1 = 0;
+#ifdef MATRIX_FORM
+	_basis = BlendingBasis::create(degree_s, degree_t);
+	if (!_basis)
+		Throw(ProgramException("unsupported degree of blending basis"));
+#endif
 }
 
 BlendingEquation::~BlendingEquation()
@@ -718,54 +750,54 @@ BlendingEquation::~BlendingEquation()
 
 }
 
-Point3D BlendingEquation::computePoint(Real u, Real v)
+Point3D BlendingEquation::computePoint(Real u, Real v) const
 {
+#ifdef MATRIX_FORM
+	Real sums[4];
+	_basis->evaluate(u, v, 0, sums);
+	return safeDivide(Point3D(sums[0], sums[1], sums[2]), sums[3]);
+#else
 	Point3D numerator(0.0, 0.0, 0.0);
 	Real denominator = 0.0;
-	VRPVK::iterator iter;
+	VRPVK::const_iterator iter;
 	for (iter = _rational_points_with_knots.begin(); \
 		iter != _rational_points_with_knots.end(); iter++)
 	{
-		_cross_spline->setUVNodes(iter->getUNodesAsColumnVector(),
-			iter->getVNodesAsColumnVector());
-#ifndef MATRIX_FORM
-		Real nuv = _cross_spline->baseFunc(u, v);
-#else
-		Real nuv = _cross_spline->baseFunc_m(u, v);
-#endif
+		CrossSplinePtr cross_spline = iter->cross_spline;
+		Real nuv = cross_spline->baseFunc(u, v);
 		Point3D point(iter->x(), iter->y(), iter->z());
 		Real w = (iter->weight);
 		numerator += (point * nuv * w);
 		denominator += (nuv * w);
 	}
 	return safeDivide(numerator, denominator);
+#endif
 }
 
-Point3D BlendingEquation::computePoint( const Parameter &p )
+Point3D BlendingEquation::computePoint( const Parameter &p ) const
 {
 	return computePoint(p.s(), p.t());
 }
 
-Vector3D BlendingEquation::computeNormal( Real u, Real v )
+Vector3D BlendingEquation::computeNormal( Real u, Real v ) const
 {
+#ifdef MATRIX_FORM
+	Point3D point;
+	Vector3D normal;
+	computePointAndNormal(u, v, point, normal);
+	return normal;
+#else
 	Vector3D normal;
 	Point3D pbw, pdbuw, pdbvw;
 	Real bw = 0.0, dbuw = 0.0, dbvw = 0.0;
-	VRPVK::iterator iter;
+	VRPVK::const_iterator iter;
 	for (iter = _rational_points_with_knots.begin(); \
 		iter != _rational_points_with_knots.end(); iter++)
 	{
-		_cross_spline->setUVNodes(iter->getUNodesAsColumnVector(),
-			iter->getVNodesAsColumnVector());
-#ifndef MATRIX_FORM
-		Real nuv = _cross_spline->baseFunc(u, v);
-		Real dnu = _cross_spline->baseFunc1stU(u, v);
-		Real dnv = _cross_spline->baseFunc1stV(u, v);
-#else
-		Real nuv = _cross_spline->baseFunc_m(u, v);
-		Real dnu = _cross_spline->baseFunc1stU_m(u, v);
-		Real dnv = _cross_spline->baseFunc1stV_m(u, v);
-#endif
+		CrossSplinePtr cross_spline = iter->cross_spline;
+		Real nuv = cross_spline->baseFunc(u, v);
+		Real dnu = cross_spline->baseFunc1stU(u, v);
+		Real dnv = cross_spline->baseFunc1stV(u, v);
 		Point3D point(iter->x(), iter->y(), iter->z());
 		Real w = (iter->weight);
 		pbw += (point * nuv * w);
@@ -783,28 +815,37 @@ Vector3D BlendingEquation::computeNormal( Real u, Real v )
 	normal = dsdu * dsdv; normal.normalize();
 
 	return normal;
+#endif
 }
 
-Vector3D BlendingEquation::computeNormal( const Parameter &p )
+Vector3D BlendingEquation::computeNormal( const Parameter &p ) const
 {
 	return computeNormal(p.s(), p.t());
 }
 
-void BlendingEquation::computePointAndNormal( Real u, Real v, Point3D &point, Vector3D &normal )
+void BlendingEquation::computePointAndNormal( Real u, Real v, Point3D &point, Vector3D &normal ) const
 {
-#ifndef MATRIX_FORM
+#ifdef MATRIX_FORM
+	Real sums[12], derivatives[9];
+	_basis->evaluate(u, v, 1, sums);
+	rationalDerivatives(sums, 1, derivatives);
+
+	point = Point3D(derivatives[0], derivatives[1], derivatives[2]);
+	Vector3D dsdu(derivatives[3], derivatives[4], derivatives[5]);
+	Vector3D dsdv(derivatives[6], derivatives[7], derivatives[8]);
+
+	normal = dsdu * dsdv; normal.normalize();
+#else
 	Point3D pbw, pdbuw, pdbvw;
 	Real bw = 0.0, dbuw = 0.0, dbvw = 0.0;
-	VRPVK::iterator iter;
+	VRPVK::const_iterator iter;
 	for (iter = _rational_points_with_knots.begin(); \
 		iter != _rational_points_with_knots.end(); iter++)
 	{
-		_cross_spline->setUVNodes(iter->getUNodesAsColumnVector(),
-			iter->getVNodesAsColumnVector());
-
-		Real nuv = _cross_spline->baseFunc(u, v);
-		Real dnu = _cross_spline->baseFunc1stU(u, v);
-		Real dnv = _cross_spline->baseFunc1stV(u, v);
+		CrossSplinePtr cross_spline = iter->cross_spline;
+		Real nuv = cross_spline->baseFunc(u, v);
+		Real dnu = cross_spline->baseFunc1stU(u, v);
+		Real dnv = cross_spline->baseFunc1stV(u, v);
 
 		Point3D point(iter->x(), iter->y(), iter->z());
 		Real w = (iter->weight);
@@ -820,102 +861,44 @@ void BlendingEquation::computePointAndNormal( Real u, Real v, Point3D &point, Ve
 	Vector3D dsdu = (pdbuw - point*dbuw)*(1/bw);
 	Vector3D dsdv = (pdbvw - point*dbvw)*(1/bw);
 
-	normal = dsdu * dsdv; normal.normalize();
-#else
-	std::vector<K5Domain> domainu,domainv;
-	getDomain(u, v, domainu, domainv);
-
-	if(_lastu.empty() || _lastv.empty())
-	{
-		initializeTensorMatrices(u, v);
-	}
-	else
-	{
-		if((domainu == _lastu) && (domainv == _lastv))
-		{
-		}
-		else
-		{
-			updateTensorMatrices(domainu, domainv);	
-		}
-	}
-
-	_lastu = domainu;
-	_lastv = domainv;
-
-	ColumnVector uup(4), vup(4);
-	uup << 1 << u << u*u << u*u*u;
-	vup << 1 << v << v*v << v*v*v;
-	Matrix mx = uup.AsRow() * _tmx * vup.AsColumn();
-	Matrix my = uup.AsRow() * _tmy * vup.AsColumn();
-	Matrix mz = uup.AsRow() * _tmz * vup.AsColumn();
-	Matrix mw = uup.AsRow() * _tm1 * vup.AsColumn();
-	
-	point = Point3D(mx(1,1)/mw(1,1), my(1,1)/mw(1,1), mz(1,1)/mw(1,1));
-
-	Point3D pdbuw, pdbvw;
-	Real dbuw = 0.0, dbvw = 0.0;
-	ColumnVector duup(4), dvup(4);
-	duup << 0 << 1 << 2*u << 3*u*u;
-	dvup << 0 << 1 << 2*v << 3*v*v;
-	Matrix dmxu = duup.AsRow() * _tmx * vup.AsColumn();
-	Matrix dmyu = duup.AsRow() * _tmy * vup.AsColumn();
-	Matrix dmzu = duup.AsRow() * _tmz * vup.AsColumn();
-	Matrix dmu = duup.AsRow() * _tm1 * vup.AsColumn();
-
-	Matrix dmxv = uup.AsRow() * _tmx * dvup.AsColumn();
-	Matrix dmyv = uup.AsRow() * _tmy * dvup.AsColumn();
-	Matrix dmzv = uup.AsRow() * _tmz * dvup.AsColumn();
-	Matrix dmv = uup.AsRow() * _tm1 * dvup.AsColumn();
-
-	pdbuw = Point3D(dmxu(1,1), dmyu(1,1), dmzu(1,1));
-	pdbvw = Point3D(dmxv(1,1), dmyv(1,1), dmzv(1,1));
-	dbuw = dmu(1,1);
-	dbvw = dmv(1,1);
-	
-	Vector3D dsdu = (pdbuw - point*dbuw)*(1/mw(1,1));
-	Vector3D dsdv = (pdbvw - point*dbvw)*(1/mw(1,1));
-
 	normal = dsdu * dsdv; normal.normalize();
 #endif
 }
 
-void BlendingEquation::computePointAndNormal( const Parameter &p, Point3D &point, Vector3D &normal )
+void BlendingEquation::computePointAndNormal( const Parameter &p, Point3D &point, Vector3D &normal ) const
 {
 	computePointAndNormal(p.s(), p.t(), point, normal);
 }
 
-NEWMAT::ReturnMatrix BlendingEquation::computeFirstDerivative( const DERIVE_SUFFIX der, const Real u, const Real v )
+NEWMAT::ReturnMatrix BlendingEquation::computeFirstDerivative( const DERIVE_SUFFIX der, const Real u, const Real v ) const
 {
+#ifdef MATRIX_FORM
+	Real sums[12], derivatives[9];
+	_basis->evaluate(u, v, 1, sums);
+	rationalDerivatives(sums, 1, derivatives);
+
+	const Real *d = derivatives + (der == DER_U ? 3 : 6);
+	ColumnVector dS(3); dS << d[0] << d[1] << d[2];
+	dS.Release();
+	return dS;
+#else
 	ColumnVector B(3), dB(3), S(3);
 	B = 0, dB = 0, S = 0;//lyz
 	Real W = 0, dW = 0.0;
 
-	for (VRPVK::iterator iter = _rational_points_with_knots.begin(); \
+	for (VRPVK::const_iterator iter = _rational_points_with_knots.begin(); \
 		iter != _rational_points_with_knots.end(); iter++)
 	{
 		CrossSplinePtr cross_spline = (*iter).cross_spline;
-#ifndef MATRIX_FORM
 		Real Bi = cross_spline->baseFunc(u, v);
-#else
-		Real Bi = cross_spline->baseFunc_m(u, v);
-#endif
 		Real dBi = 0.0;
 		switch (der)
 		{
 		case DER_U:
-#ifndef MATRIX_FORM
 			dBi = cross_spline->baseFunc1stU(u, v);
-#else
-			dBi = cross_spline->baseFunc1stU_m(u, v);
-#endif
 			break;
 		case  DER_V:
-#ifndef MATRIX_FORM
 			dBi = cross_spline->baseFunc1stV(u, v);
-#else
-			dBi = cross_spline->baseFunc1stV_m(u, v);
-#endif
 			break;
 		}
 
@@ -932,32 +915,42 @@ NEWMAT::ReturnMatrix BlendingEquation::computeFirstDerivative( const DERIVE_SUFF
 	ColumnVector dS = (1.0/W) * (dB - dW * S);
 	dS.Release();
 	return dS;
+#endif
 }
 
-NEWMAT::ReturnMatrix BlendingEquation::computeFirstDerivative( const DERIVE_SUFFIX der, const Parameter &p )
+NEWMAT::ReturnMatrix BlendingEquation::computeFirstDerivative( const DERIVE_SUFFIX der, const Parameter &p ) const
 {
 	return computeFirstDerivative(der, p.s(), p.t());
 }
 
-NEWMAT::ReturnMatrix BlendingEquation::computeUpToFirstDerivatives( const Real u, const Real v )
+NEWMAT::ReturnMatrix BlendingEquation::computeUpToFirstDerivatives( const Real u, const Real v ) const
 {
+#ifdef MATRIX_FORM
+	Real sums[12], derivatives[9];
+	_basis->evaluate(u, v, 1, sums);
+	rationalDerivatives(sums, 1, derivatives);
+
+	Matrix Ss(3,3);
+	for (int c=0;c<3;c++)
+	{
+		Ss(c+1,1) = derivatives[3+c];
+		Ss(c+1,2) = derivatives[6+c];
+		Ss(c+1,3) = derivatives[c];
+	}
+	Ss.Release();
+	return Ss;
+#else
 	ColumnVector B(3), dB_u(3), dB_v(3);
 	B = 0, dB_u = 0, dB_v = 0;//lyz
 	Real W = 0, dW_u = 0.0, dW_v = 0.0;
 
-	for (VRPVK::iterator iter = _rational_points_with_knots.begin(); \
+	for (VRPVK::const_iterator iter = _rational_points_with_knots.begin(); \
 		iter != _rational_points_with_knots.end(); iter++)
 	{
 		CrossSplinePtr cross_spline = (*iter).cross_spline;
-#ifndef MATRIX_FORM
 		Real Bi = cross_spline->baseFunc(u, v);
 		Real dBi_u = cross_spline->baseFunc1stU(u, v);
 		Real dBi_v = cross_spline->baseFunc1stV(u, v);
-#else
-		Real Bi = cross_spline->baseFunc_m(u, v);
-		Real dBi_u = cross_spline->baseFunc1stU_m(u, v);
-		Real dBi_v = cross_spline->baseFunc1stV_m(u, v);
-#endif
 		Real Wi = (iter->weight);
 		ColumnVector Pi(3);	Pi << iter->x() << iter->y() << iter->z();
 
@@ -976,44 +969,48 @@ NEWMAT::ReturnMatrix BlendingEquation::computeUpToFirstDerivatives( const Real u
 	Matrix Ss = dS_u | dS_v | S;
 	Ss.Release();
 	return Ss;
+#endif
 }
 
-NEWMAT::ReturnMatrix BlendingEquation::computeUpToFirstDerivatives( const Parameter &p )
+NEWMAT::ReturnMatrix BlendingEquation::computeUpToFirstDerivatives( const Parameter &p ) const
 {
 	return computeUpToFirstDerivatives(p.s(), p.t());
 }
 
-NEWMAT::ReturnMatrix BlendingEquation::computeSecondDerivative( const DERIVE_SUFFIX der1, const DERIVE_SUFFIX der2, const Real u, const Real v )
+NEWMAT::ReturnMatrix BlendingEquation::computeSecondDerivative( const DERIVE_SUFFIX der1, const DERIVE_SUFFIX der2, const Real u, const Real v ) const
 {
+#ifdef MATRIX_FORM
+	Real sums[24], derivatives[18];
+	_basis->evaluate(u, v, 2, sums);
+	rationalDerivatives(sums, 2, derivatives);
+
+	const Real *d = derivatives + 12;
+	if (der1 == DER_U && der2 == DER_U) d = derivatives + 9;
+	else if (der1 == DER_V && der2 == DER_V) d = derivatives + 15;
+	ColumnVector ddS(3); ddS << d[0] << d[1] << d[2];
+	ddS.Release();
+	return ddS;
+#else
 	ColumnVector B(3), dB_u(3), dB_v(3), ddB_uu(3), ddB_vv(3), ddB_uv(3);
 	B = 0, dB_u = 0, dB_v = 0, ddB_uu = 0, ddB_vv = 0, ddB_uv = 0;//lyz
 	Real W = 0, dW_u = 0.0, dW_v = 0.0, ddW_uu = 0.0, ddW_vv= 0.0, ddW_uv= 0.0;
 
-	for (VRPVK::iterator iter = _rational_points_with_knots.begin(); \
+	for (VRPVK::const_iterator iter = _rational_points_with_knots.begin(); \
 		iter != _rational_points_with_knots.end(); iter++)
 	{
 		ColumnVector Pi(3);	Pi << iter->x() << iter->y() << iter->z();
 		Real Wi = (iter->weight);
 
 		CrossSplinePtr cross_spline = (*iter).cross_spline;
-#ifndef MATRIX_FORM
 		Real Bi = cross_spline->baseFunc(u, v);
-#else
-		Real Bi = cross_spline->baseFunc_m(u, v);
-#endif
 		Real dBi_u = 0.0, dBi_v=0.0, ddBi_uu = 0.0, ddBi_vv = 0.0, ddBi_uv = 0.0;
 		B += Pi * Bi * Wi;
 		W += Bi * Wi;
 
 		if (der1 == DER_U && der2 == DER_U)
 		{
-#ifndef MATRIX_FORM
 			dBi_u = cross_spline->baseFunc1stU(u, v);
 			ddBi_uu = cross_spline->baseFunc2ndU(u, v);
-#else
-			dBi_u = cross_spline->baseFunc1stU_m(u, v);
-			ddBi_uu = cross_spline->baseFunc2ndU_m(u, v);
-#endif
 			dW_u += dBi_u * Wi;
 			ddW_uu += ddBi_uu * Wi;
 			ddB_uu += Pi * ddBi_uu * Wi;
@@ -1021,13 +1018,8 @@ NEWMAT::ReturnMatrix BlendingEquation::computeSecondDerivative( const DERIVE_SUF
 		}
 		else if (der1 == DER_V && der2 == DER_V)
 		{
-#ifndef MATRIX_FORM
 			dBi_v = cross_spline->baseFunc1stV(u, v);
 			ddBi_vv = cross_spline->baseFunc2ndV(u, v);
-#else
-			dBi_v = cross_spline->baseFunc1stV_m(u, v);
-			ddBi_vv = cross_spline->baseFunc2ndV_m(u, v);
-#endif
 			dW_v += dBi_v * Wi;
 			ddW_vv += ddBi_vv * Wi;
 			ddB_vv += Pi * ddBi_vv * Wi;
@@ -1035,19 +1027,11 @@ NEWMAT::ReturnMatrix BlendingEquation::computeSecondDerivative( const DERIVE_SUF
 		}
 		else
 		{
-#ifndef MATRIX_FORM
 			dBi_u = cross_spline->baseFunc1stU(u, v);
 			dBi_v = cross_spline->baseFunc1stV(u, v);
 			ddBi_uu = cross_spline->baseFunc2ndU(u, v);
 			ddBi_vv = cross_spline->baseFunc2ndV(u, v);
 			ddBi_uv = cross_spline->baseFunc2ndUV(u, v);
-#else
-			dBi_u = cross_spline->baseFunc1stU_m(u, v);
-			dBi_v = cross_spline->baseFunc1stV_m(u, v);
-			ddBi_uu = cross_spline->baseFunc2ndU_m(u, v);
-			ddBi_vv = cross_spline->baseFunc2ndV_m(u, v);
-			ddBi_uv = cross_spline->baseFunc2ndUV_m(u, v);
-#endif
 
 			dW_u += dBi_u * Wi;
 			dB_u += Pi * dBi_u * Wi;
@@ -1087,48 +1071,54 @@ NEWMAT::ReturnMatrix BlendingEquation::computeSecondDerivative( const DERIVE_SUF
 
 	ddS.Release();
 	return ddS;
+#endif
 }
 
-NEWMAT::ReturnMatrix BlendingEquation::computeSecondDerivative( const DERIVE_SUFFIX der1, const DERIVE_SUFFIX der2, const Parameter &p )
+NEWMAT::ReturnMatrix BlendingEquation::computeSecondDerivative( const DERIVE_SUFFIX der1, const DERIVE_SUFFIX der2, const Parameter &p ) const
 {
 	return computeSecondDerivative(der1, der2, p.s(), p.t());
 }
 
-NEWMAT::ReturnMatrix BlendingEquation::computeUpToSecondDerivatives( const Real u, const Real v )
+NEWMAT::ReturnMatrix BlendingEquation::computeUpToSecondDerivatives( const Real u, const Real v ) const
 {
+#ifdef MATRIX_FORM
+	Real sums[24], derivatives[18];
+	_basis->evaluate(u, v, 2, sums);
+	rationalDerivatives(sums, 2, derivatives);
+
+	// The columns Suu, Suv, Svv, Su, Sv and S.
+	static const int columns[6] = {9, 12, 15, 3, 6, 0};
+	Matrix Ss(3,6);
+	for (int j=0;j<6;j++)
+	{
+		for (int c=0;c<3;c++)
+		{
+			Ss(c+1,j+1) = derivatives[columns[j]+c];
+		}
+	}
+	Ss.Release(); return Ss;
+#else
 	ColumnVector B(3), dB_u(3), dB_v(3), ddB_uu(3), ddB_vv(3), ddB_uv(3);
 	B = 0, dB_u = 0, dB_v = 0, ddB_uu = 0, ddB_vv = 0, ddB_uv = 0;//lyz
 	Real W = 0, dW_u = 0.0, dW_v = 0.0, ddW_uu = 0.0, ddW_vv= 0.0, ddW_uv= 0.0;
 
-	for (VRPVK::iterator iter = _rational_points_with_knots.begin(); \
+	for (VRPVK::const_iterator iter = _rational_points_with_knots.begin(); \
 		iter != _rational_points_with_knots.end(); iter++)
 	{
 		ColumnVector Pi(3);	Pi << iter->x() << iter->y() << iter->z();
 		Real Wi = (iter->weight);
 
 		CrossSplinePtr cross_spline = (*iter).cross_spline;
-#ifndef MATRIX_FORM
 		Real Bi = cross_spline->baseFunc(u, v);
-#else
-		Real Bi = cross_spline->baseFunc_m(u, v);
-#endif
 		Real dBi_u = 0.0, dBi_v=0.0, ddBi_uu = 0.0, ddBi_vv = 0.0, ddBi_uv = 0.0;
 		B += Pi * Bi * Wi;
 		W += Bi * Wi;
 
-#ifndef MATRIX_FORM
 		dBi_u = cross_spline->baseFunc1stU(u, v);
 		ddBi_uu = cross_spline->baseFunc2ndU(u, v);
 		dBi_v = cross_spline->baseFunc1stV(u, v);
 		ddBi_vv = cross_spline->baseFunc2ndV(u, v);
 		ddBi_uv = cross_spline->baseFunc2ndUV(u, v);
-#else
-		dBi_u = cross_spline->baseFunc1stU_m(u, v);
-		ddBi_uu = cross_spline->baseFunc2ndU_m(u, v);
-		dBi_v = cross_spline->baseFunc1stV_m(u, v);
-		ddBi_vv = cross_spline->baseFunc2ndV_m(u, v);
-		ddBi_uv = cross_spline->baseFunc2ndUV_m(u, v);
-#endif
 
 		dW_u += dBi_u * Wi;
 		dB_u += Pi * dBi_u * Wi;
@@ -1155,15 +1145,70 @@ NEWMAT::ReturnMatrix BlendingEquation::computeUpToSecondDerivatives( const Real
 	Matrix Ss = ddS_uu | ddS_uv | ddS_vv | dS_u | dS_v | S;
 
 	Ss.Release(); return Ss;
+#endif
 }
 
-NEWMAT::ReturnMatrix BlendingEquation::computeUpToSecondDerivatives( const Parameter &p )
+NEWMAT::ReturnMatrix BlendingEquation::computeUpToSecondDerivatives( const Parameter &p ) const
 {
 	return computeUpToSecondDerivatives(p.s(), p.t());
 }
 
+/** 
+  * Calculate E F G L M N from the point and its derivatives stored in the order S, Su, Sv, Suu, Suv, Svv, 3 reals each.
+*/
+static void fundamentalFormByDerivatives(const Real *derivatives, Real *form)
+{
+	const Real *Su = derivatives+3, *Sv = derivatives+6;
+	Real normal[3] = {Su[1]*Sv[2] - Su[2]*Sv[1], Su[2]*Sv[0] - Su[0]*Sv[2], Su[0]*Sv[1] - Su[1]*Sv[0]};
+	Real E = Su[0]*Su[0] + Su[1]*Su[1] + Su[2]*Su[2];
+	Real F = Su[0]*Sv[0] + Su[1]*Sv[1] + Su[2]*Sv[2];
+	Real G = Sv[0]*Sv[0] + Sv[1]*Sv[1] + Sv[2]*Sv[2];
+	Real area = sqrt(E*G-F*F);
+	form[0] = E; form[1] = F; form[2] = G;
+	for (int k=0;k<3;k++)
+	{
+		const Real *Sk = derivatives+9+3*k;
+		form[3+k] = (Sk[0]*normal[0] + Sk[1]*normal[1] + Sk[2]*normal[2]) / area;
+	}
+}
+
+void BlendingEquation::computeDerivatives( const Real u, const Real v, int order, Real *derivatives ) const
+{
+#ifdef MATRIX_FORM
+	Real sums[24];
+	_basis->evaluate(u, v, order, sums);
+	rationalDerivatives(sums, order, derivatives);
+#else
+	Matrix Ss = computeUpToSecondDerivatives(u, v);
+	static const int columns[6] = {6, 4, 5, 1, 2, 3};
+	int n = order < 1 ? 1 : (order < 2 ? 3 : 6);
+	for (int j=0;j<n;j++)
+	{
+		for (int c=0;c<3;c++)
+		{
+			derivatives[3*j+c] = Ss(c+1,columns[j]);
+		}
+	}
+#endif
+}
+
+void BlendingEquation::computeFundamentalForm( const Real u, const Real v, Real *form ) const
+{
+	Real derivatives[18];
+	computeDerivatives(u, v, 2, derivatives);
+	fundamentalFormByDerivatives(derivatives, form);
+}
+
+void BlendingEquation::computeFundamentalForm( const Parameter &p, Real *form ) const
+{
+	computeFundamentalForm(p.s(), p.t(), form);
+}
+
 void BlendingEquation::addRationalPointWithNodes( const std::vector<Real> &u_knots, const std::vector<Real> &v_knots, Point3D &point, Real weight )
 {
+#ifdef MATRIX_FORM
+	_basis->addPoint(u_knots, v_knots, point, weight);
+#else
 	RationalPoint3DWithUVNodes rpwk(point.x(), point.y(), point.z(), weight);
 	
 	rpwk.setUNodes(u_knots);
@@ -1171,141 +1216,87 @@ void BlendingEquation::addRationalPointWithNodes( const std::vector<Real> &u_kno
 	rpwk.setCrossSpline();
 
 	_rational_points_with_knots.push_back(rpwk);
+#endif
 }
 
+void BlendingEquation::prepareTensors( const Parameter &northwest, const Parameter &southeast )
+{
 #ifdef MATRIX_FORM
-void BlendingEquation::getDomain( Real u, Real v, std::vector<K5Domain> &domainu, std::vector<K5Domain> &domainv )
+	_basis->prepare(std::min(northwest.s(), southeast.s()), std::max(northwest.s(), southeast.s()),
+		std::min(northwest.t(), southeast.t()), std::max(northwest.t(), southeast.t()));
+#endif
+}
+
+/** Create the basis of degree DegreeU in u and any supported degree in v. */
+template<int DegreeU>
+static BlendingBasisPtr createBlendingBasis(int degree_v)
 {
-	VRPVK::iterator iter;
-	for (iter = _rational_points_with_knots.begin(); \
-		iter != _rational_points_with_knots.end(); iter++)
+	switch (degree_v)
 	{
-		CubicSplinePtr su = castPtr<CubicSpline>((*iter).cross_spline->spline_u());
-		CubicSplinePtr sv = castPtr<CubicSpline>((*iter).cross_spline->spline_v());
-
-		domainu.push_back(su->domain(u));
-		domainv.push_back(sv->domain(v));
+	case 1: return makePtr<BlendingBasisT<DegreeU, 1> >();
+	case 2: return makePtr<BlendingBasisT<DegreeU, 2> >();
+	case 3: return makePtr<BlendingBasisT<DegreeU, 3> >();
+	case 4: return makePtr<BlendingBasisT<DegreeU, 4> >();
+	case 5: return makePtr<BlendingBasisT<DegreeU, 5> >();
+	default: return BlendingBasisPtr();
 	}
 }
 
-void BlendingEquation::initializeTensorMatrices(Real u, Real v)
+BlendingBasisPtr BlendingBasis::create( int degree_u, int degree_v )
 {
-	VRPVK::iterator iter;
-	for (iter = _rational_points_with_knots.begin(); \
-		iter != _rational_points_with_knots.end(); iter++)
+	switch (degree_u)
 	{
-		CubicSplinePtr su = castPtr<CubicSpline>((*iter).cross_spline->spline_u());
-		CubicSplinePtr sv = castPtr<CubicSpline>((*iter).cross_spline->spline_v());
-
-		Matrix hu = su->H(su->domain(u));
-		Matrix hv = sv->H(sv->domain(v));
-
-		Matrix tp(4,4);
-		if(hu.size() == 0 || hv.size() == 0)
-		{
-			tp = 0;
-		}
-		else
-		{
-			tp = KP(hu.row(1).AsColumn(), hv.row(1));
-		}
-		_tmx += (iter->x() * iter->weight) * tp ;
-		_tmy += (iter->y() * iter->weight) * tp ;
-		_tmz += (iter->z() * iter->weight) * tp ;
-		_tm1 += tp * iter->weight;
+	case 1: return createBlendingBasis<1>(degree_v);
+	case 2: return createBlendingBasis<2>(degree_v);
+	case 3: return createBlendingBasis<3>(degree_v);
+	case 4: return createBlendingBasis<4>(degree_v);
+	case 5: return createBlendingBasis<5>(degree_v);
+	default: return BlendingBasisPtr();
 	}
 }
 
-void BlendingEquation::updateTensorMatrices( std::vector<K5Domain> domainu, std::vector<K5Domain> domainv )
+int BlendingBasis::findSlot( const std::vector<Real> &knots, Real x )
 {
-	std::vector<int> difu, difv;
-	if(domainu != _lastu)
-	{
-		std::transform(domainu.begin(), domainu.end(), _lastu.begin(), std::back_inserter(difu), 
-			[&](K5Domain a, K5Domain b){return a-b;});
-	}
-	if(domainv != _lastv)
-	{
-		std::transform(domainv.begin(), domainv.end(), _lastv.begin(), std::back_inserter(difv),
-			[&](K5Domain a, K5Domain b){return a-b;});
-	}
-		
-	std::vector<int> updateposu, updateposv;
-	if(!difu.empty())
-	{
-		for (std::vector<int>::iterator it = difu.begin();
-			it != difu.end();it++)
-		{
-			if(*it != 0)
-				updateposu.push_back(std::distance(difu.begin(), it));
-		}
-	}
-	
-	if(!difv.empty())
-	{
-		for (std::vector<int>::iterator it = difv.begin();
-			it != difv.end();it++)
-		{
-			if(*it != 0)
-				updateposv.push_back(std::distance(difv.begin(), it));
-		}
-	}
-	
-	std::vector<int> updatepos;
-	if(updateposu.empty())
-	{
-		updatepos = updateposv;
-	}
-	else if(updateposv.empty())
-	{
-		updatepos = updateposu;
-	}
-	else
-	{
-		updatepos.resize(updateposu.size() + updateposv.size());
-		std::vector<int>::iterator it = std::set_union(updateposu.begin(), updateposu.end(),
-			updateposv.begin(), updateposv.end(), updatepos.begin());
-		updatepos.resize(it - updatepos.begin());
-	}
-	
-	for (std::vector<int>::iterator it_pos = updatepos.begin();
-		it_pos != updatepos.end();it_pos++)
-	{
-		RationalPoint3DWithUVNodes rpvk = _rational_points_with_knots[*it_pos];
-		CubicSplinePtr su = castPtr<CubicSpline>(rpvk.cross_spline->spline_u());
-		CubicSplinePtr sv = castPtr<CubicSpline>(rpvk.cross_spline->spline_v());
+	int i = std::upper_bound(knots.begin(), knots.end(), x) - knots.begin();
+	if (i > 0 && knots[i-1] == x)
+		return 2*i-1;
+	if ((i > 0 && isEqual(x, knots[i-1])) || (i < (int)knots.size() && isEqual(x, knots[i])))
+		return -1;
+	return 2*i;
+}
 
-		Matrix tp_old(4,4), tp_new(4,4);
-		if(_lastu[*it_pos] == K5_OUT || _lastv[*it_pos] == K5_OUT)
-		{
-			tp_old = 0;
-		}
-		else
-		{
-			Matrix hu = su->H(_lastu[*it_pos]);
-			Matrix hv = sv->H(_lastv[*it_pos]);
-			tp_old = KP(hu.row(1).AsColumn(), hv.row(1));
-		}
-		if(domainu[*it_pos] == K5_OUT || domainv[*it_pos] == K5_OUT)
-		{
-			tp_new = 0;
-		}
-		else
-		{
-			Matrix hu = su->H(domainu[*it_pos]);
-			Matrix hv = sv->H(domainv[*it_pos]);
-			tp_new = KP(hu.row(1).AsColumn(), hv.row(1));
-		}
+int BlendingBasis::mergeKnots( std::vector<Real> &knots )
+{
+	std::sort(knots.begin(), knots.end());
+	knots.erase(std::unique(knots.begin(), knots.end()), knots.end());
+	if (knots.empty()) return 0;
 
-		_tmx = _tmx + (rpvk.x() * rpvk.weight) * (tp_new - tp_old) ;
-		_tmy = _tmy + (rpvk.y() * rpvk.weight) * (tp_new - tp_old) ;
-		_tmz = _tmz + (rpvk.z() * rpvk.weight) * (tp_new - tp_old) ;
-		_tm1 = _tm1 + (tp_new - tp_old) * rpvk.weight;
+	// The slots are only well defined when no two knots are within the tolerance of isEqual.
+	for (int i=1;i<(int)knots.size();i++)
+	{
+		if (knots[i] - knots[i-1] <= 2.0*M_EPS)
+			return 0;
 	}
+	return 2*knots.size()+1;
 }
 
-#endif
+void BlendingBasis::findSlots( const std::vector<Real> &knots, Real x_min, Real x_max, int &first, int &last )
+{
+	// From the slot of x_min (or the interval before the knot above it) to the slot of x_max.
+	int i = std::lower_bound(knots.begin(), knots.end(), x_min) - knots.begin();
+	first = (i < (int)knots.size() && knots[i] == x_min) ? 2*i+1 : 2*i;
+	int j = std::upper_bound(knots.begin(), knots.end(), x_max) - knots.begin();
+	last = (j > 0 && knots[j-1] == x_max) ? 2*j-1 : 2*j;
+}
 
+Real BlendingBasis::slotParameter( const std::vector<Real> &knots, int slot )
+{
+	int i = slot/2, nknots = knots.size();
+	if (slot % 2 == 1) return knots[i];
+	if (i == 0) return knots[0] - 1.0;
+	if (i == nknots) return knots[nknots-1] + 1.0;
+	return 0.5*(knots[i-1] + knots[i]);
+}
 
 #ifdef use_namespace
 }
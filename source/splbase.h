@@ -297,53 +297,427 @@ public:
 	virtual void setUVNodes(const ColumnVector &ku, const ColumnVector &kv);
 };
 
+/**  
+  *  @class  <BSplineBasis> 
+  *  @brief  B-spline basis function of a compile-time degree
+  *  @note  
+  *  The basis function of degree D is defined by D+2 knots and made of D+1 polynomial pieces, each
+  *  one stored as the coefficients of 1, (u-o), ..., (u-o)^D around an origin o. The origin should be
+  *  near to the knots: the knot intervals of a T-spline may be tiny, and the coefficients of the
+  *  monomials of u far away from them cancel each other. The piece of a parameter is found with the
+  *  same rules as CubicSpline::domain.
+*/
+template<int Degree>
+class BSplineBasis
+{
+public:
+	enum { ORDER = Degree+1, KNOTS = Degree+2 };
+	/** Set the knots and compute the polynomial pieces around the origin. */
+	void setKnots(const Real *knots, Real origin = 0.0);
+	/** Return the i-th knot (0 based). */
+	Real knot(int i) const {return _knots[i];}
+	/** Return the origin of the pieces. */
+	Real origin() const {return _origin;}
+	/** Return the piece (1 to Degree+1) where u is located, 0 if it is out. */
+	int piece(Real u) const;
+	/** Return the coefficients of the piece, 0 if it is out. */
+	const Real *polynomial(int piece) const { return piece > 0 ? _pieces[piece-1] : 0; }
+	/** Compute the coefficients of the piece around another origin, return false if it is out. */
+	bool polynomial(int piece, Real origin, Real *coefficients) const;
+	/** Fill the monomials 1, u, ..., u^Degree and their first and second derivatives if asked for, u relative to the origin. */
+	static void monomials(Real u, Real *powers, Real *first = 0, Real *second = 0);
+private:
+	Real _knots[KNOTS];
+	Real _origin;
+	Real _pieces[ORDER][ORDER];
+};
+
+template<int Degree>
+void BSplineBasis<Degree>::setKnots( const Real *knots, Real origin /*= 0.0*/ )
+{
+	std::copy(knots, knots+KNOTS, _knots);
+	_origin = origin;
+	Real local[KNOTS];
+	for (int i=0;i<KNOTS;i++) local[i] = knots[i] - origin;
+	// Cox-de Boor recursion on the coefficients of each piece, a zero length knot interval is dropped.
+	for (int j=0;j<ORDER;j++)
+	{
+		Real basis[ORDER][ORDER];
+		for (int i=0;i<ORDER;i++)
+		{
+			std::fill(basis[i], basis[i]+ORDER, 0.0);
+		}
+		if (!isZero(local[j+1]-local[j])) basis[j][0] = 1.0;
+		for (int p=1;p<=Degree;p++)
+		{
+			for (int i=0;i+p<=Degree;i++)
+			{
+				Real next[ORDER];
+				std::fill(next, next+ORDER, 0.0);
+				Real left = local[i+p]-local[i], right = local[i+p+1]-local[i+1];
+				for (int c=0;c<=p;c++)
+				{
+					Real shifted = c > 0 ? basis[i][c-1] : 0.0;
+					if (!isZero(left)) next[c] += (shifted - local[i]*basis[i][c]) / left;
+					shifted = c > 0 ? basis[i+1][c-1] : 0.0;
+					if (!isZero(right)) next[c] += (local[i+p+1]*basis[i+1][c] - shifted) / right;
+				}
+				std::copy(next, next+ORDER, basis[i]);
+			}
+		}
+		std::copy(basis[0], basis[0]+ORDER, _pieces[j]);
+	}
+}
+
+template<int Degree>
+int BSplineBasis<Degree>::piece( Real u ) const
+{
+	// A parameter near to a knot is taken on the knot, so that a knot stored with a rounding error
+	// (e.g. 1e-16 for 0) does not cut the basis function off at the end of the T-spline.
+	for (int i=0;i<KNOTS;i++)
+	{
+		if (isEqual(u, _knots[i])) { u = _knots[i]; break; }
+	}
+	for (int j=1;j<=Degree;j++)
+	{
+		if ((_knots[j-1] <= u && _knots[j] > u) || (isEqual(_knots[Degree+1], _knots[j]) && isEqual(u, _knots[j])))
+			return j;
+	}
+	if (_knots[Degree] <= u && _knots[Degree+1] >= u)
+		return ORDER;
+	return 0;
+}
+
+template<int Degree>
+bool BSplineBasis<Degree>::polynomial( int piece, Real origin, Real *coefficients ) const
+{
+	if (piece <= 0) return false;
+	// Taylor shift by Horner's scheme: the new origin is within the support, where the piece is well conditioned.
+	std::copy(_pieces[piece-1], _pieces[piece-1]+ORDER, coefficients);
+	Real delta = origin - _origin;
+	for (int i=0;i<Degree;i++)
+	{
+		for (int k=Degree-1;k>=i;k--) coefficients[k] += delta * coefficients[k+1];
+	}
+	return true;
+}
+
+template<int Degree>
+void BSplineBasis<Degree>::monomials( Real u, Real *powers, Real *first /*= 0*/, Real *second /*= 0*/ )
+{
+	powers[0] = 1.0;
+	for (int i=1;i<ORDER;i++) powers[i] = powers[i-1]*u;
+	if (first)
+	{
+		first[0] = 0.0;
+		for (int i=1;i<ORDER;i++) first[i] = i*powers[i-1];
+	}
+	if (second)
+	{
+		second[0] = 0.0;
+		if (ORDER > 1) second[1] = 0.0;
+		for (int i=2;i<ORDER;i++) second[i] = i*(i-1)*powers[i-2];
+	}
+}
+
+DECLARE_SMARTPTR(BlendingBasis)
+/**  
+  *  @class  <BlendingBasis> 
+  *  @brief  Rational basis of the control points of a blending equation
+  *  @note  
+  *  The basis sums the weighted control points into homogeneous tensors (x, y, z and weight) over the
+  *  monomials of u and v. The pieces of each control point are computed around its own middle knots, and
+  *  moved to the middle of a knot cell when they are summed, so that no monomial is taken far from the
+  *  knots of its cell (see BSplineBasis). The knots of all
+  *  the control points along one direction, sorted and merged, split the parameter line into slots: slot 2i+1 is exactly the i-th knot, slot 2i is the open
+  *  interval before it. The pieces of all the control points are constant in a pair of slots (a knot
+  *  cell), so the tensors of the cells a face covers can be tabulated once by prepare. The degrees are template
+  *  parameters of BlendingBasisT, chosen once by create.
+*/
+class BlendingBasis
+{
+public:
+	virtual ~BlendingBasis() {}
+	/** Create the basis of the degrees, 0 if they are not supported. */
+	static BlendingBasisPtr create(int degree_u, int degree_v);
+public:
+	/** Add a control point with its U and V knots. */
+	virtual void addPoint(const std::vector<Real> &u_knots, const std::vector<Real> &v_knots, const Point3D &point, Real weight) = 0;
+	/** Tabulate the tensors of the knot cells the range overlaps, the evaluation elsewhere sums the control points. */
+	virtual void prepare(Real u_min, Real u_max, Real v_min, Real v_max) = 0;
+	/** 
+	  * Evaluate the homogeneous sums (x, y, z and weight) up to the order (0, 1 or 2) of derivatives,
+	  * stored in the order S, Su, Sv, Suu, Suv, Svv, 4 reals each.
+	*/
+	virtual void evaluate(Real u, Real v, int order, Real *sums) const = 0;
+protected:
+	/** Return the slot of the parameter among the sorted knots, -1 if it is near to but not on a knot. */
+	static int findSlot(const std::vector<Real> &knots, Real x);
+	/** Merge the knots, return the number of slots, 0 if the knots are too close to be told apart. */
+	static int mergeKnots(std::vector<Real> &knots);
+	/** Return a parameter inside the slot. */
+	static Real slotParameter(const std::vector<Real> &knots, int slot);
+	/** Find the first and last slots the range overlaps. */
+	static void findSlots(const std::vector<Real> &knots, Real x_min, Real x_max, int &first, int &last);
+};
+
+/**  
+  *  @class  <BlendingBasisT> 
+  *  @brief  Rational basis of degree DegreeU in u and DegreeV in v
+  *  @note  
+  *  See BlendingBasis. The evaluation is const and allocates nothing.
+*/
+template<int DegreeU, int DegreeV>
+class BlendingBasisT : public BlendingBasis
+{
+public:
+	enum { NU = DegreeU+1, NV = DegreeV+1, TENSOR = NU*NV, SIZE = 4*TENSOR };
+	BlendingBasisT() : _nslots_u(0), _nslots_v(0) {}
+public:
+	virtual void addPoint(const std::vector<Real> &u_knots, const std::vector<Real> &v_knots, const Point3D &point, Real weight);
+	virtual void prepare(Real u_min, Real u_max, Real v_min, Real v_max);
+	virtual void evaluate(Real u, Real v, int order, Real *sums) const;
+protected:
+	struct ControlPoint
+	{
+		BSplineBasis<DegreeU> u;
+		BSplineBasis<DegreeV> v;
+		Real coefficients[4];	/** x, y and z multiplied by the weight, and the weight. */
+	};
+	void accumulate(const ControlPoint &point, int piece_u, int piece_v, Real origin_u, Real origin_v, Real *tensors) const;
+	/** Find the tensors of the parameter and the origin of their monomials. */
+	const Real *findTensors(Real u, Real v, Real *buffer, Real &origin_u, Real &origin_v) const;
+	/** Sum the tensors with the monomials of u and v, both relative to the origin of the tensors. */
+	template<int Order> void sumTensors(const Real *tensors, Real u, Real v, Real *sums) const;
+private:
+	std::vector<ControlPoint> _points;
+	std::vector<Real> _knots_u, _knots_v;
+	std::vector<Real> _origins_u, _origins_v;	/** The origin of the tensors of each tabulated slot. */
+	int _first_u, _first_v;	/** The first tabulated slots. */
+	int _nslots_u, _nslots_v;	/** The numbers of tabulated slots. */
+	std::vector<Real> _tensors;	/** The tensors of each tabulated knot cell. */
+};
+
+template<int DegreeU, int DegreeV>
+void BlendingBasisT<DegreeU, DegreeV>::addPoint( const std::vector<Real> &u_knots, const std::vector<Real> &v_knots, const Point3D &point, Real weight )
+{
+	if (u_knots.size() != DegreeU+2 || v_knots.size() != DegreeV+2)
+		Throw(ProgramException("knot count does not match the degree of blending basis"));
+	ControlPoint cp;
+	cp.u.setKnots(&u_knots[0], u_knots[(DegreeU+1)/2]);
+	cp.v.setKnots(&v_knots[0], v_knots[(DegreeV+1)/2]);
+	cp.coefficients[0] = point.x() * weight;
+	cp.coefficients[1] = point.y() * weight;
+	cp.coefficients[2] = point.z() * weight;
+	cp.coefficients[3] = weight;
+	_points.push_back(cp);
+	// The tabulated tensors no longer cover all the control points.
+	_tensors.clear();
+}
+
+template<int DegreeU, int DegreeV>
+void BlendingBasisT<DegreeU, DegreeV>::prepare( Real u_min, Real u_max, Real v_min, Real v_max )
+{
+	_knots_u.clear(); _knots_v.clear();
+	for (int i=0;i<(int)_points.size();i++)
+	{
+		for (int k=0;k<DegreeU+2;k++) _knots_u.push_back(_points[i].u.knot(k));
+		for (int k=0;k<DegreeV+2;k++) _knots_v.push_back(_points[i].v.knot(k));
+	}
+	_tensors.clear();
+	if (mergeKnots(_knots_u) == 0 || mergeKnots(_knots_v) == 0) return;
+
+	// Only the cells of the range are tabulated, the points support a far larger area.
+	int last_u, last_v;
+	findSlots(_knots_u, u_min, u_max, _first_u, last_u);
+	findSlots(_knots_v, v_min, v_max, _first_v, last_v);
+	_nslots_u = last_u - _first_u + 1;
+	_nslots_v = last_v - _first_v + 1;
+	if (_nslots_u <= 0 || _nslots_v <= 0) return;
+	_origins_u.resize(_nslots_u);
+	_origins_v.resize(_nslots_v);
+	for (int su=0;su<_nslots_u;su++) _origins_u[su] = slotParameter(_knots_u, _first_u + su);
+	for (int sv=0;sv<_nslots_v;sv++) _origins_v[sv] = slotParameter(_knots_v, _first_v + sv);
+
+	// A control point only contributes to the cells between its first and last knots.
+	_tensors.resize(_nslots_u*_nslots_v*SIZE, 0.0);
+	for (int i=0;i<(int)_points.size();i++)
+	{
+		const ControlPoint &point = _points[i];
+		int su_first = std::max(findSlot(_knots_u, point.u.knot(0)), _first_u) - _first_u;
+		int su_last = std::min(findSlot(_knots_u, point.u.knot(DegreeU+1)), last_u) - _first_u;
+		int sv_first = std::max(findSlot(_knots_v, point.v.knot(0)), _first_v) - _first_v;
+		int sv_last = std::min(findSlot(_knots_v, point.v.knot(DegreeV+1)), last_v) - _first_v;
+		for (int su=su_first;su<=su_last;su++)
+		{
+			int piece_u = point.u.piece(_origins_u[su]);
+			for (int sv=sv_first;sv<=sv_last;sv++)
+			{
+				int piece_v = point.v.piece(_origins_v[sv]);
+				accumulate(point, piece_u, piece_v, _origins_u[su], _origins_v[sv], &_tensors[(su*_nslots_v + sv)*SIZE]);
+			}
+		}
+	}
+}
+
+template<int DegreeU, int DegreeV>
+void BlendingBasisT<DegreeU, DegreeV>::accumulate( const ControlPoint &point, int piece_u, int piece_v, Real origin_u, Real origin_v, Real *tensors ) const
+{
+	Real hu[NU], hv[NV];
+	if (!point.u.polynomial(piece_u, origin_u, hu) || !point.v.polynomial(piece_v, origin_v, hv)) return;
+	for (int k=0;k<4;k++)
+	{
+		for (int i=0;i<NU;i++)
+		{
+			for (int j=0;j<NV;j++)
+			{
+				tensors[TENSOR*k+NV*i+j] += point.coefficients[k] * (hu[i] * hv[j]);
+			}
+		}
+	}
+}
+
+template<int DegreeU, int DegreeV>
+const Real * BlendingBasisT<DegreeU, DegreeV>::findTensors( Real u, Real v, Real *buffer, Real &origin_u, Real &origin_v ) const
+{
+	if (!_tensors.empty())
+	{
+		int su = findSlot(_knots_u, u);
+		int sv = findSlot(_knots_v, v);
+		if (su >= _first_u && su < _first_u + _nslots_u && sv >= _first_v && sv < _first_v + _nslots_v)
+		{
+			su -= _first_u;
+			sv -= _first_v;
+			origin_u = _origins_u[su];
+			origin_v = _origins_v[sv];
+			return &_tensors[(su*_nslots_v + sv)*SIZE];
+		}
+	}
+
+	// Not prepared, outside of the prepared range, or the parameter is near to but not on a knot:
+	// sum the tensors of the control points around it.
+	origin_u = u;
+	origin_v = v;
+	std::fill(buffer, buffer+SIZE, 0.0);
+	for (int i=0;i<(int)_points.size();i++)
+	{
+		accumulate(_points[i], _points[i].u.piece(u), _points[i].v.piece(v), u, v, buffer);
+	}
+	return buffer;
+}
+
+template<int DegreeU, int DegreeV>
+void BlendingBasisT<DegreeU, DegreeV>::evaluate( Real u, Real v, int order, Real *sums ) const
+{
+	Real buffer[SIZE], origin_u, origin_v;
+	const Real *tensors = findTensors(u, v, buffer, origin_u, origin_v);
+	switch (order)
+	{
+	case 0: sumTensors<0>(tensors, u - origin_u, v - origin_v, sums); break;
+	case 1: sumTensors<1>(tensors, u - origin_u, v - origin_v, sums); break;
+	default: sumTensors<2>(tensors, u - origin_u, v - origin_v, sums); break;
+	}
+}
+
+template<int DegreeU, int DegreeV> template<int Order>
+void BlendingBasisT<DegreeU, DegreeV>::sumTensors( const Real *tensors, Real u, Real v, Real *sums ) const
+{
+	Real pu[NU], du[NU], ddu[NU], pv[NV], dv[NV], ddv[NV];
+	BSplineBasis<DegreeU>::monomials(u, pu, Order > 0 ? du : 0, Order > 1 ? ddu : 0);
+	BSplineBasis<DegreeV>::monomials(v, pv, Order > 0 ? dv : 0, Order > 1 ? ddv : 0);
+
+	// Rows of the tensors multiplied by the U monomials and their derivatives, then by the V ones.
+	for (int k=0;k<4;k++)
+	{
+		const Real *tk = tensors + TENSOR*k;
+		Real s = 0.0, su = 0.0, sv = 0.0, suu = 0.0, suv = 0.0, svv = 0.0;
+		for (int j=0;j<NV;j++)
+		{
+			Real row = 0.0, drow = 0.0, ddrow = 0.0;
+			for (int i=0;i<NU;i++)
+			{
+				row += pu[i]*tk[NV*i+j];
+				if (Order > 0) drow += du[i]*tk[NV*i+j];
+				if (Order > 1) ddrow += ddu[i]*tk[NV*i+j];
+			}
+			s += row * pv[j];
+			if (Order > 0)
+			{
+				su += drow * pv[j];
+				sv += row * dv[j];
+			}
+			if (Order > 1)
+			{
+				suu += ddrow * pv[j];
+				suv += drow * dv[j];
+				svv += row * ddv[j];
+			}
+		}
+		sums[k] = s;
+		if (Order > 0)
+		{
+			sums[4+k] = su;
+			sums[8+k] = sv;
+		}
+		if (Order > 1)
+		{
+			sums[12+k] = suu;
+			sums[16+k] = suv;
+			sums[20+k] = svv;
+		}
+	}
+}
+
 DECLARE_SMARTPTR(BlendingEquation)
 /**  
   *  @class  <BlendingEquation> 
   *  @brief  Blending equation  
   *  @note  
-  *  BlendingEquation is used to compute the points and normals on a spline surface.
+  *  BlendingEquation is used to compute the points and normals on a spline surface. In the matrix form
+  *  all the evaluations go through a BlendingBasis of the degrees given at construction.
 */
 class BlendingEquation
 {
 public:
-	BlendingEquation();
+	BlendingEquation(int degree_s = 3, int degree_t = 3);
 	~BlendingEquation();
 
 	/** Add a rational point with UV knots. */
 	void addRationalPointWithNodes(const std::vector<Real> &u_knots, const std::vector<Real> &v_knots,
 		Point3D &point, Real weight);
 	/** Computer the point. */
-	Point3D computePoint(Real u, Real v);
+	Point3D computePoint(Real u, Real v) const;
 	/** Computer the point. */
-	Point3D computePoint(const Parameter &p);
+	Point3D computePoint(const Parameter &p) const;
 	/** Computer the normal. */
-	Vector3D computeNormal(Real u, Real v);
+	Vector3D computeNormal(Real u, Real v) const;
 	/** Computer the normal. */
-	Vector3D computeNormal(const Parameter &p);
+	Vector3D computeNormal(const Parameter &p) const;
 	/** Computer the point and normal. */
-	void computePointAndNormal(Real u, Real v, Point3D &point, Vector3D &normal);
+	void computePointAndNormal(Real u, Real v, Point3D &point, Vector3D &normal) const;
 	/** Computer the point and normal. */
-	void computePointAndNormal(const Parameter &p, Point3D &point, Vector3D &normal);
+	void computePointAndNormal(const Parameter &p, Point3D &point, Vector3D &normal) const;
+	/** Tabulate the tensors of the knot cells of the face range once all the points are added, see BlendingBasis::prepare. */
+	void prepareTensors(const Parameter &northwest, const Parameter &southeast);
 
 	/** Derivative direction. */
 	enum DERIVE_SUFFIX{DER_U, DER_V};
 
 	/** Calculate first derivative on the parameter(u,v) with respect to the derivative direction. */
-	ReturnMatrix computeFirstDerivative(const DERIVE_SUFFIX der, const Real u, const Real v);
-	ReturnMatrix computeFirstDerivative(const DERIVE_SUFFIX der, const Parameter &p);
+	ReturnMatrix computeFirstDerivative(const DERIVE_SUFFIX der, const Real u, const Real v) const;
+	ReturnMatrix computeFirstDerivative(const DERIVE_SUFFIX der, const Parameter &p) const;
 
 	/** Calculate all first derivatives on the parameter(u,v) and store them using a 3*3 matrix with column major order
 	1th column: U first derivative;
 	2th column: V first derivative;
 	3th column: point on the surface.
 	*/
-	ReturnMatrix computeUpToFirstDerivatives(const Real u, const Real v);
-	ReturnMatrix computeUpToFirstDerivatives(const Parameter &p);
+	ReturnMatrix computeUpToFirstDerivatives(const Real u, const Real v) const;
+	ReturnMatrix computeUpToFirstDerivatives(const Parameter &p) const;
 
 	/** Calculate second derivative on the parameter(u,v) with respect to the derivative direction. */
-	ReturnMatrix computeSecondDerivative(const DERIVE_SUFFIX der1, const DERIVE_SUFFIX der2, const Real u, const Real v);
-	ReturnMatrix computeSecondDerivative(const DERIVE_SUFFIX der1, const DERIVE_SUFFIX der2, const Parameter &p);
+	ReturnMatrix computeSecondDerivative(const DERIVE_SUFFIX der1, const DERIVE_SUFFIX der2, const Real u, const Real v) const;
+	ReturnMatrix computeSecondDerivative(const DERIVE_SUFFIX der1, const DERIVE_SUFFIX der2, const Parameter &p) const;
 	
 	/** Calculate all first and second derivatives on the parameter(u,v) and store them using a 3*6 matrix with column major order
 	1th column: U second derivative;
@@ -353,20 +727,22 @@ public:
 	5th column: V first derivative;
 	6th column: point on the surface.
 	*/
-	ReturnMatrix computeUpToSecondDerivatives(const Real u, const Real v);
-	ReturnMatrix computeUpToSecondDerivatives(const Parameter &p);
-
-protected:
-	/** Initialize tensor matrices. */
-	void initializeTensorMatrices(Real u, Real v);
-	/** Update tensor matrices. */
-	void updateTensorMatrices(std::vector<K5Domain> domainu, std::vector<K5Domain> domainv);
+	ReturnMatrix computeUpToSecondDerivatives(const Real u, const Real v) const;
+	ReturnMatrix computeUpToSecondDerivatives(const Parameter &p) const;
+	/** 
+	  * Calculate the point and its derivatives up to the order (0, 1 or 2) without allocation, stored in the order
+	  * S, Su, Sv, Suu, Suv, Svv, 3 reals each (3, 9 or 18 reals).
+	*/
+	void computeDerivatives(const Real u, const Real v, int order, Real *derivatives) const;
+	/** Calculate the first and second fundamental form coefficients E F G L M N into form[0..5] in one pass without allocation. */
+	void computeFundamentalForm(const Real u, const Real v, Real *form) const;
+	void computeFundamentalForm(const Parameter &p, Real *form) const;
 
 private:
 	class RationalPoint3DWithUVNodes : public Point3D
 	{
 	public:
-		RationalPoint3DWithUVNodes(Real x, Real y, Real z, Real w) : Point3D(x, y, z), weight(w) {cross_spline = makePtr<CrossCubicSpline>();}
+		RationalPoint3DWithUVNodes(Real x, Real y, Real z, Real w) : Point3D(x, y, z), weight(w) {}
 		~RationalPoint3DWithUVNodes() {}
 	public:
 		Real weight;				
@@ -376,6 +752,10 @@ private:
 		/** Set UV knots for the cross spline belong to the control point. */
 		void setCrossSpline()
 		{
+			if (u_knots.size() == 4 && v_knots.size() == 4)
+				cross_spline = makePtr<CrossQuadraticSpline>();
+			else
+				cross_spline = makePtr<CrossCubicSpline>();
 			cross_spline->setUVNodes(getUNodesAsColumnVector(), getVNodesAsColumnVector());
 		}
 		/** Set the U knots. */
@@ -394,7 +774,7 @@ private:
 		ColumnVector getUNodesAsColumnVector()
 		{
 			ColumnVector unodes(u_knots.size());
-			for (int i=0;i<u_knots.size();i++)
+			for (int i=0;i<(int)u_knots.size();i++)
 			{
 				unodes(i+1) = u_knots[i];
 			}
@@ -404,7 +784,7 @@ private:
 		ColumnVector getVNodesAsColumnVector()
 		{
 			ColumnVector vnodes(v_knots.size());
-			for (int i=0;i<v_knots.size();i++)
+			for (int i=0;i<(int)v_knots.size();i++)
 			{
 				vnodes(i+1) = v_knots[i];
 			}
@@ -412,15 +792,8 @@ private:
 		}
 	};
 	typedef std::vector<RationalPoint3DWithUVNodes> VRPVK;
-	CrossSplinePtr _cross_spline;			
-	VRPVK _rational_points_with_knots;
-
-	Matrix _tmx, _tmy, _tmz, _tm1;
-
-	std::vector<K5Domain> _lastu;/** All last stage U domains. */
-	std::vector<K5Domain> _lastv;/** All last stage V domains. */
-	/** Return all domains where parameter(u,v) located according to all the control points on the T-face. */
-	void getDomain(Real u, Real v, std::vector<K5Domain> &domainu, std::vector<K5Domain> &domainv);
+	VRPVK _rational_points_with_knots;	/** The control points of the universal algorithm. */
+	BlendingBasisPtr _basis;	/** The basis of the matrix form. */
 };
 
 #ifdef use_namespace
@@ -0,0 +1,233 @@
+/*
+TSPLINE -- A T-spline object oriented package in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 3.0 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building, 
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+   - Created.
+-------------------------------------------------------------------------------
+*/
+
+#include <symbol.h>
+#include <cctype>
+#include <cstdlib>
+
+#ifdef use_namespace
+namespace TSPLINE {
+	using namespace NEWMAT;
+#endif
+
+TSymbolTable* TSymbolTable::_instance = 0;
+
+TSymbolTable* TSymbolTable::Instance()
+{
+	static std::once_flag flag;
+	std::call_once(flag, []() { _instance = new TSymbolTable(); });
+	return _instance;
+}
+
+TSymbolTable::TSymbolTable() :
+	_chunks(new Symbol*[MAX_CHUNKS]()), _size(0), _plain(new Table(1024)), _indexed(new Table(1024))
+{
+}
+
+TSymbolTable::Table::Table( int capacity ) :
+	mask(capacity-1), count(0), slots(new std::atomic<int>[capacity])
+{
+	for (int i=0;i<capacity;i++) slots[i].store(E_NOSYMBOL, std::memory_order_relaxed);
+}
+
+TSymbolTable::Table::~Table()
+{
+	delete [] slots;
+}
+
+int TSymbolTable::intern( const std::string &name )
+{
+	if (name.empty()) return E_NOSYMBOL;
+	return internName(name);
+}
+
+int TSymbolTable::intern( const std::string &prefix, int index )
+{
+	if (prefix.empty() || index < 0 || isdigit((unsigned char)prefix[prefix.size()-1]))
+	{
+		return internName(prefix + to_string((long long)index));
+	}
+	return internIndexed(internPlain(prefix), index);
+}
+
+int TSymbolTable::find( const std::string &name )
+{
+	if (name.empty()) return E_NOSYMBOL;
+	std::string prefix;
+	int index;
+	if (splitIndex(name, prefix, index))
+	{
+		int pf = findPlain(prefix);
+		return pf == E_NOSYMBOL ? E_NOSYMBOL : findIndexed(pf, index);
+	}
+	return findPlain(name);
+}
+
+std::string TSymbolTable::name( int symbol )
+{
+	if (symbol < 0 || symbol >= _size.load(std::memory_order_acquire)) return "";
+	const Symbol &sym = symbolAt(symbol);
+	if (sym.prefix == E_NOSYMBOL)
+	{
+		return sym.name;
+	}
+	return symbolAt(sym.prefix).name + to_string((long long)sym.index);
+}
+
+int TSymbolTable::size()
+{
+	return _size.load(std::memory_order_acquire);
+}
+
+int TSymbolTable::internName( const std::string &name )
+{
+	std::string prefix;
+	int index;
+	if (splitIndex(name, prefix, index))
+	{
+		return internIndexed(internPlain(prefix), index);
+	}
+	return internPlain(name);
+}
+
+int TSymbolTable::internPlain( const std::string &name )
+{
+	int symbol = findPlain(name);
+	if (symbol != E_NOSYMBOL) return symbol;
+	std::lock_guard<std::mutex> lock(_mutex);
+	// Another thread may have inserted the name since the lookup.
+	symbol = findPlain(name);
+	if (symbol != E_NOSYMBOL) return symbol;
+	return insert(_plain, hashPlain(name), name, E_NOSYMBOL, 0);
+}
+
+int TSymbolTable::internIndexed( int prefix, int index )
+{
+	int symbol = findIndexed(prefix, index);
+	if (symbol != E_NOSYMBOL) return symbol;
+	std::lock_guard<std::mutex> lock(_mutex);
+	symbol = findIndexed(prefix, index);
+	if (symbol != E_NOSYMBOL) return symbol;
+	return insert(_indexed, hashIndexed(prefix, index), "", prefix, index);
+}
+
+int TSymbolTable::findPlain( const std::string &name )
+{
+	const Table *table = _plain.load(std::memory_order_acquire);
+	for (size_t slot = hashPlain(name) & table->mask;;slot = (slot+1) & table->mask)
+	{
+		int symbol = table->slots[slot].load(std::memory_order_acquire);
+		if (symbol == E_NOSYMBOL || symbolAt(symbol).name == name) return symbol;
+	}
+}
+
+int TSymbolTable::findIndexed( int prefix, int index )
+{
+	const Table *table = _indexed.load(std::memory_order_acquire);
+	for (size_t slot = hashIndexed(prefix, index) & table->mask;;slot = (slot+1) & table->mask)
+	{
+		int symbol = table->slots[slot].load(std::memory_order_acquire);
+		if (symbol == E_NOSYMBOL) return symbol;
+		const Symbol &sym = symbolAt(symbol);
+		if (sym.prefix == prefix && sym.index == index) return symbol;
+	}
+}
+
+int TSymbolTable::insert( std::atomic<Table *> &table, size_t hash, const std::string &name, int prefix, int index )
+{
+	// The symbol is written before it is published by the size and the slot (release), 
+	// so a lookup which sees either of them (acquire) sees the whole symbol.
+	int symbol = _size.load(std::memory_order_relaxed);
+	if ((symbol >> CHUNK_BITS) >= MAX_CHUNKS) Throw(ProgramException("symbol table is full"));
+	if ((symbol & (CHUNK_SIZE-1)) == 0) _chunks[symbol >> CHUNK_BITS] = new Symbol[CHUNK_SIZE];
+	Symbol &sym = _chunks[symbol >> CHUNK_BITS][symbol & (CHUNK_SIZE-1)];
+	sym.name = name;
+	sym.prefix = prefix;
+	sym.index = index;
+	_size.store(symbol+1, std::memory_order_release);
+
+	Table *current = table.load(std::memory_order_relaxed);
+	if (2*(current->count+1) > current->mask+1)
+	{
+		// The lookups in flight keep reading the old table, which still finds every older symbol.
+		Table *larger = new Table(2*(current->mask+1));
+		for (int i=0;i<=current->mask;i++)
+		{
+			int old = current->slots[i].load(std::memory_order_relaxed);
+			if (old == E_NOSYMBOL) continue;
+			size_t slot = hashOf(symbolAt(old)) & larger->mask;
+			while (larger->slots[slot].load(std::memory_order_relaxed) != E_NOSYMBOL) slot = (slot+1) & larger->mask;
+			larger->slots[slot].store(old, std::memory_order_relaxed);
+		}
+		larger->count = current->count;
+		table.store(larger, std::memory_order_release);
+		_retired.push_back(current);
+		current = larger;
+	}
+	size_t slot = hash & current->mask;
+	while (current->slots[slot].load(std::memory_order_relaxed) != E_NOSYMBOL) slot = (slot+1) & current->mask;
+	current->slots[slot].store(symbol, std::memory_order_release);
+	current->count++;
+	return symbol;
+}
+
+size_t TSymbolTable::hashIndexed( int prefix, int index )
+{
+	// Mix the key, consecutive indices would otherwise fill consecutive slots.
+	unsigned long long key = ((unsigned long long)(unsigned int)prefix << 32) | (unsigned int)index;
+	key ^= key >> 33; key *= 0xff51afd7ed558ccdULL;
+	key ^= key >> 33; key *= 0xc4ceb9fe1a85ec53ULL;
+	key ^= key >> 33;
+	return (size_t)key;
+}
+
+bool TSymbolTable::splitIndex( const std::string &name, std::string &prefix, int &index )
+{
+	// Only the canonical decimal form is split, so that the name can be composed back exactly.
+	int pos = name.size();
+	while (pos > 0 && isdigit((unsigned char)name[pos-1])) pos--;
+	int ndigits = name.size() - pos;
+	if (pos == 0 || ndigits == 0 || ndigits > 9) return false;
+	if (name[pos] == '0' && ndigits > 1) return false;
+	prefix = name.substr(0, pos);
+	index = atoi(name.c_str() + pos);
+	return true;
+}
+
+#ifdef use_namespace
+}
+#endif
@@ -0,0 +1,136 @@
+/*
+T-SPLINE -- A T-spline object oriented library in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 2.1 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building, 
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+- Created.
+-------------------------------------------------------------------------------
+*/
+
+/**  @file  [symbol]  
+  *  @brief  Interned names of T-objects.
+  *  @author  <agent>  
+  *  @date  <2026.10.19>  
+  *  @version  <v1.0>  
+  *  @note  
+  *  This file contains a symbol table which maps the names of T-objects to integer symbols.
+*/
+
+#ifndef SYMBOL_H
+#define SYMBOL_H
+
+#include <utils.h>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+
+#ifdef use_namespace
+namespace TSPLINE {
+	using namespace NEWMAT;
+#endif
+
+/** The symbol of an unnamed T-object. */
+#define E_NOSYMBOL -1
+
+/**  
+  *  @class  <TSymbolTable> 
+  *  @brief  The symbol table of T-object names.
+  *  @note  
+  *  TSymbolTable interns names into integer symbols, so that T-objects carry an integer instead of a string 
+  *  and are compared by integers. A name made of a prefix and a decimal index, e.g. "v123", is interned 
+  *  as the pair (prefix, index) and its string is only composed when it is asked for, so generated names 
+  *  cost no string allocation at all. "v123" and ("v", 123) always give the same symbol. 
+  *  The table is shared by all T-splines and is thread-safe. A symbol never changes once it is published, 
+  *  so the lookups (find, name and the interning of a known name) take no lock; only the insertion of a 
+  *  new symbol is serialized.
+*/
+class TSymbolTable
+{
+public:
+	static TSymbolTable* Instance();
+public:
+	/** Intern a name, return E_NOSYMBOL for an empty name. */
+	int intern(const std::string &name);
+	/** Intern the name composed of a prefix and an index. */
+	int intern(const std::string &prefix, int index);
+	/** Find the symbol of a name without interning it, return E_NOSYMBOL if it is not interned. */
+	int find(const std::string &name);
+	/** Return the name of a symbol, an empty string for E_NOSYMBOL. */
+	std::string name(int symbol);
+	/** Return the number of symbols. */
+	int size();
+protected:
+	enum { CHUNK_BITS = 14, CHUNK_SIZE = 1 << CHUNK_BITS, MAX_CHUNKS = 1 << 17 };
+	struct Symbol
+	{
+		Symbol() : prefix(E_NOSYMBOL), index(0) {}
+		std::string name;
+		int prefix;
+		int index;
+	};
+	/** An open addressing hash table of symbols, replaced by a table of twice the capacity when half full. */
+	struct Table
+	{
+		Table(int capacity);
+		~Table();
+		int mask;
+		int count;	/** Only changed under the mutex. */
+		std::atomic<int> *slots;
+	};
+	int internName(const std::string &name);
+	int internPlain(const std::string &name);
+	int internIndexed(int prefix, int index);
+	int findPlain(const std::string &name);
+	int findIndexed(int prefix, int index);
+	/** Publish a new symbol and its slot in the table, the mutex must be held. */
+	int insert(std::atomic<Table *> &table, size_t hash, const std::string &name, int prefix, int index);
+	const Symbol &symbolAt(int symbol) { return _chunks[symbol >> CHUNK_BITS][symbol & (CHUNK_SIZE-1)]; }
+	size_t hashOf(const Symbol &symbol) { return symbol.prefix == E_NOSYMBOL ? hashPlain(symbol.name) : hashIndexed(symbol.prefix, symbol.index); }
+	size_t hashPlain(const std::string &name) { return std::hash<std::string>()(name); }
+	size_t hashIndexed(int prefix, int index);
+	bool splitIndex(const std::string &name, std::string &prefix, int &index);
+private:
+	static TSymbolTable* _instance;
+	TSymbolTable();
+	~TSymbolTable(){};
+private:
+	Symbol **_chunks;
+	std::atomic<int> _size;
+	std::atomic<Table *> _plain;
+	std::atomic<Table *> _indexed;
+	std::vector<Table *> _retired;	/** Outgrown tables, lookups in flight may still read them. */
+	std::mutex _mutex;
+};
+
+#ifdef use_namespace
+}
+#endif
+
+#endif
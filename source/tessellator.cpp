@@ -71,6 +71,7 @@ namespace TSPLINE {
 	void TTessellator::setResolution(Real chordal_error)
 	{
 		_chordal_error = chordal_error;
+		_face_meshes.clear();
 	}
 
 	void TTessellator::interpolateFace(const TFacePtr &face, TriMeshPtr &tri_mesh)
@@ -95,22 +96,81 @@ namespace TSPLINE {
 		return interpolateFace(_finder->findByName<TFace>(face));
 	}
 
-	TriMeshPtr TTessellator::interpolateAll()
+	void TTessellator::interpolateFaces(const TFacVector &faces, TriMshVector &tri_meshes)
 	{
-#ifdef USE_OMP
-		TriMshVector trimeshes;
-		TFacVector faces;
-		_finder->findObjects<TFace>(faces);
+		int nfaces = faces.size();
+		// The threads can not throw, a T-face without blending T-nodes is reported before them.
+		for (int i = 0; i < nfaces; i++)
+		{
+			if (faces[i]->sizeBlendingNodes() == 0)
+				Throw(ProgramException("T-face without blending T-nodes can not be evaluated"));
+		}
 
-#pragma omp parallel for
-		for (int i = 0; i<faces.size(); i++)
+		// The first T-face reaching a T-edge discretes it, the same as interpolateFace one by one.
+		std::set<std::string> discreted;
+		for (DsctEdgVIterator iter = _discreted_edges.begin(); iter != _discreted_edges.end(); iter++)
+		{
+			discreted.insert((*iter)->getName());
+		}
+		std::vector<TLnkVector> owned_links(nfaces);
+		for (int i = 0; i < nfaces; i++)
 		{
-			TFacePtr face = faces[i];
-			TriMeshPtr trimesh = makePtr<TriMesh>(face->getName());
+			TLnkVector links;
+			TFaceTessellator::findBoundaryLinks(faces[i], links);
+			for (TLnkVIterator iter = links.begin(); iter != links.end(); iter++)
+			{
+				if (discreted.insert((*iter)->getTEdge()->getName()).second)
+					owned_links[i].push_back(*iter);
+			}
+		}
 
-			trimesh = interpolateFace(face);
-			trimeshes.push_back(trimesh);
+		TFacDrvVector derivators(nfaces);
+		std::vector<std::vector<std::vector<Parameter> > > owned_parameters(nfaces);
+#ifdef USE_OMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+		for (int i = 0; i < nfaces; i++)
+		{
+			derivators[i] = makePtr<TFaceDerivator>(_spline, faces[i]);
+			TFaceTessellator tessellator(derivators[i]);
+			tessellator.setBoundaryRatio(_chordal_error);
+			for (TLnkVIterator iter = owned_links[i].begin(); iter != owned_links[i].end(); iter++)
+			{
+				owned_parameters[i].push_back(tessellator.processLink(*iter));
+			}
 		}
+		for (int i = 0; i < nfaces; i++)
+		{
+			for (int j = 0; j < (int)owned_links[i].size(); j++)
+			{
+				DiscretedEdgePtr discreted_edge = makePtr<DiscretedEdge>(owned_links[i][j]->getTEdge()->getName());
+				discreted_edge->setDisperseParameters(owned_parameters[i][j]);
+				_discreted_edges.push_back(discreted_edge);
+			}
+		}
+
+		// All the T-edges are discreted now, so the T-faces only read them.
+		tri_meshes.resize(nfaces);
+#ifdef USE_OMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+		for (int i = 0; i < nfaces; i++)
+		{
+			tri_meshes[i] = makePtr<TriMesh>(faces[i]->getName());
+			TFaceTessellator tessellator(derivators[i]);
+			tessellator.setBoundaryRatio(_chordal_error);
+			tessellator.setInnerResolution(_chordal_error);
+			tessellator.process(tri_meshes[i], _discreted_edges);
+		}
+	}
+
+	TriMeshPtr TTessellator::interpolateAll()
+	{
+#ifdef USE_OMP
+		TriMshVector trimeshes;
+		TFacVector faces;
+		findBlendedFaces(faces);
+		interpolateFaces(faces, trimeshes);
 
 		TriMeshPtr tri_mesh = makePtr<TriMesh>(_spline->getName());
 		TriMshVIterator it = trimeshes.begin();
@@ -121,7 +181,7 @@ namespace TSPLINE {
 		return tri_mesh;
 #else
 		TFacVector faces;
-		_finder->findObjects<TFace>(faces);
+		findBlendedFaces(faces);
 		TriMeshPtr tri_mesh = makePtr<TriMesh>(_spline->getName());
 		TFacVIterator iter;
 		for (iter = faces.begin(); iter != faces.end(); iter++)
@@ -135,6 +195,43 @@ namespace TSPLINE {
 #endif // USE_OMP
 	}
 
+	TriMeshPtr TTessellator::updateAll()
+	{
+		TFacVector faces;
+		findBlendedFaces(faces);
+		TriMeshPtr tri_mesh = makePtr<TriMesh>(_spline->getName());
+		TFacVIterator iter;
+		for (iter = faces.begin(); iter != faces.end(); iter++)
+		{
+			TriMeshPtr &face_mesh = _face_meshes[*iter];
+			if (!face_mesh)
+			{
+				face_mesh = interpolateFace(*iter);
+			}
+			tri_mesh->merge(face_mesh);
+		}
+		return tri_mesh;
+	}
+
+	void TTessellator::findBlendedFaces(TFacVector &faces)
+	{
+		TFacVector all;
+		_finder->findObjects<TFace>(all);
+		for (TFacVIterator iter = all.begin(); iter != all.end(); iter++)
+		{
+			if ((*iter)->sizeBlendingNodes() > 0) faces.push_back(*iter);
+		}
+	}
+
+	void TTessellator::invalidateFaces(const TFacVector &faces)
+	{
+		TFacVConstIterator iter;
+		for (iter = faces.begin(); iter != faces.end(); iter++)
+		{
+			_face_meshes.erase(*iter);
+		}
+	}
+
 	TFaceTessellator::TFaceTessellator(const TFaceDerivatorPtr &derivator) :
 		_derivator(derivator), _boundary_chordal_error(0.1), _chordal_error(0.1)
 	{
@@ -191,7 +288,10 @@ namespace TSPLINE {
 		for (auto iter = _parameters.begin(); iter != _parameters.end(); iter++)
 		{
 			if (_derivator->pointAndNormalDerive(*iter, point, normal))
+			{
 				tri_mesh->addPointNormal(point, normal);
+				tri_mesh->addParameter(*iter);
+			}
 		}
 		//triangles added to trimesh
 		for (TriVIterator iter = triangles.begin(); iter != triangles.end(); iter++)
@@ -206,17 +306,9 @@ namespace TSPLINE {
 	TriVector TFaceTessellator::processBoundary(DsctEdgVector &discreted_edges)
 	{
 		TFacePtr face = _derivator->getFace();
-		TLnkVector nlinks, wlinks, slinks, elinks;
-
-		face->findEastLinks(elinks);
-		face->findNorthLinks(nlinks);
-		face->findSouthLinks(wlinks);
-		face->findWestLinks(slinks);
-
-		processLinkVector(elinks, discreted_edges);
-		processLinkVector(nlinks, discreted_edges);
-		processLinkVector(slinks, discreted_edges);
-		processLinkVector(wlinks, discreted_edges);
+		TLnkVector links;
+		findBoundaryLinks(face, links);
+		processLinkVector(links, discreted_edges);
 
 		purifyParameters(0);
 
@@ -268,10 +360,11 @@ namespace TSPLINE {
 		for (; iter != links.end(); iter++)
 		{
 			TEdgePtr edge = (*iter)->getTEdge();
+			std::string edge_name = edge->getName();
 			std::vector<DiscretedEdgePtr>::iterator it = std::find_if(discreted_edges.begin(), discreted_edges.end(),
-				[edge](const DiscretedEdgePtr &discreted_edge)
+				[&edge_name](const DiscretedEdgePtr &discreted_edge)
 			{
-				return discreted_edge->getName() == edge->getName();
+				return discreted_edge->getName() == edge_name;
 			});
 			if (it != discreted_edges.end())	//if the edge is already dispersed 
 			{
@@ -281,7 +374,7 @@ namespace TSPLINE {
 			{
 				disperse_link_parameter = processLink(*iter);
 
-				DiscretedEdgePtr discreted_edge = makePtr<DiscretedEdge>(edge->getName());
+				DiscretedEdgePtr discreted_edge = makePtr<DiscretedEdge>(edge_name);
 				discreted_edge->setDisperseParameters(disperse_link_parameter);
 				discreted_edges.push_back(discreted_edge);
 			}
@@ -307,6 +400,21 @@ namespace TSPLINE {
 		}
 	}
 
+	void TFaceTessellator::findBoundaryLinks(const TFacePtr &face, TLnkVector &links)
+	{
+		TLnkVector nlinks, wlinks, slinks, elinks;
+
+		face->findEastLinks(elinks);
+		face->findNorthLinks(nlinks);
+		face->findSouthLinks(wlinks);
+		face->findWestLinks(slinks);
+
+		links.insert(links.end(), elinks.begin(), elinks.end());
+		links.insert(links.end(), nlinks.begin(), nlinks.end());
+		links.insert(links.end(), slinks.begin(), slinks.end());
+		links.insert(links.end(), wlinks.begin(), wlinks.end());
+	}
+
 	std::vector<Parameter> TFaceTessellator::processLink(const TLinkPtr &link)
 	{
 		TLinkTessellator tessellator(link, _derivator);
@@ -598,7 +706,8 @@ namespace TSPLINE {
 
 			while (p.s() < end_p.s())
 			{
-				ColumnVector form = _derivator->firstAndSecondFundamentalForm(p);
+				Real form[6];
+				_derivator->fundamentalForm(p, form);
 				Real forward_step = computeForwardSteps(form, u_direction);
 
 				forward_step = min(forward_step, limit_forward_step);
@@ -614,7 +723,8 @@ namespace TSPLINE {
 			Real limit_forward_step = length_edge / 5;
 			while (p.t() < end_p.t())
 			{
-				ColumnVector form = _derivator->firstAndSecondFundamentalForm(p);
+				Real form[6];
+				_derivator->fundamentalForm(p, form);
 				Real forward_step = computeForwardSteps(form, u_direction);
 				forward_step = min(forward_step, limit_forward_step);
 
@@ -628,14 +738,14 @@ namespace TSPLINE {
 		return disperse_link_parameter;
 	}
 
-	Real TLinkTessellator::computeForwardSteps(const ColumnVector &form, bool u_direction)
+	Real TLinkTessellator::computeForwardSteps(const Real *form, bool u_direction)
 	{
 		return computeChordal(form, _chordal_error, u_direction);
 	}
 
-	Real TLinkTessellator::computeChordal(const ColumnVector &form, Real e, bool u_direction)
+	Real TLinkTessellator::computeChordal(const Real *form, Real e, bool u_direction)
 	{
-		Real E = form(1), F = form(2), G = form(3), L = form(4), M = form(5), N = form(6);
+		Real E = form[0], G = form[2], L = form[3], N = form[5];
 		Real d = 0.1;
 		if (u_direction)
 		{
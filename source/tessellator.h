@@ -97,6 +97,12 @@ namespace TSPLINE {
 	*  @brief  T-spline tessellation.
 	*  @note
 	*  TTessellator require the target T-spline to be set, and will implement the global tessellation on it.
+	*  The Trimeshes of the T-faces are cached by updateAll, so after an edit only the invalidated T-faces
+	*  are tessellated again. The discreted T-edges are kept, so the boundaries stay shared with the neighbours.
+	*  interpolateFaces discretes the shared T-edges first, in the same order as the T-faces would one by one,
+	*  and then tessellates the T-faces in parallel, so the result does not depend on the number of threads.
+	*  The T-faces outside the region of a partial load (see RhBuilder) have no blending T-nodes, they are left
+	*  out of interpolateAll and updateAll, and converting one of them throws.
 	*/
 	class TTessellator
 	{
@@ -109,7 +115,7 @@ namespace TSPLINE {
 		void setResolution(Real chordal_error);
 
 	public:
-		/** Convert all T-faces into a Trimesh. */
+		/** Convert all T-faces with blending T-nodes into a Trimesh. */
 		TriMeshPtr interpolateAll();
 		/** Convert a T-face into a Trimesh. */
 		TriMeshPtr interpolateFace(const TFacePtr &face);
@@ -117,6 +123,16 @@ namespace TSPLINE {
 		TriMeshPtr interpolateFace(const std::string &face);
 		/** Convert and add a T-face into a Trimesh. */
 		void interpolateFace(const TFacePtr &face, TriMeshPtr &tri_mesh);
+		/** Convert each T-face into a Trimesh, the T-faces are tessellated in parallel. */
+		void interpolateFaces(const TFacVector &faces, TriMshVector &tri_meshes);
+		/** Convert all T-faces with blending T-nodes into a Trimesh, reusing the cached Trimeshes of the T-faces not invalidated. */
+		TriMeshPtr updateAll();
+		/** Invalidate the cached Trimeshes of the T-faces. */
+		void invalidateFaces(const TFacVector &faces);
+
+	protected:
+		/** Find the T-faces with blending T-nodes. */
+		void findBlendedFaces(TFacVector &faces);
 
 	private:
 		TSplinePtr _spline;
@@ -124,6 +140,7 @@ namespace TSPLINE {
 		TFinderPtr _finder;
 		Real _chordal_error;
 		DsctEdgVector _discreted_edges;
+		std::map<TFacePtr, TriMeshPtr> _face_meshes;
 	};
 
 	/**
@@ -145,10 +162,13 @@ namespace TSPLINE {
 		void setInnerResolution(Real chordal_error) { _chordal_error = chordal_error; }
 		/** Process the tessellation of the T-face into a TriMesh. */
 		void process(const TriMeshPtr &tri_mesh, DsctEdgVector &discreted_edges);
+		/** Process the discretion of a boundary T-link of the T-face. */
+		std::vector<Parameter> processLink(const TLinkPtr &link);
+		/** Find the boundary T-links of a T-face in the order they are discreted by process. */
+		static void findBoundaryLinks(const TFacePtr &face, TLnkVector &links);
 
 	protected:
 		void processLinkVector(const TLnkVector &links, DsctEdgVector &discreted_edges);
-		std::vector<Parameter> processLink(const TLinkPtr &link);
 
 	private:
 		/** Process the tessellation of the T-face boundary into a TriMesh. */
@@ -192,8 +212,8 @@ namespace TSPLINE {
 		std::vector<Parameter> process();
 
 	private:
-		Real computeForwardSteps(const ColumnVector &form, bool u_direction);
-		Real computeChordal(const ColumnVector &form, Real e, bool u_direction);
+		Real computeForwardSteps(const Real *form, bool u_direction);
+		Real computeChordal(const Real *form, Real e, bool u_direction);
 
 	private:
 		TLinkPtr _link;
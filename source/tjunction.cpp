@@ -43,8 +43,8 @@ namespace TSPLINE {
 	using namespace NEWMAT;
 #endif
 
-TJunction::TJunction( const TVertexPtr &vertex ) :
-	_vertex(vertex), _orientation(E_CENTER)
+TJunction::TJunction( const TVertexPtr &vertex, const TArenaPtr &arena ) :
+	_vertex(vertex), _orientation(E_CENTER), _arena(arena)
 {
 	fill(vertex->getNorth(), vertex->getWest(), vertex->getSouth(), vertex->getEast());
 }
@@ -99,23 +99,57 @@ void TJunction::fill( const TVertexPtr &vertex )
 
 void TJunction::patchVirtuals()
 {
-	if (valid())
-	{
-		switch (_orientation)
-		{
-		case E_NORTH: // north
-			patchNorthVirtuals();
-			break;
-		case E_WEST: // west
-			patchWestVirtuals();
-			break;
-		case E_SOUTH: // south
-			patchSouthVirtuals();
-			break;
-		case E_EAST: // east
-			patchEastVirtuals();
-			break;
-		}
+	TJunctionExtension extension;
+	if (deriveExtension(extension))
+	{
+		patchVirtuals(extension);
+	}
+}
+
+bool TJunction::deriveExtension( TJunctionExtension &extension )
+{
+	if (!valid())
+	{
+		return false;
+	}
+
+	extension.vertex = _vertex;
+	extension.orientation = _orientation;
+	extension.face = _left->getRightFace();
+	switch (_orientation)
+	{
+	case E_NORTH: // north
+		extension.parameter = intersectNorth(extension.face, _vertex->getS());
+		break;
+	case E_WEST: // west
+		extension.parameter = intersectWest(extension.face, _vertex->getT());
+		break;
+	case E_SOUTH: // south
+		extension.parameter = intersectSouth(extension.face, _vertex->getS());
+		break;
+	case E_EAST: // east
+		extension.parameter = intersectEast(extension.face, _vertex->getT());
+		break;
+	}
+	return true;
+}
+
+void TJunction::patchVirtuals( const TJunctionExtension &extension )
+{
+	switch (extension.orientation)
+	{
+	case E_NORTH: // north
+		patchNorthVirtuals(extension.face, extension.parameter);
+		break;
+	case E_WEST: // west
+		patchWestVirtuals(extension.face, extension.parameter);
+		break;
+	case E_SOUTH: // south
+		patchSouthVirtuals(extension.face, extension.parameter);
+		break;
+	case E_EAST: // east
+		patchEastVirtuals(extension.face, extension.parameter);
+		break;
 	}
 }
 
@@ -142,10 +176,8 @@ void TJunction::cleanUp()
 	_orientation = E_CENTER;
 }
 
-void TJunction::patchNorthVirtuals()
+void TJunction::patchNorthVirtuals( const TFacePtr &face1, Parameter p1 )
 {
-	TFacePtr face1 = _left->getRightFace();
-	Parameter p1 = intersectNorth(face1, _vertex->getS());
 	patchNorthVirtual(_vertex, p1, face1);
 
 	TFacVector face2s;
@@ -161,10 +193,8 @@ void TJunction::patchNorthVirtuals()
 	}
 }
 
-void TJunction::patchWestVirtuals()
+void TJunction::patchWestVirtuals( const TFacePtr &face1, Parameter p1 )
 {
-	TFacePtr face1 = _left->getRightFace();
-	Parameter p1 = intersectWest(face1, _vertex->getT());
 	patchWestVirtual(_vertex, p1, face1);
 
 	TFacVector face2s;
@@ -180,10 +210,8 @@ void TJunction::patchWestVirtuals()
 	}
 }
 
-void TJunction::patchSouthVirtuals()
+void TJunction::patchSouthVirtuals( const TFacePtr &face1, Parameter p1 )
 {
-	TFacePtr face1 = _left->getRightFace();
-	Parameter p1 = intersectSouth(face1, _vertex->getS());
 	patchSouthVirtual(_vertex, p1, face1);
 
 	TFacVector face2s;
@@ -199,10 +227,8 @@ void TJunction::patchSouthVirtuals()
 	}
 }
 
-void TJunction::patchEastVirtuals()
+void TJunction::patchEastVirtuals( const TFacePtr &face1, Parameter p1 )
 {
-	TFacePtr face1 = _left->getRightFace();
-	Parameter p1 = intersectEast(face1, _vertex->getT());
 	patchEastVirtual(_vertex, p1, face1);
 
 	TFacVector face2s;
@@ -263,11 +289,11 @@ VirtualTLinkPtr TJunction::createVirtualLink( const TVertexPtr &vertex, Paramete
 	TVertexPtr next_vertex = TExtractor::extractTVertexFromTFace(face, p);
 	if (!next_vertex)
 	{
-		next_vertex = makePtr<VirtualTVertex>("vv");
+		next_vertex = makeArenaPtr<VirtualTVertex>(_arena, "vv");
 		next_vertex->setST(p.s(), p.t());
 	}
 
-	VirtualTEdgePtr vedge = makePtr<VirtualTEdge>("ve");
+	VirtualTEdgePtr vedge = makeArenaPtr<VirtualTEdge>(_arena, "ve");
 	vedge->setStartVertex(vertex);
 	vedge->setEndVertex(next_vertex);
 
@@ -290,7 +316,7 @@ VirtualTLinkPtr TJunction::createVirtualLink( const TVertexPtr &vertex, Paramete
 	}
 	vedge->setLeftFace(vface_left);	vedge->setRightFace(vface_right);
 
-	VirtualTLinkPtr vlink = makePtr<VirtualTLink>("vl");
+	VirtualTLinkPtr vlink = makeArenaPtr<VirtualTLink>(_arena, "vl");
 	vlink->setOrientedEdge(vedge, true);
 
 	return vlink;
@@ -298,7 +324,7 @@ VirtualTLinkPtr TJunction::createVirtualLink( const TVertexPtr &vertex, Paramete
 
 VirtualTNodeV4Ptr TJunction::createVirtualNodeV4( const TVertexPtr &vertex )
 {
-	VirtualTNodeV4Ptr vnode_v4 = makePtr<VirtualTNodeV4>();
+	VirtualTNodeV4Ptr vnode_v4 = makeArenaPtr<VirtualTNodeV4>(_arena);
 	vnode_v4->setTVertex(vertex);
 	return vnode_v4;
 }
@@ -407,8 +433,8 @@ void TJunction::patchEastVirtual( const TVertexPtr &vertex, Parameter p, const T
 void TJunction::splitTFaceWestEast( const TFacePtr face, Real s, 
 								   VirtualTFacePtr &west, VirtualTFacePtr &east )
 {
-	if (!west) west = makePtr<VirtualTFace>("vf");
-	if (!east) east = makePtr<VirtualTFace>("vf");
+	if (!west) west = makeArenaPtr<VirtualTFace>(_arena, "vf");
+	if (!east) east = makeArenaPtr<VirtualTFace>(_arena, "vf");
 
 	TVertexPtr sw_vertex = TExtractor::extractSouthWestTVertexFromTFace(face);
 	Real wwidth = s - sw_vertex->getS();
@@ -422,8 +448,8 @@ void TJunction::splitTFaceWestEast( const TFacePtr face, Real s,
 void TJunction::splitTFaceNorthSouth( const TFacePtr face, Real t, 
 									 VirtualTFacePtr &north, VirtualTFacePtr &south )
 {
-	if (!north) north = makePtr<VirtualTFace>("vf");
-	if (!south) south = makePtr<VirtualTFace>("vf");
+	if (!north) north = makeArenaPtr<VirtualTFace>(_arena, "vf");
+	if (!south) south = makeArenaPtr<VirtualTFace>(_arena, "vf");
 
 	TVertexPtr sw_vertex = TExtractor::extractSouthWestTVertexFromTFace(face);
 	Real width = face->width();
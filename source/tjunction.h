@@ -52,6 +52,7 @@ Revision_history:
 #include <basis.h>
 #include <tspline.h>
 #include <virtual.h>
+#include <arena.h>
 
 #ifdef use_namespace
 namespace TSPLINE {
@@ -59,6 +60,28 @@ namespace TSPLINE {
 #endif
 
 DECLARE_SMARTPTR(TJunction);
+typedef std::vector<TJunctionPtr> TJncVector;
+
+/**  
+  *  @struct  <TJunctionExtension> 
+  *  @brief  The first extension of a T-junction.
+  *  @note  
+  *  TJunctionExtension records the T-vertex, the face the missing link extends into and the 
+  *  intersected parameter on the opposite side of that face. It is derived without touching the 
+  *  T-spline, so that the extensions of all T-junctions can be derived in parallel before any of 
+  *  them is committed.
+*/
+struct TJunctionExtension
+{
+	TJunctionExtension() : orientation(E_CENTER) {}
+	TVertexPtr vertex;
+	TFacePtr face;
+	Parameter parameter;
+	int orientation;
+};
+
+typedef std::vector<TJunctionExtension> TJncExtVector;
+typedef TJncExtVector::iterator TJncExtVIterator;
 
 /**  
   *  @class  <TJunction> 
@@ -69,7 +92,7 @@ DECLARE_SMARTPTR(TJunction);
 class TJunction
 {
 public:
-	TJunction(const TVertexPtr &vertex);
+	TJunction(const TVertexPtr &vertex, const TArenaPtr &arena = 0);
 	~TJunction();
 
 public:
@@ -79,16 +102,20 @@ public:
 	bool valid();
 	/** Patch the virtual T-objects. */
 	void patchVirtuals();
+	/** Derive the first extension of the T-junction without modifying any T-object. */
+	bool deriveExtension(TJunctionExtension &extension);
+	/** Patch the virtual T-objects from a derived extension. */
+	void patchVirtuals(const TJunctionExtension &extension);
 
 protected:
 	void fill(const TLinkPtr &north, const TLinkPtr &west, 
 		const TLinkPtr &south, const TLinkPtr &east);
 	void cleanUp();
 
-	void patchNorthVirtuals();
-	void patchWestVirtuals();
-	void patchSouthVirtuals();
-	void patchEastVirtuals();
+	void patchNorthVirtuals(const TFacePtr &face1, Parameter p1);
+	void patchWestVirtuals(const TFacePtr &face1, Parameter p1);
+	void patchSouthVirtuals(const TFacePtr &face1, Parameter p1);
+	void patchEastVirtuals(const TFacePtr &face1, Parameter p1);
 
 	Parameter intersectNorth(const TFacePtr &face, Real s);
 	Parameter intersectWest(const TFacePtr &face, Real t);
@@ -113,6 +140,7 @@ private:
 	TLinkPtr _left;
 	TLinkPtr _right;
 	int _orientation;
+	TArenaPtr _arena;
 };
 
 #ifdef use_namespace
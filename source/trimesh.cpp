@@ -96,6 +96,23 @@ void TriMesh::addTriangle( const Triangle &triangle )
 	_triangles.push_back(makePtr<Triangle>(triangle));
 }
 
+void TriMesh::addParameter( const Parameter &p )
+{
+	_parameters.push_back(p);
+}
+
+void TriMesh::setAttribute( const std::string &name, const std::vector<Real> &values )
+{
+	_attributes[name] = values;
+}
+
+const std::vector<Real> & TriMesh::getAttribute( const std::string &name )
+{
+	static const std::vector<Real> empty;
+	std::map<std::string, std::vector<Real> >::const_iterator found = _attributes.find(name);
+	return found == _attributes.end() ? empty : found->second;
+}
+
 void TriMesh::faceBegin(const std::string &name /*= ""*/)
 {
 	_faces.push_back(makePtr<TriFace>());
@@ -184,7 +201,7 @@ void TriMesh::polygonEnd()
 {
 	if (_polygon_buffer.size() < 3)
 	{
-		for (int i=0;i<_polygon_buffer.size();i++)
+		for (int i=0;i<(int)_polygon_buffer.size();i++)
 		{
 			P3dVIterator iter = pointIteratorBegin() + _polygon_buffer[i];
 			_points.erase(iter);
@@ -204,6 +221,26 @@ void TriMesh::merge(const TriMeshPtr &mesh)
 	{
 		this->addPointNormal(*(*pit).get(), *(*nit).get());
 	}
+	// The parameters are only kept while every point has one, the attributes missing on either side are 0.
+	if (_parameters.size() == (size_t)offset && mesh->_parameters.size() == mesh->_points.size())
+	{
+		_parameters.insert(_parameters.end(), mesh->_parameters.begin(), mesh->_parameters.end());
+	}
+	else
+	{
+		_parameters.clear();
+	}
+	std::map<std::string, std::vector<Real> >::iterator ait;
+	for (ait = mesh->_attributes.begin(); ait != mesh->_attributes.end(); ait++)
+	{
+		std::vector<Real> &values = _attributes[ait->first];
+		values.resize(offset, 0.0);
+		values.insert(values.end(), ait->second.begin(), ait->second.end());
+	}
+	for (ait = _attributes.begin(); ait != _attributes.end(); ait++)
+	{
+		ait->second.resize(_points.size(), 0.0);
+	}
 
 	TriVIterator tit = mesh->triangleIteratorBegin();
 	for (;tit!=mesh->triangleIteratorEnd();tit++)
@@ -129,6 +129,10 @@ public:
 	void addPointNormal(const Point3D& p, const Vector3D& n);
 	/** Add a triangle of type Triangle. */
 	void addTriangle(const Triangle &triangle);
+	/** Add the parameter of the last point on the surface it is tessellated from. */
+	void addParameter(const Parameter &p);
+	/** Set a named vertex attribute, one value per point. */
+	void setAttribute(const std::string &name, const std::vector<Real> &values);
 
 	/** Start a new face (contains several triangles). */
 	void faceBegin(const std::string &name = "");
@@ -148,7 +152,7 @@ public:
 	/** End a polygon. */
 	void polygonEnd();
 
-	/** Merge another TriMesh. */
+	/** Merge another TriMesh, the parameters are dropped unless every point of both has one. */
 	void merge(const TriMeshPtr &mesh);
 
 	/** Return the number of points. */
@@ -159,6 +163,14 @@ public:
 	long sizeTriangles() {return _triangles.size();}
 	/** Return the number of faces. */
 	long sizeFaces() {return _faces.size();}
+	/** Return the number of parameters, the same as the number of points if every point has one. */
+	long sizeParameters() {return _parameters.size();}
+	/** Return the ith parameter. */
+	const Parameter &parameterAt(unsigned int i) {return _parameters[i];}
+	/** Check if the named vertex attribute is set. */
+	bool hasAttribute(const std::string &name) {return _attributes.find(name) != _attributes.end();}
+	/** Return the named vertex attribute, empty if it is not set. */
+	const std::vector<Real> &getAttribute(const std::string &name);
 	/** Return the begin iterator of points. */
 	P3dVIterator pointIteratorBegin() {return _points.begin();}
 	/** Return the end iterator of points. */
@@ -190,6 +202,8 @@ private:
 	N3dVector _normals;
 	TriVector _triangles;
 	TriFacVector _faces;
+	std::vector<Parameter> _parameters;
+	std::map<std::string, std::vector<Real> > _attributes;
 
 	std::vector<long> _odd_row_buffer;
 	std::vector<long> _even_row_buffer;
@@ -102,6 +102,8 @@ int main(int argc, char **argv)
 
    RhBuilderPtr reader = makePtr<RhBuilder>(filename);
    TSplinePtr spline = reader->findTSpline();
+   if (int conflicts = reader->getTJunctionConflicts())
+      cout << "T-junctions: " << conflicts << " pairs of extensions split the same face along different lines." << endl;
 
    if(option == "-img")
    {
@@ -97,6 +97,8 @@ int main(int argc, char **argv)
 
 	RhBuilderPtr reader = makePtr<RhBuilder>(filename);
 	TSplinePtr spline = reader->findTSpline();
+	if (int conflicts = reader->getTJunctionConflicts())
+		cout << "T-junctions: " << conflicts << " pairs of extensions split the same face along different lines." << endl;
 
 	TTessellator tessellator(spline);
 	tessellator.setResolution(0.1);
@@ -0,0 +1,332 @@
+/*
+TSPLINE -- A T-spline object oriented package in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 2.1 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building,
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+	- Created.
+-------------------------------------------------------------------------------
+*/
+
+/*!
+  @file tsm2mesh.cpp
+  @brief Convert a batch of tsm files to several mesh and T-spline file formats.
+*/
+
+
+#include <tspline.h>
+#include <factory.h>
+#include <tessellator.h>
+#include <writer.h>
+#include <rhbuilder.h>
+#include <finder.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#ifdef USE_OMP
+#include <omp.h>
+#endif
+#ifdef _WIN32
+#include <direct.h>
+#include <io.h>
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#endif
+
+#ifdef use_namespace
+using namespace TSPLINE;
+#endif
+
+/** The output formats requested on the command line. */
+struct MeshFormats
+{
+	MeshFormats() : obj(false), stl_ascii(false), stl_binary(false), gpl(false), dxf(false), stp(false) {}
+	bool tessellated() const { return obj || stl_ascii || stl_binary || gpl; }
+	bool any() const { return tessellated() || dxf || stp; }
+	bool obj;
+	bool stl_ascii;
+	bool stl_binary;
+	bool gpl;
+	bool dxf;
+	bool stp;
+};
+
+static std::mutex log_mutex;
+
+static void makeDirectory(const std::string &dirname)
+{
+#ifdef _WIN32
+	_mkdir(dirname.c_str());
+#else
+	mkdir(dirname.c_str(), S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
+#endif
+}
+
+static bool endsWithTsm(const std::string &name)
+{
+	return name.size() > 4 && name.compare(name.size() - 4, 4, ".tsm") == 0;
+}
+
+/** Append the path, or the tsm files in it if it is a directory. */
+static void collectFiles(const std::string &path, std::vector<std::string> &files)
+{
+#ifdef _WIN32
+	struct _finddata_t data;
+	intptr_t handle = _findfirst((path + "\\*.tsm").c_str(), &data);
+	if (handle == -1)
+	{
+		files.push_back(path);
+		return;
+	}
+	std::vector<std::string> found;
+	do
+	{
+		found.push_back(path + "\\" + data.name);
+	} while (_findnext(handle, &data) == 0);
+	_findclose(handle);
+#else
+	DIR *dir = opendir(path.c_str());
+	if (!dir)
+	{
+		files.push_back(path);
+		return;
+	}
+	std::vector<std::string> found;
+	struct dirent *entry;
+	while ((entry = readdir(dir)) != 0)
+	{
+		std::string name(entry->d_name);
+		if (endsWithTsm(name)) found.push_back(path + "/" + name);
+	}
+	closedir(dir);
+#endif
+	std::sort(found.begin(), found.end());
+	files.insert(files.end(), found.begin(), found.end());
+}
+
+static std::string splineName(const std::string &filename)
+{
+	int pos = filename.find_last_of("/\\");
+	std::string splinename(filename.substr(pos+1));
+	int i = splinename.find('.');
+	return splinename.substr(0,i);
+}
+
+/** 
+  * Return the output names of the files, the spline names unless two files of the same name 
+  * come from different directories, which keep their paths in the names instead.
+*/
+static void outputNames(const std::vector<std::string> &files, std::vector<std::string> &names)
+{
+	std::map<std::string, int> counts;
+	names.resize(files.size());
+	for (size_t i=0;i<files.size();i++)
+	{
+		names[i] = splineName(files[i]);
+		counts[names[i]]++;
+	}
+	for (size_t i=0;i<files.size();i++)
+	{
+		if (counts[names[i]] == 1) continue;
+		std::string path = files[i];
+		size_t dot = path.find_last_of('.'), separator = path.find_last_of("/\\");
+		if (dot != std::string::npos && (separator == std::string::npos || dot > separator)) path.erase(dot);
+		size_t first = path.find_first_not_of("./\\");
+		if (first != std::string::npos) path = path.substr(first);
+		std::replace(path.begin(), path.end(), '/', '_');
+		std::replace(path.begin(), path.end(), '\\', '_');
+		std::replace(path.begin(), path.end(), ':', '_');
+		names[i] = path;
+	}
+}
+
+/** Build, tessellate once and write all the requested formats of a tsm file. */
+static void convertFile(const std::string &filename, const std::string &splinename, const std::string &exportdir, const MeshFormats &formats)
+{
+	std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+	std::string dirname = exportdir + "/" + splinename;
+	makeDirectory(dirname);
+	std::string basename = dirname + "/" + splinename;
+
+	RhBuilderPtr reader = makePtr<RhBuilder>(filename);
+	TSplinePtr spline = reader->findTSpline();
+
+	TFacVector faces;
+	TriMshVector trimeshes;
+	TriMeshPtr trimesh;
+	if (formats.tessellated())
+	{
+		TTessellator tessellator(spline);
+		tessellator.setResolution(0.1);
+		TFinderPtr finder = makePtr<TFinder>(reader->findTGroup());
+		finder->findObjects<TFace>(faces);
+		tessellator.interpolateFaces(faces, trimeshes);
+	}
+	if (formats.stl_ascii || formats.gpl)
+	{
+		trimesh = makePtr<TriMesh>(spline->getName());
+		for (TriMshVIterator iter = trimeshes.begin(); iter != trimeshes.end(); iter++)
+		{
+			trimesh->merge(*iter);
+		}
+	}
+
+	if (formats.obj)
+	{
+		ObjWriter objwriter(basename, 0);
+		for (TriMshVIterator iter = trimeshes.begin(); iter != trimeshes.end(); iter++)
+		{
+			objwriter.addMesh(*iter);
+		}
+		objwriter.writeObj();
+	}
+	if (formats.stl_ascii)
+	{
+		StlWriter stlwriter(basename, trimesh);
+		stlwriter.writeStlAcii();
+	}
+	if (formats.stl_binary)
+	{
+		for (size_t i=0;i<faces.size();i++)
+		{
+			StlWriter stlwriter(basename + "-" + faces[i]->getName(), trimeshes[i]);
+			stlwriter.writeStlBinary();
+		}
+	}
+	if (formats.gpl)
+	{
+		GnuplotWriter gplwriter(basename, trimesh, spline);
+		gplwriter.writeGnuplMesh();
+		gplwriter.writeGnuplTImage();
+		gplwriter.writeGnuplTConnect();
+		gplwriter.writeGnuplTPointset();
+	}
+	if (formats.dxf)
+	{
+		DxfWriter dxfwriter(basename, spline);
+		dxfwriter.writeDxfTImage();
+		dxfwriter.writeDxfTConnect();
+		dxfwriter.writeDxfTPointset();
+	}
+	if (formats.stp)
+	{
+		StepWriter stepwriter(basename, reader->findTGroup());
+		stepwriter.writeStep();
+	}
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+	std::lock_guard<std::mutex> lock(log_mutex);
+	cout << filename << ": " << faces.size() << " faces converted into " << dirname
+		<< " (" << seconds << " s)" << endl;
+	if (int conflicts = reader->getTJunctionConflicts())
+		cout << filename << ": " << conflicts << " pairs of T-junction extensions split the same face along different lines." << endl;
+}
+
+int main(int argc, char **argv)
+{
+	cout << "=====================================================\n";
+	cout << " TSPLINE -- A T-spline object oriented package in C++ \n";
+	cout << " Usage: tsm2mesh.exe [-obj] [-stl] [-bin] [-gpl] [-dxf] [-stp]\n";
+	cout << "                     [-j workers] [-o dir] [*.tsm/dir ...]\n";
+	cout << "=====================================================\n";
+	cout << "\n";
+
+	MeshFormats formats;
+	std::vector<std::string> files;
+	std::string exportdir = "./export";
+	int nthreads = std::thread::hardware_concurrency();
+	if (nthreads < 1) nthreads = 1;
+	int nworkers = 0;
+	for (int i=1;i<argc;i++)
+	{
+		std::string option(argv[i]);
+		if (option == "-obj") formats.obj = true;
+		else if (option == "-stl") formats.stl_ascii = true;
+		else if (option == "-bin") formats.stl_binary = true;
+		else if (option == "-gpl") formats.gpl = true;
+		else if (option == "-dxf") formats.dxf = true;
+		else if (option == "-stp") formats.stp = true;
+		else if (option == "-j" && i+1 < argc) nworkers = atoi(argv[++i]);
+		else if (option == "-o" && i+1 < argc) exportdir = argv[++i];
+		else if (!option.empty() && option[0] == '-')
+		{
+			cout << "Do not support the option " << option << "." << endl;
+			return 0;
+		}
+		else collectFiles(option, files);
+	}
+	if (files.empty())
+	{
+		cout << "Please read the usage." << endl;
+		return 0;
+	}
+	if (!formats.any()) formats.obj = true;
+	int nfiles = files.size();
+	std::vector<std::string> names;
+	outputNames(files, names);
+
+	// The workers take the files one by one, the rest of the threads tessellate the T-faces of each file.
+	if (nworkers < 1) nworkers = nthreads;
+	if (nworkers > nfiles) nworkers = nfiles;
+	int threads_per_file = nthreads / nworkers;
+	if (threads_per_file < 1) threads_per_file = 1;
+
+	makeDirectory(exportdir);
+	std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+	std::atomic<int> next(0);
+	std::vector<std::thread> workers;
+	for (int w=0;w<nworkers;w++)
+	{
+		workers.push_back(std::thread([&]()
+		{
+#ifdef USE_OMP
+			omp_set_num_threads(threads_per_file);
+#endif
+			for (int i = next++; i < nfiles; i = next++)
+			{
+				convertFile(files[i], names[i], exportdir, formats);
+			}
+		}));
+	}
+	for (int w=0;w<nworkers;w++)
+	{
+		workers[w].join();
+	}
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+	cout << nfiles << " files converted by " << nworkers << " workers in " << seconds << " s";
+	if (seconds > 0) cout << " (" << nfiles * 60.0 / seconds << " files per minute)";
+	cout << endl;
+
+	return(0);
+}
@@ -103,10 +103,11 @@ int main(int argc, char **argv)
 
    RhBuilderPtr reader = makePtr<RhBuilder>(filename);
    TSplinePtr spline = reader->findTSpline();
+   if (int conflicts = reader->getTJunctionConflicts())
+      cout << "T-junctions: " << conflicts << " pairs of extensions split the same face along different lines." << endl;
    
    TTessellator tessellator(spline);
    tessellator.setResolution(0.1);
-   TriMeshPtr trimesh = tessellator.interpolateAll();
    
    std::vector<std::string> faces;
    reader->findTFaceNames(faces);
@@ -115,6 +116,7 @@ int main(int argc, char **argv)
 
    if(option == "-asc")
    {
+	   TriMeshPtr trimesh = tessellator.interpolateAll();
 	   StlWriter stlwriter(dirname + "/" + splinename, trimesh);
 	   stlwriter.writeStlAcii();
 	   cout << "STL file: " << stlwriter.fileName() << " is written!" <<  endl;
@@ -98,6 +98,8 @@ int main(int argc, char **argv)
 
    RhBuilderPtr reader = makePtr<RhBuilder>(filename);
    TSplinePtr spline = reader->findTSpline();
+   if (int conflicts = reader->getTJunctionConflicts())
+      cout << "T-junctions: " << conflicts << " pairs of extensions split the same face along different lines." << endl;
    
    StepWriter stepwriter(dirname + "/" + splinename, reader->findTGroup());
    stepwriter.writeStep();
@@ -0,0 +1,876 @@
+/*
+TSPLINE -- A T-spline object oriented package in C++
+Copyright (C) 2015-  Wenlei Xiao
+
+This library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation; either version 2.1 of the
+License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+Report problems and direct all questions to:
+
+Wenlei Xiao, Ph.D
+School of Mechanical Engineering and Automation
+Beijing University of Aeronautics and Astronautics
+D-315, New Main Building,
+Beijing, P.R. China, 100191
+
+email: xiaowenlei@buaa.edu.cn
+-------------------------------------------------------------------------------
+Revision_history:
+
+2026/10/19: agent
+	- Created.
+-------------------------------------------------------------------------------
+*/
+
+/*!
+  @file tsmbench.cpp
+  @brief Benchmark the queries on the T-splines of tsm files.
+*/
+
+
+#include <tspline.h>
+#include <rhbuilder.h>
+#include <derivator.h>
+#include <projector.h>
+#include <raycaster.h>
+#include <slicer.h>
+#include <intersector.h>
+#include <editor.h>
+#include <quadrature.h>
+#include <integrator.h>
+#include <fitter.h>
+#include <chrono>
+#include <random>
+#include <clocale>
+#ifdef USE_OMP
+#include <omp.h>
+#endif
+
+#ifdef use_namespace
+using namespace TSPLINE;
+#endif
+
+static double secondsSince(const std::chrono::steady_clock::time_point &start)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/** Project a random cloud around the T-spline, half uniform in its box and half scattered near its surface. */
+static void benchProjection(const TSplinePtr &spline, int npoints, unsigned int seed)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	TProjector projector(spline);
+	double build_time = secondsSince(start);
+
+	BoundingBox box = projector.getHierarchy().getBox();
+	Real diagonal = (box.maximum() - box.minimum()).norm2();
+	box.enlarge(0.1 * diagonal);
+
+	TImagePtr image = spline->getTImage();
+	TFacVector faces(image->faceIteratorBegin(), image->faceIteratorEnd());
+	std::vector<BlendingEquationPtr> equations(faces.size());
+	std::mt19937 random(seed);
+	std::uniform_real_distribution<Real> unit(0.0, 1.0);
+	std::vector<Point3D> points;
+	std::vector<Real> offsets;		// the distance of a scattered point to its surface point, -1 for a uniform point
+	for (int i=0;i<npoints;i++)
+	{
+		if (i % 2 == 0)
+		{
+			points.push_back(Point3D(box.minimum(0) + unit(random)*(box.maximum(0)-box.minimum(0)),
+				box.minimum(1) + unit(random)*(box.maximum(1)-box.minimum(1)),
+				box.minimum(2) + unit(random)*(box.maximum(2)-box.minimum(2))));
+			offsets.push_back(-1.0);
+			continue;
+		}
+		int index = random() % faces.size();
+		Parameter northwest = faces[index]->northWest(), southeast = faces[index]->southEast();
+		Parameter parameter(northwest.s() + unit(random)*(southeast.s()-northwest.s()), 
+			southeast.t() + unit(random)*(northwest.t()-southeast.t()));
+		if (!equations[index])
+			equations[index] = TDerivator::prepareEquationByTFace(faces[index], spline->getSDegree(), spline->getTDegree());
+		Point3D point; Vector3D normal;
+		equations[index]->computePointAndNormal(parameter, point, normal);
+		Real offset = (unit(random) - 0.5) * 0.02 * diagonal;
+		points.push_back(point + Point3D(normal.i(), normal.j(), normal.k()) * offset);
+		offsets.push_back(fabs(offset));
+	}
+
+	std::vector<TProjection> projections;
+	int nthreads = 1;
+#ifdef USE_OMP
+	nthreads = omp_get_max_threads();
+	omp_set_num_threads(1);
+#endif
+	start = std::chrono::steady_clock::now();
+	projector.project(points, projections);
+	double single_time = secondsSince(start);
+#ifdef USE_OMP
+	omp_set_num_threads(nthreads);
+#endif
+	start = std::chrono::steady_clock::now();
+	int count = projector.project(points, projections);
+	double multi_time = secondsSince(start);
+
+	// A scattered point can not be farther from the surface than from the point it was scattered from.
+	int misses = 0;
+	for (int i=0;i<npoints;i++)
+	{
+		if (offsets[i] >= 0.0 && projections[i].distance > offsets[i] + 1e-6 * diagonal) misses++;
+	}
+	cout << "  projection: " << projector.sizeFaces() << " faces built in " << build_time << " s, " 
+		<< count << "/" << npoints << " points projected" << endl;
+	cout << "    1 thread: " << npoints / single_time << " points/s, " << nthreads << " threads: " 
+		<< npoints / multi_time << " points/s, " << misses << " scattered points missed" << endl;
+}
+
+/** Cast the rays of a pinhole camera looking at the T-spline, and rays aimed at random points on its surface. */
+static void benchRayCasting(const TSplinePtr &spline, int nrays, unsigned int seed)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	TRayCaster caster(spline);
+	double build_time = secondsSince(start);
+
+	BoundingBox box = caster.getHierarchy().getBox();
+	Real diagonal = (box.maximum() - box.minimum()).norm2();
+	Point3D center = box.center();
+
+	// The camera is a square grid of coherent rays from a point at two diagonals, covering the box.
+	int width = (int)sqrt((Real)nrays);
+	if (width < 1) width = 1;
+	std::vector<TRay> rays;
+	Point3D eye = center + Point3D(1.0, 0.8, 0.6) * (2.0 * diagonal / sqrt(2.0));
+	Vector3D forward(center - eye); forward.normalize();
+	Vector3D right = forward * Vector3D(0.0, 0.0, 1.0); right.normalize();
+	Vector3D up = right * forward;
+	for (int i=0;i<width;i++)
+	{
+		for (int j=0;j<width;j++)
+		{
+			Real x = (j + 0.5) / width - 0.5, y = (i + 0.5) / width - 0.5;
+			rays.push_back(TRay(eye, forward + right * (0.6 * x) + up * (0.6 * y)));
+		}
+	}
+	int ncamera = (int)rays.size();
+
+	// A ray aimed at a point on the surface must hit the surface before or at the point, at t <= 1.
+	TImagePtr image = spline->getTImage();
+	TFacVector faces(image->faceIteratorBegin(), image->faceIteratorEnd());
+	std::vector<BlendingEquationPtr> equations(faces.size());
+	std::mt19937 random(seed);
+	std::uniform_real_distribution<Real> unit(0.0, 1.0);
+	for (int i=ncamera;i<2*ncamera;i++)
+	{
+		int index = random() % faces.size();
+		Parameter northwest = faces[index]->northWest(), southeast = faces[index]->southEast();
+		Parameter parameter(northwest.s() + unit(random)*(southeast.s()-northwest.s()), 
+			southeast.t() + unit(random)*(northwest.t()-southeast.t()));
+		if (!equations[index])
+			equations[index] = TDerivator::prepareEquationByTFace(faces[index], spline->getSDegree(), spline->getTDegree());
+		Point3D target = equations[index]->computePoint(parameter);
+		Real z = 2.0 * unit(random) - 1.0, phi = 2.0 * M_PI * unit(random);
+		Point3D origin = center + Point3D(sqrt(1.0 - z*z) * cos(phi), sqrt(1.0 - z*z) * sin(phi), z) * diagonal;
+		rays.push_back(TRay(origin, Vector3D(target - origin)));
+	}
+
+	std::vector<TRayHit> hits(ncamera);
+	int nthreads = 1;
+#ifdef USE_OMP
+	nthreads = omp_get_max_threads();
+#endif
+	start = std::chrono::steady_clock::now();
+	for (int i=0;i<ncamera;i++)
+	{
+		caster.intersect(rays[i], hits[i]);
+	}
+	double single_time = secondsSince(start);
+	start = std::chrono::steady_clock::now();
+	caster.intersect(rays, hits);
+	double multi_time = secondsSince(start);
+
+	int count = 0, misses = 0;
+	for (int i=0;i<ncamera;i++)
+	{
+		if (hits[i].distance >= 0.0) count++;
+	}
+	for (int i=ncamera;i<2*ncamera;i++)
+	{
+		if (hits[i].distance < 0.0 || hits[i].distance > 1.0 + 1e-6) misses++;
+	}
+	cout << "  ray casting: " << caster.sizeFaces() << " faces built in " << build_time << " s, " 
+		<< count << "/" << ncamera << " camera rays hit" << endl;
+	cout << "    1 thread: " << ncamera / single_time << " camera rays/s, " << nthreads << " threads: " 
+		<< 2 * ncamera / multi_time << " rays/s, " << misses << " aimed rays missed" << endl;
+}
+
+/** Slice the T-spline by planes evenly spaced over the height of its control points. */
+static void benchSlicing(const TSplinePtr &spline, int nlayers)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	TSlicer slicer(spline);
+	double build_time = secondsSince(start);
+
+	BoundingBox box = slicer.getBox();
+	std::vector<Real> heights(nlayers);
+	for (int i=0;i<nlayers;i++)
+	{
+		heights[i] = box.minimum().z() + (box.maximum().z() - box.minimum().z()) * (i + 0.5) / nlayers;
+	}
+
+	std::vector<std::vector<TContour> > slices;
+	int nthreads = 1;
+#ifdef USE_OMP
+	nthreads = omp_get_max_threads();
+	omp_set_num_threads(1);
+#endif
+	start = std::chrono::steady_clock::now();
+	slicer.slice(heights, slices);
+	double single_time = secondsSince(start);
+#ifdef USE_OMP
+	omp_set_num_threads(nthreads);
+#endif
+	start = std::chrono::steady_clock::now();
+	int count = slicer.slice(heights, slices);
+	double multi_time = secondsSince(start);
+
+	int open = 0, npoints = 0;
+	for (int i=0;i<nlayers;i++)
+	{
+		for (int j=0;j<(int)slices[i].size();j++)
+		{
+			if (!slices[i][j].closed) open++;
+			npoints += (int)slices[i][j].points.size();
+		}
+	}
+	cout << "  slicing: " << slicer.sizeFaces() << " faces built in " << build_time << " s, " 
+		<< count << " contours (" << open << " open) of " << npoints << " points" << endl;
+	cout << "    1 thread: " << nlayers / single_time << " layers/s, " << nthreads << " threads: " 
+		<< nlayers / multi_time << " layers/s" << endl;
+}
+
+/** Intersect the T-spline of a tsm file with a copy of it, turned about the vertical axis through its center and lifted a little. */
+static void benchIntersection(const std::string &filename, const TSplinePtr &spline, Real degrees)
+{
+	RhBuilderPtr reader = makePtr<RhBuilder>(filename);
+	TSplinePtr copy = reader->findTSpline();
+	BoundingBox box = TFaceHierarchy(spline).getBox();
+	Point3D center = box.center();
+	Real diagonal = (box.maximum() - box.minimum()).norm2();
+	Real angle = degrees * M_PI / 180.0;
+	TSplineEditor editor(copy);
+	TPointsetPtr pointset = copy->getTPointset();
+	for (TObjVIterator iter = pointset->iteratorBegin(); iter != pointset->iteratorEnd(); iter++)
+	{
+		TPointPtr point = (*iter)->asTPoint();
+		Real x = point->getX() - center.x(), y = point->getY() - center.y();
+		editor.movePointTo(point, center.x() + cos(angle)*x - sin(angle)*y, center.y() + sin(angle)*x + cos(angle)*y, 
+			point->getZ() + 0.01 * diagonal);
+	}
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	TIntersector intersector(spline, copy);
+	double build_time = secondsSince(start);
+
+	std::vector<TIntersectionCurve> curves;
+	int nthreads = 1;
+#ifdef USE_OMP
+	nthreads = omp_get_max_threads();
+	omp_set_num_threads(1);
+#endif
+	start = std::chrono::steady_clock::now();
+	intersector.intersect(curves);
+	double single_time = secondsSince(start);
+#ifdef USE_OMP
+	omp_set_num_threads(nthreads);
+#endif
+	start = std::chrono::steady_clock::now();
+	int count = intersector.intersect(curves);
+	double multi_time = secondsSince(start);
+
+	int closed = 0, npoints = 0;
+	for (int i=0;i<(int)curves.size();i++)
+	{
+		if (curves[i].closed) closed++;
+		npoints += (int)curves[i].points.size();
+	}
+	cout << "  intersection: " << intersector.sizePairs() << " pairs of faces built in " << build_time << " s, " 
+		<< count << " curves (" << closed << " closed) of " << npoints << " points" << endl;
+	cout << "    1 thread: " << single_time << " s, " << nthreads << " threads: " << multi_time << " s" << endl;
+}
+
+/** Assemble the mass matrix of the basis functions on the surface from the basis at the Gauss points. */
+static void benchAssembly(const TSplinePtr &spline, int order)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	TQuadratureBasis basis(spline, order);
+	double build_time = secondsSince(start);
+
+	std::vector<TQuadratureCell> cells;
+	int nthreads = 1;
+#ifdef USE_OMP
+	nthreads = omp_get_max_threads();
+	omp_set_num_threads(1);
+#endif
+	start = std::chrono::steady_clock::now();
+	basis.evaluate(cells);
+	double single_time = secondsSince(start);
+#ifdef USE_OMP
+	omp_set_num_threads(nthreads);
+#endif
+	start = std::chrono::steady_clock::now();
+	int count = basis.evaluate(cells);
+	double multi_time = secondsSince(start);
+
+	// The area element |Su x Sv| from the derivatives of the basis, the element matrices scattered into sorted triplets.
+	start = std::chrono::steady_clock::now();
+	std::vector<std::pair<std::pair<int, int>, Real> > triplets;
+	int npoints = 0;
+	for (int c=0;c<count;c++)
+	{
+		const TQuadratureCell &cell = cells[c];
+		int n = (int)cell.indices.size();
+		std::vector<Real> element(n*n, 0.0);
+		for (int p=0;p<(int)cell.parameters.size();p++)
+		{
+			const Real *values = &cell.values[3*n*p];
+			Vector3D du(0.0, 0.0, 0.0), dv(0.0, 0.0, 0.0);
+			for (int k=0;k<n;k++)
+			{
+				TPointPtr point = basis.getPoint(cell.indices[k]);
+				Vector3D x(point->getX(), point->getY(), point->getZ());
+				du += x * values[3*k+1];
+				dv += x * values[3*k+2];
+			}
+			Real area = (du * dv).norm() * cell.weights[p];
+			for (int i=0;i<n;i++)
+			{
+				for (int j=0;j<n;j++) element[i*n+j] += values[3*i] * values[3*j] * area;
+			}
+		}
+		npoints += (int)cell.parameters.size();
+		for (int i=0;i<n;i++)
+		{
+			for (int j=0;j<n;j++) triplets.push_back(std::make_pair(std::make_pair(cell.indices[i], cell.indices[j]), element[i*n+j]));
+		}
+	}
+	std::sort(triplets.begin(), triplets.end());
+	int nonzeros = 0;
+	Real total = 0.0;
+	for (int i=0;i<(int)triplets.size();i++)
+	{
+		if (i == 0 || triplets[i].first != triplets[i-1].first) nonzeros++;
+		total += triplets[i].second;
+	}
+	double assembly_time = secondsSince(start);
+
+	cout << "  assembly: " << count << " cells of " << basis.sizeFunctions() << " functions built in " << build_time << " s, "
+		<< nonzeros << " nonzeros, area " << total << endl;
+	cout << "    basis 1 thread: " << npoints / single_time << " points/s, " << nthreads << " threads: " 
+		<< npoints / multi_time << " points/s, mass matrix: " << count / assembly_time << " cells/s" << endl;
+}
+
+/** Integrate the mass properties with one thread and with all of them, which must give the same bits. */
+static void benchMass(const TSplinePtr &spline, int order)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	TMassIntegrator integrator(spline, order);
+	double build_time = secondsSince(start);
+
+	TMassProperties single, multi;
+	int nthreads = 1;
+#ifdef USE_OMP
+	nthreads = omp_get_max_threads();
+	omp_set_num_threads(1);
+#endif
+	start = std::chrono::steady_clock::now();
+	integrator.integrate(single);
+	double single_time = secondsSince(start);
+#ifdef USE_OMP
+	omp_set_num_threads(nthreads);
+#endif
+	start = std::chrono::steady_clock::now();
+	integrator.integrate(multi);
+	double multi_time = secondsSince(start);
+
+	bool same = single.area == multi.area && single.volume == multi.volume && std::equal(single.inertia, single.inertia+6, multi.inertia);
+	cout << "  mass: " << integrator.sizeFaces() << " faces built in " << build_time << " s, " << multi.cells << " cells, area " 
+		<< multi.area << " (+-" << multi.area_error << "), volume " << multi.volume << " (+-" << multi.volume_error << ")" << endl;
+	cout << "    1 thread: " << single_time << " s, " << nthreads << " threads: " << multi_time << " s, " 
+		<< (same ? "the same" : "different") << " results" << endl;
+}
+
+/** Sample the surface of the T-spline at random parameters, return the diagonal of the box of the samples. */
+static Real sampleSurface(const TSplinePtr &spline, int nsamples, std::mt19937 &random, 
+	std::vector<Point3D> &points, std::vector<int> &indices, std::vector<Parameter> &parameters)
+{
+	TImagePtr image = spline->getTImage();
+	TFacVector faces(image->faceIteratorBegin(), image->faceIteratorEnd());
+	std::vector<BlendingEquationPtr> equations(faces.size());
+	std::uniform_real_distribution<Real> unit(0.0, 1.0);
+	BoundingBox box;
+	for (int i=0;i<nsamples;i++)
+	{
+		int index = random() % faces.size();
+		Parameter northwest = faces[index]->northWest(), southeast = faces[index]->southEast();
+		Parameter parameter(northwest.s() + unit(random)*(southeast.s()-northwest.s()), 
+			southeast.t() + unit(random)*(northwest.t()-southeast.t()));
+		if (!equations[index])
+			equations[index] = TDerivator::prepareEquationByTFace(faces[index], spline->getSDegree(), spline->getTDegree());
+		points.push_back(equations[index]->computePoint(parameter));
+		indices.push_back(index);
+		parameters.push_back(parameter);
+		box.extend(points.back());
+	}
+	return (box.maximum() - box.minimum()).norm2();
+}
+
+/** Move every T-point of the T-spline by a random vector of up to half the amount along each axis. */
+static void perturbPoints(const TSplinePtr &spline, TSplineEditor &editor, Real amount, std::mt19937 &random)
+{
+	std::uniform_real_distribution<Real> unit(0.0, 1.0);
+	TPointsetPtr pointset = spline->getTPointset();
+	for (TObjVIterator iter = pointset->iteratorBegin(); iter != pointset->iteratorEnd(); iter++)
+	{
+		TPointPtr point = castPtr<TPoint>(*iter);
+		if (point) editor.movePointBy(point, (unit(random) - 0.5) * amount, (unit(random) - 0.5) * amount, (unit(random) - 0.5) * amount);
+	}
+}
+
+/** Fit a perturbed copy of the T-spline to samples of its surface, at their parameters and then by projection. */
+static void benchFitting(const std::string &filename, const TSplinePtr &spline, int nsamples, unsigned int seed)
+{
+	std::mt19937 random(seed);
+	std::vector<Point3D> points;
+	std::vector<int> indices;
+	std::vector<Parameter> parameters;
+	Real diagonal = sampleSurface(spline, nsamples, random, points, indices, parameters);
+
+	// The copy is read again, its T-faces are in the same order as those of the original.
+	RhBuilderPtr reader = makePtr<RhBuilder>(filename);
+	TSplinePtr copy = reader->findTSpline();
+	TFacVector copy_faces(copy->getTImage()->faceIteratorBegin(), copy->getTImage()->faceIteratorEnd());
+	TFacVector sample_faces(nsamples);
+	for (int i=0;i<nsamples;i++) sample_faces[i] = copy_faces[indices[i]];
+	TSplineEditor editor(copy);
+	perturbPoints(copy, editor, 0.01 * diagonal, random);
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	TFitter fitter(copy);
+	double build_time = secondsSince(start);
+	start = std::chrono::steady_clock::now();
+	int count = fitter.fit(points, sample_faces, parameters, editor);
+	double fit_time = secondsSince(start);
+	cout << "  fitting: " << fitter.sizePoints() << " points, " << fitter.sizeNonzeros() << " nonzeros built in " << build_time 
+		<< " s, " << count << "/" << nsamples << " samples" << endl;
+	cout << "    parameters: " << count / fit_time << " samples/s, " << fitter.getIterations() << " iterations, rms " 
+		<< fitter.getResidualBefore() << " -> " << fitter.getResidual() << endl;
+
+	start = std::chrono::steady_clock::now();
+	count = fitter.fit(points, editor);
+	fit_time = secondsSince(start);
+	cout << "    projection: " << count / fit_time << " samples/s, " << fitter.getIterations() << " iterations, rms " 
+		<< fitter.getResidualBefore() << " -> " << fitter.getResidual() << endl;
+}
+
+/** Check the projections of random points against the closest of a dense grid of surface points on every T-face. */
+static bool checkProjection(const TSplinePtr &spline, int npoints, unsigned int seed)
+{
+	TProjector projector(spline);
+	BoundingBox box = projector.getHierarchy().getBox();
+	Real diagonal = (box.maximum() - box.minimum()).norm2();
+	box.enlarge(0.1 * diagonal);
+
+	const int GRID = 40;
+	std::vector<Point3D> samples;
+	TImagePtr image = spline->getTImage();
+	for (TFacVIterator iter = image->faceIteratorBegin(); iter != image->faceIteratorEnd(); iter++)
+	{
+		if ((*iter)->sizeBlendingNodes() == 0) continue;
+		BlendingEquationPtr equation = TDerivator::prepareEquationByTFace(*iter, spline->getSDegree(), spline->getTDegree());
+		Parameter northwest = (*iter)->northWest(), southeast = (*iter)->southEast();
+		for (int i=0;i<=GRID;i++)
+		{
+			for (int j=0;j<=GRID;j++)
+			{
+				Parameter parameter(northwest.s() + (southeast.s()-northwest.s()) * i / GRID, 
+					southeast.t() + (northwest.t()-southeast.t()) * j / GRID);
+				samples.push_back(equation->computePoint(parameter));
+			}
+		}
+	}
+
+	std::mt19937 random(seed);
+	std::uniform_real_distribution<Real> unit(0.0, 1.0);
+	std::vector<Point3D> points;
+	for (int i=0;i<npoints;i++)
+	{
+		points.push_back(Point3D(box.minimum(0) + unit(random)*(box.maximum(0)-box.minimum(0)),
+			box.minimum(1) + unit(random)*(box.maximum(1)-box.minimum(1)),
+			box.minimum(2) + unit(random)*(box.maximum(2)-box.minimum(2))));
+	}
+	std::vector<TProjection> projections;
+	projector.project(points, projections);
+
+	// A grid point is on the surface, so the closest point can not be farther.
+	int failures = 0;
+	Real worst = 0.0;
+	for (int i=0;i<npoints;i++)
+	{
+		Real nearest = -1.0;
+		for (int k=0;k<(int)samples.size();k++)
+		{
+			Real d = (samples[k] - points[i]).norm2();
+			if (nearest < 0.0 || d < nearest) nearest = d;
+		}
+		Real excess = projections[i].face ? projections[i].distance - nearest : diagonal;
+		worst = max(worst, excess);
+		if (excess > 1e-6 * diagonal) failures++;
+	}
+	cout << "  check projection: " << failures << "/" << npoints << " points farther than the grid, worst by " << worst 
+		<< (failures == 0 ? ", passed" : ", failed") << endl;
+	return failures == 0;
+}
+
+/** Check that the hits of random rays through the box of the T-spline are on its surface, by projecting them. */
+static bool checkRayCasting(const TSplinePtr &spline, int nrays, unsigned int seed)
+{
+	TRayCaster caster(spline);
+	TProjector projector(spline);
+	BoundingBox box = caster.getHierarchy().getBox();
+	Real diagonal = (box.maximum() - box.minimum()).norm2();
+	Point3D center = box.center();
+
+	std::mt19937 random(seed);
+	std::uniform_real_distribution<Real> unit(0.0, 1.0);
+	std::vector<TRay> rays;
+	for (int i=0;i<nrays;i++)
+	{
+		Point3D target(box.minimum(0) + unit(random)*(box.maximum(0)-box.minimum(0)),
+			box.minimum(1) + unit(random)*(box.maximum(1)-box.minimum(1)),
+			box.minimum(2) + unit(random)*(box.maximum(2)-box.minimum(2)));
+		Real z = 2.0 * unit(random) - 1.0, phi = 2.0 * M_PI * unit(random);
+		Point3D origin = center + Point3D(sqrt(1.0 - z*z) * cos(phi), sqrt(1.0 - z*z) * sin(phi), z) * diagonal;
+		rays.push_back(TRay(origin, Vector3D(target - origin)));
+	}
+	std::vector<TRayHit> hits;
+	caster.intersect(rays, hits);
+
+	std::vector<Point3D> points;
+	for (int i=0;i<nrays;i++)
+	{
+		if (hits[i].distance >= 0.0) points.push_back(hits[i].point);
+	}
+	std::vector<TProjection> projections;
+	projector.project(points, projections);
+	int failures = 0;
+	Real worst = 0.0;
+	for (int i=0;i<(int)points.size();i++)
+	{
+		Real distance = projections[i].face ? projections[i].distance : diagonal;
+		worst = max(worst, distance);
+		if (distance > 1e-6 * diagonal) failures++;
+	}
+	cout << "  check ray casting: " << failures << "/" << points.size() << " hits off the surface, worst by " << worst 
+		<< (failures == 0 ? ", passed" : ", failed") << endl;
+	return failures == 0;
+}
+
+/** 
+  * Check that the basis at the Gauss points is a partition of unity whose sum with the T-points is the surface,
+  * on a copy of the T-spline read with the degree.
+*/
+static bool checkPartition(const std::string &filename, int degree)
+{
+	RhBuilderPtr reader = makePtr<RhBuilder>(filename);
+	TSplinePtr spline = reader->findTSpline();
+	spline->setSDegree(degree);
+	spline->setTDegree(degree);
+	TQuadratureBasis basis(spline);
+
+	// The sum of N is 1 and the sums of its derivatives are 0, relative to the size of the cell, and the
+	// point of the basis is the one of the blending equation, relative to the size of the control points.
+	int npoints = 0, failures = 0;
+	Real worst = 0.0;
+	for (int f=0;f<basis.sizeFaces();f++)
+	{
+		std::vector<TQuadratureCell> cells;
+		basis.evaluateFace(f, cells);
+		BlendingEquationPtr equation = TDerivator::prepareEquationByTFace(basis.getFace(f), degree, degree);
+		for (int c=0;c<(int)cells.size();c++)
+		{
+			const TQuadratureCell &cell = cells[c];
+			const TPntVector &tpoints = basis.getTPoints(f, c);
+			int n = (int)cell.indices.size();
+			BoundingBox box;
+			for (int k=0;k<n;k++) box.extend(Point3D(tpoints[k]->getX(), tpoints[k]->getY(), tpoints[k]->getZ()));
+			Real size = max((box.maximum() - box.minimum()).norm2(), 1.0);
+			for (int p=0;p<(int)cell.parameters.size();p++)
+			{
+				const Real *values = &cell.values[3*n*p];
+				Real sums[3] = {0.0, 0.0, 0.0};
+				Point3D point(0.0, 0.0, 0.0);
+				for (int k=0;k<n;k++)
+				{
+					for (int d=0;d<3;d++) sums[d] += values[3*k+d];
+					point = point + Point3D(tpoints[k]->getX(), tpoints[k]->getY(), tpoints[k]->getZ()) * values[3*k];
+				}
+				Real area = sqrt(cell.weights[p] * cell.parameters.size());
+				Real error = max(fabs(sums[0] - 1.0), max(fabs(sums[1]), fabs(sums[2])) * area);
+				error = max(error, (point - equation->computePoint(cell.parameters[p])).norm2() / size);
+				worst = max(worst, error);
+				if (n == 0 || error > 1e-9) failures++;
+				npoints++;
+			}
+		}
+	}
+	cout << "  check partition of unity, degree " << degree << ": " << failures << "/" << npoints << " points off, worst by " 
+		<< worst << (failures == 0 && npoints > 0 ? ", passed" : ", failed") << endl;
+	return failures == 0 && npoints > 0;
+}
+
+/** 
+  * Check that fitting a perturbed copy of the T-spline to samples of its surface takes the copy back onto the
+  * surface at the parameters of the samples, and does not move it away by projection.
+*/
+static bool checkFitting(const std::string &filename, const TSplinePtr &spline, int nsamples, unsigned int seed)
+{
+	std::mt19937 random(seed);
+	std::vector<Point3D> points;
+	std::vector<int> indices;
+	std::vector<Parameter> parameters;
+	Real diagonal = sampleSurface(spline, nsamples, random, points, indices, parameters);
+
+	RhBuilderPtr reader = makePtr<RhBuilder>(filename);
+	TSplinePtr copy = reader->findTSpline();
+	TFacVector copy_faces(copy->getTImage()->faceIteratorBegin(), copy->getTImage()->faceIteratorEnd());
+	TFacVector sample_faces(nsamples);
+	for (int i=0;i<nsamples;i++) sample_faces[i] = copy_faces[indices[i]];
+	TSplineEditor editor(copy);
+	perturbPoints(copy, editor, 0.01 * diagonal, random);
+
+	TFitter fitter(copy);
+	int count = fitter.fit(points, sample_faces, parameters, editor);
+	Real before = fitter.getResidualBefore(), after = fitter.getResidual();
+	bool passed = count == nsamples && before > 0.0 && after < 1e-3 * before;
+	count = fitter.fit(points, editor);
+	Real projected_before = fitter.getResidualBefore(), projected_after = fitter.getResidual();
+	passed = passed && count == nsamples && projected_after <= projected_before;
+	cout << "  check fitting: rms " << before << " -> " << after << " at the parameters, " << projected_before << " -> " 
+		<< projected_after << " by projection" << (passed ? ", passed" : ", failed") << endl;
+	return passed;
+}
+
+/** Check if the boxes are the same, both empty or with equal limits. */
+static bool sameBox(const BoundingBox &a, const BoundingBox &b)
+{
+	if (a.isEmpty() || b.isEmpty()) return a.isEmpty() == b.isEmpty();
+	for (int axis=0;axis<3;axis++)
+	{
+		if (a.minimum(axis) != b.minimum(axis) || a.maximum(axis) != b.maximum(axis)) return false;
+	}
+	return true;
+}
+
+/** Move some T-points, refit the T-face hierarchy by the dirty T-faces, and compare it with one built afresh. */
+static bool checkRefit(const std::string &filename, unsigned int seed)
+{
+	RhBuilderPtr reader = makePtr<RhBuilder>(filename);
+	TSplinePtr spline = reader->findTSpline();
+	TFaceHierarchy hierarchy(spline);
+	Real diagonal = (hierarchy.getBox().maximum() - hierarchy.getBox().minimum()).norm2();
+
+	// One T-point in ten is moved by up to 5% of the diagonal along each axis.
+	std::mt19937 random(seed);
+	std::uniform_real_distribution<Real> unit(0.0, 1.0);
+	TSplineEditor editor(spline);
+	TPointsetPtr pointset = spline->getTPointset();
+	int nmoved = 0;
+	for (TObjVIterator iter = pointset->iteratorBegin(); iter != pointset->iteratorEnd(); iter++)
+	{
+		TPointPtr point = castPtr<TPoint>(*iter);
+		if (!point || random() % 10 != 0) continue;
+		editor.movePointTo(point, point->getX() + (unit(random) - 0.5) * 0.1 * diagonal, 
+			point->getY() + (unit(random) - 0.5) * 0.1 * diagonal, point->getZ() + (unit(random) - 0.5) * 0.1 * diagonal);
+		nmoved++;
+	}
+	TFacVector dirty_faces;
+	editor.takeDirtyFaces(dirty_faces);
+	hierarchy.refitFaces(dirty_faces);
+
+	TFaceHierarchy fresh(spline);
+	int failures = 0;
+	for (int i=0;i<hierarchy.sizeFaces();i++)
+	{
+		int j = fresh.findIndex(hierarchy.getFace(i));
+		if (j < 0 || !sameBox(hierarchy.getBox(i), fresh.getBox(j))) failures++;
+	}
+	bool passed = hierarchy.sizeFaces() == fresh.sizeFaces() && sameBox(hierarchy.getBox(), fresh.getBox()) && failures == 0;
+
+	// The trees differ, so the queries are compared as sets.
+	int nqueries = 200, mismatches = 0;
+	BoundingBox root = fresh.getBox();
+	for (int i=0;i<nqueries;i++)
+	{
+		Point3D center = fresh.getBox(random() % fresh.sizeFaces()).center();
+		TFacVector found, expected;
+		if (i % 2 == 0)
+		{
+			BoundingBox box(center, center);
+			box.enlarge(unit(random) * 0.1 * diagonal);
+			hierarchy.findFaces(box, found);
+			fresh.findFaces(box, expected);
+		}
+		else
+		{
+			Point3D origin = root.center() + Point3D(unit(random) - 0.5, unit(random) - 0.5, unit(random) - 0.5) * 4.0 * diagonal;
+			hierarchy.findFaces(origin, Vector3D(center - origin), found);
+			fresh.findFaces(origin, Vector3D(center - origin), expected);
+		}
+		std::sort(found.begin(), found.end());
+		std::sort(expected.begin(), expected.end());
+		if (found != expected) mismatches++;
+	}
+	passed = passed && mismatches == 0;
+	cout << "  check refit: " << nmoved << " points moved, " << dirty_faces.size() << " faces refitted, " << failures << "/" 
+		<< hierarchy.sizeFaces() << " boxes and " << mismatches << "/" << nqueries << " queries differ" 
+		<< (passed ? ", passed" : ", failed") << endl;
+	return passed;
+}
+
+/** Load the file again under a German locale, whose decimal point is ',', and compare the points and the surface. */
+static bool checkLocale(const std::string &filename, const TSplinePtr &spline, unsigned int seed)
+{
+	std::string previous = setlocale(LC_ALL, 0);
+	if (!setlocale(LC_ALL, "de_DE.UTF-8") && !setlocale(LC_ALL, "de_DE"))
+	{
+		cout << "  check locale: de_DE is not installed, skipped" << endl;
+		return true;
+	}
+	RhBuilderPtr reader = makePtr<RhBuilder>(filename);
+	TSplinePtr copy = reader->findTSpline();
+	setlocale(LC_ALL, previous.c_str());
+
+	int npoints = 0, failures = 0;
+	TPointsetPtr pointset = spline->getTPointset(), copy_pointset = copy->getTPointset();
+	TObjVIterator iter = pointset->iteratorBegin(), copy_iter = copy_pointset->iteratorBegin();
+	for (;iter != pointset->iteratorEnd() && copy_iter != copy_pointset->iteratorEnd();iter++, copy_iter++)
+	{
+		TPointPtr point = castPtr<TPoint>(*iter), copy_point = castPtr<TPoint>(*copy_iter);
+		if (!point || !copy_point) continue;
+		npoints++;
+		if (point->getX() != copy_point->getX() || point->getY() != copy_point->getY() || 
+			point->getZ() != copy_point->getZ() || point->getW() != copy_point->getW())
+			failures++;
+	}
+	bool passed = iter == pointset->iteratorEnd() && copy_iter == copy_pointset->iteratorEnd() && failures == 0;
+
+	// The knot intervals are read as reals too, so the surfaces must match.
+	std::mt19937 random(seed), copy_random(seed);
+	std::vector<Point3D> points, copy_points;
+	std::vector<int> indices, copy_indices;
+	std::vector<Parameter> parameters, copy_parameters;
+	sampleSurface(spline, 100, random, points, indices, parameters);
+	sampleSurface(copy, 100, copy_random, copy_points, copy_indices, copy_parameters);
+	int mismatches = 0;
+	for (int i=0;i<(int)points.size();i++)
+	{
+		if (points[i].x() != copy_points[i].x() || points[i].y() != copy_points[i].y() || points[i].z() != copy_points[i].z() ||
+			parameters[i].s() != copy_parameters[i].s() || parameters[i].t() != copy_parameters[i].t())
+			mismatches++;
+	}
+	passed = passed && mismatches == 0;
+	cout << "  check locale: " << failures << "/" << npoints << " points and " << mismatches << "/" << points.size() 
+		<< " surface samples differ under de_DE" << (passed ? ", passed" : ", failed") << endl;
+	return passed;
+}
+
+int main(int argc, char **argv)
+{
+	cout << "=====================================================\n";
+	cout << " TSPLINE -- A T-spline object oriented package in C++ \n";
+	cout << " Usage: tsmbench.exe [-project points] [-rays rays] [-slice layers]\n";
+	cout << "                     [-intersect degrees] [-assemble order] [-mass order]\n";
+	cout << "                     [-fit samples] [-seed seed] [-check] [*.tsm ...]\n";
+	cout << "=====================================================\n";
+	cout << "\n";
+
+	int nprojections = 0, nrays = 0, nlayers = 0, order = 0, mass_order = 0, nsamples = 0;
+	Real degrees = 0.0;
+	unsigned int seed = 1;
+	bool check = false;
+	std::vector<std::string> files;
+	for (int i=1;i<argc;i++)
+	{
+		std::string option(argv[i]);
+		if (option == "-project" && i+1 < argc) nprojections = atoi(argv[++i]);
+		else if (option == "-rays" && i+1 < argc) nrays = atoi(argv[++i]);
+		else if (option == "-slice" && i+1 < argc) nlayers = atoi(argv[++i]);
+		else if (option == "-intersect" && i+1 < argc) degrees = atof(argv[++i]);
+		else if (option == "-assemble" && i+1 < argc) order = atoi(argv[++i]);
+		else if (option == "-mass" && i+1 < argc) mass_order = atoi(argv[++i]);
+		else if (option == "-fit" && i+1 < argc) nsamples = atoi(argv[++i]);
+		else if (option == "-seed" && i+1 < argc) seed = atoi(argv[++i]);
+		else if (option == "-check") check = true;
+		else if (!option.empty() && option[0] == '-')
+		{
+			cout << "Do not support the option " << option << "." << endl;
+			return 0;
+		}
+		else files.push_back(option);
+	}
+	if (files.empty())
+	{
+		cout << "Please read the usage." << endl;
+		return 0;
+	}
+	// Without a query on the command line all of them run, unless only the checks are asked for.
+	if (!check && nprojections <= 0 && nrays <= 0 && nlayers <= 0 && degrees == 0.0 && order <= 0 && mass_order <= 0 && nsamples <= 0)
+	{
+		nprojections = nrays = 100000;
+		nlayers = 500;
+		degrees = 10.0;
+		order = mass_order = 4;
+		nsamples = 100000;
+	}
+
+	int failures = 0;
+	for (int i=0;i<(int)files.size();i++)
+	{
+		RhBuilderPtr reader = makePtr<RhBuilder>(files[i]);
+		TSplinePtr spline = reader->findTSpline();
+		cout << files[i] << ":" << endl;
+		if (int conflicts = reader->getTJunctionConflicts())
+			cout << "  T-junctions: " << conflicts << " pairs of extensions split the same face along different lines." << endl;
+		if (nprojections > 0) benchProjection(spline, nprojections, seed);
+		if (nrays > 0) benchRayCasting(spline, nrays, seed);
+		if (nlayers > 0) benchSlicing(spline, nlayers);
+		if (degrees != 0.0) benchIntersection(files[i], spline, degrees);
+		if (order > 0) benchAssembly(spline, order);
+		if (mass_order > 0) benchMass(spline, mass_order);
+		if (nsamples > 0) benchFitting(files[i], spline, nsamples, seed);
+		if (check)
+		{
+			if (!checkProjection(spline, 200, seed)) failures++;
+			if (!checkRayCasting(spline, 2000, seed)) failures++;
+			if (!checkPartition(files[i], 2)) failures++;
+			if (!checkPartition(files[i], 3)) failures++;
+			if (!checkFitting(files[i], spline, 1000, seed)) failures++;
+			if (!checkRefit(files[i], seed)) failures++;
+			if (!checkLocale(files[i], spline, seed)) failures++;
+		}
+	}
+	// The checks fail the run, so that a script can catch a regression.
+	return failures > 0 ? 1 : 0;
+}
@@ -43,12 +43,11 @@ namespace TSPLINE {
 	using namespace NEWMAT;
 #endif
 
-int TObject::_obj_count = 0;
+std::atomic<int> TObject::_obj_count(0);
 
 TObject::TObject(const std::string & name /* = "" */) : 
-	_name(name), _physical_id(_obj_count), _logical_id(0)
+	_symbol(TSymbolTable::Instance()->intern(name)), _physical_id(_obj_count++), _logical_id(0)
 {
-	_obj_count++;
 }
 
 TObject::~TObject()
@@ -52,6 +52,8 @@ Revision_history:
 #define TSPLINE_H
 
 #include <basis.h>
+#include <symbol.h>
+#include <atomic>
 
 #ifdef use_namespace
 namespace TSPLINE {
@@ -130,9 +132,13 @@ public:
 	virtual bool isVirtual() { return false; }
 
 	/** Set the name of this object */
-	void setName (const std::string & name) { _name = name; }
+	void setName (const std::string & name) { _symbol = TSymbolTable::Instance()->intern(name); }
 	/** Get the name of this object */
-	const std::string getName() const { return _name; }
+	const std::string getName() const { return TSymbolTable::Instance()->name(_symbol); }
+	/** Set the interned name symbol of this object */
+	void setSymbol(int symbol) { _symbol = symbol; }
+	/** Get the interned name symbol of this object */
+	int getSymbol() const { return _symbol; }
 	/** Set the logical ID number of this object */
 	void setId(int id) { _logical_id = id; }
 	/** Get the logical ID number of this object */
@@ -147,10 +153,10 @@ public:
 	const unsigned int getPhysicalId() const { return _physical_id; }
 
 private:
-	std::string _name;
+	int _symbol;
 	unsigned int _physical_id;
 	unsigned int _logical_id;
-	static int _obj_count;
+	static std::atomic<int> _obj_count;
 	TGroupPtr _collector;
 };
 
@@ -211,19 +217,20 @@ private:
 	};
 	struct NameFinder
 	{
-		NameFinder(const string &name) : _name(name) {}
+		NameFinder(const string &name) : _symbol(TSymbolTable::Instance()->find(name)), _interned(name.empty() || _symbol != E_NOSYMBOL) {}
 		bool operator() (TObjectPtr object)
 		{
-			if (object)
+			if (object && _interned)
 			{
-				return object->_name == _name;
+				return object->_symbol == _symbol;
 			}
 			else
 			{
 				return false;
 			}
 		}
-		std::string _name;
+		int _symbol;
+		bool _interned;
 	};
 	struct TypeFinder
 	{
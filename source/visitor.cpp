@@ -138,21 +138,47 @@ void TVertexVisitorCheckTJunctions::operator()( const TVertexPtr &vertex )
 
 void TVertexVisitorCheckTNodes::operator()( const TVertexPtr &vertex )
 {
-	TPseudoNodeMatrix pnode_matrix(vertex->nodeIteratorBegin(), vertex->nodeIteratorEnd());
-	TNodV4Vector norths = pnode_matrix.nodesNorth();
-	TNodV4Vector wests = pnode_matrix.nodesWest();
-	TNodV4Vector souths = pnode_matrix.nodesSouth();
-	TNodV4Vector easts = pnode_matrix.nodesEast();
+	TNodeHalfLinkage linkage;
+	derive(vertex, linkage);
+	commit(linkage);
+}
 
+void TVertexVisitorCheckTNodes::derive( const TVertexPtr &vertex, TNodeHalfLinkage &linkage )
+{
+	TPseudoNodeMatrix pnode_matrix(vertex->nodeIteratorBegin(), vertex->nodeIteratorEnd());
 	TNodeV4Ptr north_tip = pnode_matrix.nodeTipNorth();
 	TNodeV4Ptr west_tip = pnode_matrix.nodeTipWest();
 	TNodeV4Ptr south_tip = pnode_matrix.nodeTipSouth();
 	TNodeV4Ptr east_tip = pnode_matrix.nodeTipEast();
 
-	if (north_tip) setCommonNorth(norths, north_tip->getNorth());
-	if (west_tip) setCommonWest(wests, west_tip->getWest());
-	if (south_tip) setCommonSouth(souths, south_tip->getSouth());
-	if (east_tip) setCommonEast(easts, east_tip->getEast());
+	if (north_tip)
+	{
+		linkage.norths = pnode_matrix.nodesNorth();
+		linkage.north = north_tip->getNorth();
+	}
+	if (west_tip)
+	{
+		linkage.wests = pnode_matrix.nodesWest();
+		linkage.west = west_tip->getWest();
+	}
+	if (south_tip)
+	{
+		linkage.souths = pnode_matrix.nodesSouth();
+		linkage.south = south_tip->getSouth();
+	}
+	if (east_tip)
+	{
+		linkage.easts = pnode_matrix.nodesEast();
+		linkage.east = east_tip->getEast();
+	}
+}
+
+void TVertexVisitorCheckTNodes::commit( TNodeHalfLinkage &linkage )
+{
+	setCommonNorth(linkage.norths, linkage.north);
+	setCommonWest(linkage.wests, linkage.west);
+	setCommonSouth(linkage.souths, linkage.south);
+	setCommonEast(linkage.easts, linkage.east);
 }
 
 void TVertexVisitorCheckTNodes::setCommonNorth( TNodV4Vector &nodes, TNodeV4Ptr north )
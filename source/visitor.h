@@ -148,6 +148,26 @@ private:
 
 };
 
+/**  
+  *  @struct  <TNodeHalfLinkage> 
+  *  @brief  The half linkages of a T-vertex's nodes.   
+  *  @note  
+  *  The nodes on each side of a T-vertex and the common neighbor they share, derived from the tip nodes.
+*/ 
+struct TNodeHalfLinkage
+{
+	TNodV4Vector norths;
+	TNodV4Vector wests;
+	TNodV4Vector souths;
+	TNodV4Vector easts;
+	TNodeV4Ptr north;
+	TNodeV4Ptr west;
+	TNodeV4Ptr south;
+	TNodeV4Ptr east;
+};
+
+typedef std::vector<TNodeHalfLinkage> TNodHlkVector;
+
 /**  
   *  @struct  <TVertexVisitorCheckTNodes> 
   *  @brief  A T-vertex visitor.   
@@ -158,6 +178,10 @@ struct TVertexVisitorCheckTNodes
 {
 	TVertexVisitorCheckTNodes() {}
 	void operator() (const TVertexPtr &vertex);
+	/** Derive the common neighbors of the T-vertex's nodes without modifying any T-node. */
+	void derive(const TVertexPtr &vertex, TNodeHalfLinkage &linkage);
+	/** Commit the derived common neighbors to the T-nodes. */
+	void commit(TNodeHalfLinkage &linkage);
 private:
 	void setCommonNorth(TNodV4Vector &nodes, TNodeV4Ptr north);
 	void setCommonWest(TNodV4Vector &nodes, TNodeV4Ptr west);